@@ -423,6 +423,10 @@ void update_all_nations_issue_rules(sys::state& state) {
 }
 
 void create_initial_ideology_and_issues_distribution(sys::state& state) {
+	// the unnormalized amounts are kept on the side, since they may not be representable in quantized pop storage
+	static std::vector<float> amounts;
+	amounts.resize(state.world.ideology_size());
+
 	state.world.for_each_pop([&state](dcon::pop_id pid) {
 		auto ptype = state.world.pop_get_poptype(pid);
 		auto owner = nations::owner_of_pop(state, pid);
@@ -432,11 +436,12 @@ void create_initial_ideology_and_issues_distribution(sys::state& state) {
 
 		float total = 0.0f;
 		state.world.for_each_ideology([&](dcon::ideology_id iid) {
+			amounts[iid.index()] = 0.0f;
 			if(state.world.ideology_get_enabled(iid) && (!state.world.ideology_get_is_civilized_only(iid) || state.world.nation_get_is_civilized(owner))) {
 				auto ptrigger = state.world.pop_type_get_ideology(ptype, iid);
 				if(ptrigger) {
 					auto amount = trigger::evaluate_multiplicative_modifier(state, ptrigger, trigger::to_generic(pid), trigger::to_generic(owner), 0);
-					state.world.pop_set_demographics(pid, pop_demographics::to_key(state, iid), amount);
+					amounts[iid.index()] = amount;
 					total += amount;
 				}
 			}
@@ -446,8 +451,7 @@ void create_initial_ideology_and_issues_distribution(sys::state& state) {
 
 		float adjustment_factor = psize / total;
 		state.world.for_each_ideology([&state, pid, adjustment_factor](dcon::ideology_id iid) {
-			auto normalized_amount = state.world.pop_get_demographics(pid, pop_demographics::to_key(state, iid)) * adjustment_factor;
-			state.world.pop_set_demographics(pid, pop_demographics::to_key(state, iid), normalized_amount);
+			pop_demographics::set_demo(state, pid, pop_demographics::to_key(state, iid), amounts[iid.index()] * adjustment_factor);
 		});
 
 		// TODO: issues
@@ -13,6 +13,56 @@ dcon::pop_demographics_key to_key(sys::state const& state, dcon::issue_option_id
 uint32_t size(sys::state const& state) {
 	return state.world.ideology_size() + state.world.issue_option_size();
 }
+void resize_storage(sys::state& state) {
+	if constexpr(quantized_storage) {
+		state.world.pop_resize_quantized_demographics(size(state));
+		state.world.pop_resize_demographics(0);
+	} else {
+		state.world.pop_resize_demographics(size(state));
+		state.world.pop_resize_quantized_demographics(0);
+	}
+}
+
+float get_demo(sys::state const& state, dcon::pop_id p, dcon::pop_demographics_key key) {
+	if constexpr(quantized_storage) {
+		return unpack_share(state.world.pop_get_quantized_demographics(p, key)) * state.world.pop_get_size(p);
+	} else {
+		return state.world.pop_get_demographics(p, key);
+	}
+}
+template<typename T>
+ve::fp_vector get_demo(sys::state const& state, T pop_ids, dcon::pop_demographics_key key) {
+	if constexpr(quantized_storage) {
+		return unpack_share(state.world.pop_get_quantized_demographics(pop_ids, key)) * state.world.pop_get_size(pop_ids);
+	} else {
+		return state.world.pop_get_demographics(pop_ids, key);
+	}
+}
+float get_demo_share(sys::state const& state, dcon::pop_id p, dcon::pop_demographics_key key) {
+	if constexpr(quantized_storage) {
+		return unpack_share(state.world.pop_get_quantized_demographics(p, key));
+	} else {
+		auto size = state.world.pop_get_size(p);
+		return size > 0.0f ? state.world.pop_get_demographics(p, key) / size : 0.0f;
+	}
+}
+template<typename T>
+ve::fp_vector get_demo_share(sys::state const& state, T pop_ids, dcon::pop_demographics_key key) {
+	if constexpr(quantized_storage) {
+		return unpack_share(state.world.pop_get_quantized_demographics(pop_ids, key));
+	} else {
+		auto size = state.world.pop_get_size(pop_ids);
+		return ve::select(size > 0.0f, state.world.pop_get_demographics(pop_ids, key) / size, 0.0f);
+	}
+}
+void set_demo(sys::state& state, dcon::pop_id p, dcon::pop_demographics_key key, float amount) {
+	if constexpr(quantized_storage) {
+		auto size = state.world.pop_get_size(p);
+		state.world.pop_set_quantized_demographics(p, key, size > 0.0f ? pack_share(amount / size) : uint16_t(0));
+	} else {
+		state.world.pop_set_demographics(p, key, amount);
+	}
+}
 
 }
 namespace demographics {
@@ -43,17 +93,35 @@ uint32_t size(sys::state const& state) {
 		uint32_t(2) * state.world.pop_type_size() + state.world.culture_size() + state.world.religion_size();
 }
 
+void sum_provinces_upwards(sys::state& state, dcon::demographics_key key);
+
 template<typename F>
 void sum_over_demographics(sys::state& state, dcon::demographics_key key, F const& source) {
-	//clear province
-	province::ve_for_each_land_province(state, [&](auto pi) {
-		state.world.province_set_demographics(pi, key, ve::fp_vector());
-	});
-	//sum in province
-	state.world.for_each_pop([&](dcon::pop_id p) {
-		auto location = state.world.pop_get_province_from_pop_location(p);
-		state.world.province_get_demographics(location, key) += source(state, p);
-	});
+	if(!state.pop_ranges_out_of_date) {
+		//sum in province, reading the pops of each province as a contiguous range
+		province::for_each_land_province(state, [&](dcon::province_id pi) {
+			float total = 0.0f;
+			province::for_each_pop_in_range(state, pi, [&](dcon::pop_id p) {
+				total += source(state, p);
+			});
+			state.world.province_set_demographics(pi, key, total);
+		});
+	} else {
+		//clear province
+		province::ve_for_each_land_province(state, [&](auto pi) {
+			state.world.province_set_demographics(pi, key, ve::fp_vector());
+		});
+		//sum in province
+		state.world.for_each_pop([&](dcon::pop_id p) {
+			auto location = state.world.pop_get_province_from_pop_location(p);
+			state.world.province_get_demographics(location, key) += source(state, p);
+		});
+	}
+	sum_provinces_upwards(state, key);
+}
+
+// the sums of the states and nations, from the sums already in their provinces
+void sum_provinces_upwards(sys::state& state, dcon::demographics_key key) {
 	//clear state
 	state.world.execute_serial_over_state_instance([&](auto si) {
 		state.world.state_instance_set_demographics(si, key, ve::fp_vector());
@@ -74,6 +142,29 @@ void sum_over_demographics(sys::state& state, dcon::demographics_key key, F cons
 	});
 }
 
+// sums the support for an ideology / issue, reading the pop demographics column a whole vector of pops at a time over the
+// contiguous pop range of each province; the quantized column is unpacked in the vector registers
+void sum_over_pop_demographics(sys::state& state, dcon::demographics_key key, dcon::pop_demographics_key pkey) {
+	if(state.pop_ranges_out_of_date) {
+		sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
+			return pop_demographics::get_demo(state, p, pkey);
+		});
+		return;
+	}
+	province::for_each_land_province(state, [&](dcon::province_id pi) {
+		auto first = int32_t(state.world.province_get_pop_range_begin(pi));
+		auto last = int32_t(state.world.province_get_pop_range_end(pi));
+		ve::fp_vector total;
+		auto i = first;
+		for(; i + int32_t(ve::vector_size) <= last; i += int32_t(ve::vector_size))
+			total = total + pop_demographics::get_demo(state, ve::unaligned_contiguous_tags<dcon::pop_id>(i), pkey);
+		if(i < last)
+			total = total + pop_demographics::get_demo(state, ve::partial_contiguous_tags<dcon::pop_id>(i, last - i), pkey);
+		state.world.province_set_demographics(pi, key, total.reduce());
+	});
+	sum_provinces_upwards(state, key);
+}
+
 void regenerate_from_pop_data(sys::state& state) {
 
 	// TODO: regenerate pop political and social reform desire
@@ -214,16 +305,10 @@ void regenerate_from_pop_data(sys::state& state) {
 			}
 		} else if(key.index() < to_key(state, dcon::issue_option_id(0)).index()) { // ideology
 			dcon::ideology_id pkey{ dcon::ideology_id::value_base_t( index - count_special_keys ) };
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_demographics(p, pdemo_key);
-			});
+			sum_over_pop_demographics(state, key, pop_demographics::to_key(state, pkey));
 		} else if(key.index() < to_key(state, dcon::pop_type_id(0)).index()) { // issue option
 			dcon::issue_option_id pkey{ dcon::issue_option_id::value_base_t(index - (count_special_keys + state.world.ideology_size()) ) };
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_demographics(p, pdemo_key);
-			});
+			sum_over_pop_demographics(state, key, pop_demographics::to_key(state, pkey));
 		} else if(key.index() < to_key(state, dcon::culture_id(0)).index()) { // pop type
 			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys + state.world.ideology_size() + state.world.issue_option_size())) };
 			sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
@@ -255,271 +340,480 @@ void regenerate_from_pop_data(sys::state& state) {
 
 	//
 	// calculate values derived from demographics
+	// for each region, this keeps the two largest culture / religion / ideology / issue groups and their share of the population
 	//
 	concurrency::parallel_for(uint32_t(0), uint32_t(16), [&](uint32_t index) {
 		switch(index) {
 			case 0:
 			{
-				static ve::vectorizable_buffer<float, dcon::province_id> max_buffer = state.world.province_make_vectorizable_float_buffer();
+				static ve::vectorizable_buffer<float, dcon::province_id> max_buffer(uint32_t(1));
+				static ve::vectorizable_buffer<float, dcon::province_id> second_buffer(uint32_t(1));
+				static uint32_t old_count = 1;
+
+				auto new_count = state.world.province_size();
+				if(new_count > old_count) {
+					max_buffer = state.world.province_make_vectorizable_float_buffer();
+					second_buffer = state.world.province_make_vectorizable_float_buffer();
+					old_count = new_count;
+				}
 
 				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&](auto p) {
 					max_buffer.set(p, ve::fp_vector());
+					second_buffer.set(p, ve::fp_vector());
+					state.world.province_set_dominant_culture(p, ve::tagged_vector<dcon::culture_id>());
+					state.world.province_set_second_culture(p, ve::tagged_vector<dcon::culture_id>());
 				});
 				state.world.for_each_culture([&](dcon::culture_id c) {
 					ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&](auto p) {
 						auto v = state.world.province_get_demographics(p, to_key(state, c));
 						auto old_max = max_buffer.get(p);
+						auto old_second = second_buffer.get(p);
+						auto old_max_id = state.world.province_get_dominant_culture(p);
 						auto mask = v > old_max;
-						state.world.province_set_dominant_culture(p, ve::select(mask, ve::tagged_vector<dcon::culture_id>(c), state.world.province_get_dominant_culture(p)));
+						auto second_mask = v > old_second;
+						state.world.province_set_second_culture(p, ve::select(mask, old_max_id, ve::select(second_mask, ve::tagged_vector<dcon::culture_id>(c), state.world.province_get_second_culture(p))));
+						second_buffer.set(p, ve::select(mask, old_max, ve::select(second_mask, v, old_second)));
+						state.world.province_set_dominant_culture(p, ve::select(mask, ve::tagged_vector<dcon::culture_id>(c), old_max_id));
 						max_buffer.set(p, ve::select(mask, v, old_max));
 					});
 				});
+				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&](auto p) {
+					auto total_pop = state.world.province_get_demographics(p, total);
+					state.world.province_set_dominant_culture_share(p, ve::select(total_pop > 0.0f, max_buffer.get(p) / total_pop, 0.0f));
+					state.world.province_set_second_culture_share(p, ve::select(total_pop > 0.0f, second_buffer.get(p) / total_pop, 0.0f));
+				});
 				break;
 			}
 			case 1:
 			{
 				static ve::vectorizable_buffer<float, dcon::state_instance_id> max_buffer(uint32_t(1));
+				static ve::vectorizable_buffer<float, dcon::state_instance_id> second_buffer(uint32_t(1));
 				static uint32_t old_count = 1;
 
 				auto new_count = state.world.state_instance_size();
 				if(new_count > old_count) {
 					max_buffer = state.world.state_instance_make_vectorizable_float_buffer();
+					second_buffer = state.world.state_instance_make_vectorizable_float_buffer();
 					old_count = new_count;
 				}
 				state.world.execute_serial_over_state_instance([&](auto p) {
 					max_buffer.set(p, ve::fp_vector());
+					second_buffer.set(p, ve::fp_vector());
+					state.world.state_instance_set_dominant_culture(p, ve::tagged_vector<dcon::culture_id>());
+					state.world.state_instance_set_second_culture(p, ve::tagged_vector<dcon::culture_id>());
 				});
 				state.world.for_each_culture([&](dcon::culture_id c) {
 					state.world.execute_serial_over_state_instance([&](auto p) {
 						auto v = state.world.state_instance_get_demographics(p, to_key(state, c));
 						auto old_max = max_buffer.get(p);
+						auto old_second = second_buffer.get(p);
+						auto old_max_id = state.world.state_instance_get_dominant_culture(p);
 						auto mask = v > old_max;
-						state.world.state_instance_set_dominant_culture(p, ve::select(mask, ve::tagged_vector<dcon::culture_id>(c), state.world.state_instance_get_dominant_culture(p)));
+						auto second_mask = v > old_second;
+						state.world.state_instance_set_second_culture(p, ve::select(mask, old_max_id, ve::select(second_mask, ve::tagged_vector<dcon::culture_id>(c), state.world.state_instance_get_second_culture(p))));
+						second_buffer.set(p, ve::select(mask, old_max, ve::select(second_mask, v, old_second)));
+						state.world.state_instance_set_dominant_culture(p, ve::select(mask, ve::tagged_vector<dcon::culture_id>(c), old_max_id));
 						max_buffer.set(p, ve::select(mask, v, old_max));
 					});
 				});
+				state.world.execute_serial_over_state_instance([&](auto p) {
+					auto total_pop = state.world.state_instance_get_demographics(p, total);
+					state.world.state_instance_set_dominant_culture_share(p, ve::select(total_pop > 0.0f, max_buffer.get(p) / total_pop, 0.0f));
+					state.world.state_instance_set_second_culture_share(p, ve::select(total_pop > 0.0f, second_buffer.get(p) / total_pop, 0.0f));
+				});
 				break;
 			}
 			case 2:
 			{
 				static ve::vectorizable_buffer<float, dcon::nation_id> max_buffer(uint32_t(1));
+				static ve::vectorizable_buffer<float, dcon::nation_id> second_buffer(uint32_t(1));
 				static uint32_t old_count = 1;
 
 				auto new_count = state.world.nation_size();
 				if(new_count > old_count) {
 					max_buffer = state.world.nation_make_vectorizable_float_buffer();
+					second_buffer = state.world.nation_make_vectorizable_float_buffer();
 					old_count = new_count;
 				}
 				state.world.execute_serial_over_nation([&](auto p) {
 					max_buffer.set(p, ve::fp_vector());
+					second_buffer.set(p, ve::fp_vector());
+					state.world.nation_set_dominant_culture(p, ve::tagged_vector<dcon::culture_id>());
+					state.world.nation_set_second_culture(p, ve::tagged_vector<dcon::culture_id>());
 				});
 				state.world.for_each_culture([&](dcon::culture_id c) {
 					state.world.execute_serial_over_nation([&](auto p) {
 						auto v = state.world.nation_get_demographics(p, to_key(state, c));
 						auto old_max = max_buffer.get(p);
+						auto old_second = second_buffer.get(p);
+						auto old_max_id = state.world.nation_get_dominant_culture(p);
 						auto mask = v > old_max;
-						state.world.nation_set_dominant_culture(p, ve::select(mask, ve::tagged_vector<dcon::culture_id>(c), state.world.nation_get_dominant_culture(p)));
+						auto second_mask = v > old_second;
+						state.world.nation_set_second_culture(p, ve::select(mask, old_max_id, ve::select(second_mask, ve::tagged_vector<dcon::culture_id>(c), state.world.nation_get_second_culture(p))));
+						second_buffer.set(p, ve::select(mask, old_max, ve::select(second_mask, v, old_second)));
+						state.world.nation_set_dominant_culture(p, ve::select(mask, ve::tagged_vector<dcon::culture_id>(c), old_max_id));
 						max_buffer.set(p, ve::select(mask, v, old_max));
 					});
 				});
+				state.world.execute_serial_over_nation([&](auto p) {
+					auto total_pop = state.world.nation_get_demographics(p, total);
+					state.world.nation_set_dominant_culture_share(p, ve::select(total_pop > 0.0f, max_buffer.get(p) / total_pop, 0.0f));
+					state.world.nation_set_second_culture_share(p, ve::select(total_pop > 0.0f, second_buffer.get(p) / total_pop, 0.0f));
+				});
 				break;
 			}
 			case 3:
 			{
-				static ve::vectorizable_buffer<float, dcon::province_id> max_buffer = state.world.province_make_vectorizable_float_buffer();
+				static ve::vectorizable_buffer<float, dcon::province_id> max_buffer(uint32_t(1));
+				static ve::vectorizable_buffer<float, dcon::province_id> second_buffer(uint32_t(1));
+				static uint32_t old_count = 1;
+
+				auto new_count = state.world.province_size();
+				if(new_count > old_count) {
+					max_buffer = state.world.province_make_vectorizable_float_buffer();
+					second_buffer = state.world.province_make_vectorizable_float_buffer();
+					old_count = new_count;
+				}
 
 				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&](auto p) {
 					max_buffer.set(p, ve::fp_vector());
+					second_buffer.set(p, ve::fp_vector());
+					state.world.province_set_dominant_religion(p, ve::tagged_vector<dcon::religion_id>());
+					state.world.province_set_second_religion(p, ve::tagged_vector<dcon::religion_id>());
 				});
 				state.world.for_each_religion([&](dcon::religion_id c) {
 					ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&](auto p) {
 						auto v = state.world.province_get_demographics(p, to_key(state, c));
 						auto old_max = max_buffer.get(p);
+						auto old_second = second_buffer.get(p);
+						auto old_max_id = state.world.province_get_dominant_religion(p);
 						auto mask = v > old_max;
-						state.world.province_set_dominant_religion(p, ve::select(mask, ve::tagged_vector<dcon::religion_id>(c), state.world.province_get_dominant_religion(p)));
+						auto second_mask = v > old_second;
+						state.world.province_set_second_religion(p, ve::select(mask, old_max_id, ve::select(second_mask, ve::tagged_vector<dcon::religion_id>(c), state.world.province_get_second_religion(p))));
+						second_buffer.set(p, ve::select(mask, old_max, ve::select(second_mask, v, old_second)));
+						state.world.province_set_dominant_religion(p, ve::select(mask, ve::tagged_vector<dcon::religion_id>(c), old_max_id));
 						max_buffer.set(p, ve::select(mask, v, old_max));
 					});
 				});
+				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&](auto p) {
+					auto total_pop = state.world.province_get_demographics(p, total);
+					state.world.province_set_dominant_religion_share(p, ve::select(total_pop > 0.0f, max_buffer.get(p) / total_pop, 0.0f));
+					state.world.province_set_second_religion_share(p, ve::select(total_pop > 0.0f, second_buffer.get(p) / total_pop, 0.0f));
+				});
 				break;
 			}
 			case 4:
 			{
 				static ve::vectorizable_buffer<float, dcon::state_instance_id> max_buffer(uint32_t(1));
+				static ve::vectorizable_buffer<float, dcon::state_instance_id> second_buffer(uint32_t(1));
 				static uint32_t old_count = 1;
 
 				auto new_count = state.world.state_instance_size();
 				if(new_count > old_count) {
 					max_buffer = state.world.state_instance_make_vectorizable_float_buffer();
+					second_buffer = state.world.state_instance_make_vectorizable_float_buffer();
 					old_count = new_count;
 				}
 				state.world.execute_serial_over_state_instance([&](auto p) {
 					max_buffer.set(p, ve::fp_vector());
+					second_buffer.set(p, ve::fp_vector());
+					state.world.state_instance_set_dominant_religion(p, ve::tagged_vector<dcon::religion_id>());
+					state.world.state_instance_set_second_religion(p, ve::tagged_vector<dcon::religion_id>());
 				});
 				state.world.for_each_religion([&](dcon::religion_id c) {
 					state.world.execute_serial_over_state_instance([&](auto p) {
 						auto v = state.world.state_instance_get_demographics(p, to_key(state, c));
 						auto old_max = max_buffer.get(p);
+						auto old_second = second_buffer.get(p);
+						auto old_max_id = state.world.state_instance_get_dominant_religion(p);
 						auto mask = v > old_max;
-						state.world.state_instance_set_dominant_religion(p, ve::select(mask, ve::tagged_vector<dcon::religion_id>(c), state.world.state_instance_get_dominant_religion(p)));
+						auto second_mask = v > old_second;
+						state.world.state_instance_set_second_religion(p, ve::select(mask, old_max_id, ve::select(second_mask, ve::tagged_vector<dcon::religion_id>(c), state.world.state_instance_get_second_religion(p))));
+						second_buffer.set(p, ve::select(mask, old_max, ve::select(second_mask, v, old_second)));
+						state.world.state_instance_set_dominant_religion(p, ve::select(mask, ve::tagged_vector<dcon::religion_id>(c), old_max_id));
 						max_buffer.set(p, ve::select(mask, v, old_max));
 					});
 				});
+				state.world.execute_serial_over_state_instance([&](auto p) {
+					auto total_pop = state.world.state_instance_get_demographics(p, total);
+					state.world.state_instance_set_dominant_religion_share(p, ve::select(total_pop > 0.0f, max_buffer.get(p) / total_pop, 0.0f));
+					state.world.state_instance_set_second_religion_share(p, ve::select(total_pop > 0.0f, second_buffer.get(p) / total_pop, 0.0f));
+				});
 				break;
 			}
 			case 5:
 			{
 				static ve::vectorizable_buffer<float, dcon::nation_id> max_buffer(uint32_t(1));
+				static ve::vectorizable_buffer<float, dcon::nation_id> second_buffer(uint32_t(1));
 				static uint32_t old_count = 1;
 
 				auto new_count = state.world.nation_size();
 				if(new_count > old_count) {
 					max_buffer = state.world.nation_make_vectorizable_float_buffer();
+					second_buffer = state.world.nation_make_vectorizable_float_buffer();
 					old_count = new_count;
 				}
 				state.world.execute_serial_over_nation([&](auto p) {
 					max_buffer.set(p, ve::fp_vector());
+					second_buffer.set(p, ve::fp_vector());
+					state.world.nation_set_dominant_religion(p, ve::tagged_vector<dcon::religion_id>());
+					state.world.nation_set_second_religion(p, ve::tagged_vector<dcon::religion_id>());
 				});
 				state.world.for_each_religion([&](dcon::religion_id c) {
 					state.world.execute_serial_over_nation([&](auto p) {
 						auto v = state.world.nation_get_demographics(p, to_key(state, c));
 						auto old_max = max_buffer.get(p);
+						auto old_second = second_buffer.get(p);
+						auto old_max_id = state.world.nation_get_dominant_religion(p);
 						auto mask = v > old_max;
-						state.world.nation_set_dominant_religion(p, ve::select(mask, ve::tagged_vector<dcon::religion_id>(c), state.world.nation_get_dominant_religion(p)));
+						auto second_mask = v > old_second;
+						state.world.nation_set_second_religion(p, ve::select(mask, old_max_id, ve::select(second_mask, ve::tagged_vector<dcon::religion_id>(c), state.world.nation_get_second_religion(p))));
+						second_buffer.set(p, ve::select(mask, old_max, ve::select(second_mask, v, old_second)));
+						state.world.nation_set_dominant_religion(p, ve::select(mask, ve::tagged_vector<dcon::religion_id>(c), old_max_id));
 						max_buffer.set(p, ve::select(mask, v, old_max));
 					});
 				});
+				state.world.execute_serial_over_nation([&](auto p) {
+					auto total_pop = state.world.nation_get_demographics(p, total);
+					state.world.nation_set_dominant_religion_share(p, ve::select(total_pop > 0.0f, max_buffer.get(p) / total_pop, 0.0f));
+					state.world.nation_set_second_religion_share(p, ve::select(total_pop > 0.0f, second_buffer.get(p) / total_pop, 0.0f));
+				});
 				break;
 			}
 			case 6:
 			{
-				static ve::vectorizable_buffer<float, dcon::province_id> max_buffer = state.world.province_make_vectorizable_float_buffer();
+				static ve::vectorizable_buffer<float, dcon::province_id> max_buffer(uint32_t(1));
+				static ve::vectorizable_buffer<float, dcon::province_id> second_buffer(uint32_t(1));
+				static uint32_t old_count = 1;
+
+				auto new_count = state.world.province_size();
+				if(new_count > old_count) {
+					max_buffer = state.world.province_make_vectorizable_float_buffer();
+					second_buffer = state.world.province_make_vectorizable_float_buffer();
+					old_count = new_count;
+				}
 
 				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&](auto p) {
 					max_buffer.set(p, ve::fp_vector());
+					second_buffer.set(p, ve::fp_vector());
+					state.world.province_set_dominant_ideology(p, ve::tagged_vector<dcon::ideology_id>());
+					state.world.province_set_second_ideology(p, ve::tagged_vector<dcon::ideology_id>());
 				});
 				state.world.for_each_ideology([&](dcon::ideology_id c) {
 					ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&](auto p) {
 						auto v = state.world.province_get_demographics(p, to_key(state, c));
 						auto old_max = max_buffer.get(p);
+						auto old_second = second_buffer.get(p);
+						auto old_max_id = state.world.province_get_dominant_ideology(p);
 						auto mask = v > old_max;
-						state.world.province_set_dominant_ideology(p, ve::select(mask, ve::tagged_vector<dcon::ideology_id>(c), state.world.province_get_dominant_ideology(p)));
+						auto second_mask = v > old_second;
+						state.world.province_set_second_ideology(p, ve::select(mask, old_max_id, ve::select(second_mask, ve::tagged_vector<dcon::ideology_id>(c), state.world.province_get_second_ideology(p))));
+						second_buffer.set(p, ve::select(mask, old_max, ve::select(second_mask, v, old_second)));
+						state.world.province_set_dominant_ideology(p, ve::select(mask, ve::tagged_vector<dcon::ideology_id>(c), old_max_id));
 						max_buffer.set(p, ve::select(mask, v, old_max));
 					});
 				});
+				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&](auto p) {
+					auto total_pop = state.world.province_get_demographics(p, total);
+					state.world.province_set_dominant_ideology_share(p, ve::select(total_pop > 0.0f, max_buffer.get(p) / total_pop, 0.0f));
+					state.world.province_set_second_ideology_share(p, ve::select(total_pop > 0.0f, second_buffer.get(p) / total_pop, 0.0f));
+				});
 				break;
 			}
 			case 7:
 			{
 				static ve::vectorizable_buffer<float, dcon::state_instance_id> max_buffer(uint32_t(1));
+				static ve::vectorizable_buffer<float, dcon::state_instance_id> second_buffer(uint32_t(1));
 				static uint32_t old_count = 1;
 
 				auto new_count = state.world.state_instance_size();
 				if(new_count > old_count) {
 					max_buffer = state.world.state_instance_make_vectorizable_float_buffer();
+					second_buffer = state.world.state_instance_make_vectorizable_float_buffer();
 					old_count = new_count;
 				}
 				state.world.execute_serial_over_state_instance([&](auto p) {
 					max_buffer.set(p, ve::fp_vector());
+					second_buffer.set(p, ve::fp_vector());
+					state.world.state_instance_set_dominant_ideology(p, ve::tagged_vector<dcon::ideology_id>());
+					state.world.state_instance_set_second_ideology(p, ve::tagged_vector<dcon::ideology_id>());
 				});
 				state.world.for_each_ideology([&](dcon::ideology_id c) {
 					state.world.execute_serial_over_state_instance([&](auto p) {
 						auto v = state.world.state_instance_get_demographics(p, to_key(state, c));
 						auto old_max = max_buffer.get(p);
+						auto old_second = second_buffer.get(p);
+						auto old_max_id = state.world.state_instance_get_dominant_ideology(p);
 						auto mask = v > old_max;
-						state.world.state_instance_set_dominant_ideology(p, ve::select(mask, ve::tagged_vector<dcon::ideology_id>(c), state.world.state_instance_get_dominant_ideology(p)));
+						auto second_mask = v > old_second;
+						state.world.state_instance_set_second_ideology(p, ve::select(mask, old_max_id, ve::select(second_mask, ve::tagged_vector<dcon::ideology_id>(c), state.world.state_instance_get_second_ideology(p))));
+						second_buffer.set(p, ve::select(mask, old_max, ve::select(second_mask, v, old_second)));
+						state.world.state_instance_set_dominant_ideology(p, ve::select(mask, ve::tagged_vector<dcon::ideology_id>(c), old_max_id));
 						max_buffer.set(p, ve::select(mask, v, old_max));
 					});
 				});
+				state.world.execute_serial_over_state_instance([&](auto p) {
+					auto total_pop = state.world.state_instance_get_demographics(p, total);
+					state.world.state_instance_set_dominant_ideology_share(p, ve::select(total_pop > 0.0f, max_buffer.get(p) / total_pop, 0.0f));
+					state.world.state_instance_set_second_ideology_share(p, ve::select(total_pop > 0.0f, second_buffer.get(p) / total_pop, 0.0f));
+				});
 				break;
 			}
 			case 8:
 			{
 				static ve::vectorizable_buffer<float, dcon::nation_id> max_buffer(uint32_t(1));
+				static ve::vectorizable_buffer<float, dcon::nation_id> second_buffer(uint32_t(1));
 				static uint32_t old_count = 1;
 
 				auto new_count = state.world.nation_size();
 				if(new_count > old_count) {
 					max_buffer = state.world.nation_make_vectorizable_float_buffer();
+					second_buffer = state.world.nation_make_vectorizable_float_buffer();
 					old_count = new_count;
 				}
 				state.world.execute_serial_over_nation([&](auto p) {
 					max_buffer.set(p, ve::fp_vector());
+					second_buffer.set(p, ve::fp_vector());
+					state.world.nation_set_dominant_ideology(p, ve::tagged_vector<dcon::ideology_id>());
+					state.world.nation_set_second_ideology(p, ve::tagged_vector<dcon::ideology_id>());
 				});
 				state.world.for_each_ideology([&](dcon::ideology_id c) {
 					state.world.execute_serial_over_nation([&](auto p) {
 						auto v = state.world.nation_get_demographics(p, to_key(state, c));
 						auto old_max = max_buffer.get(p);
+						auto old_second = second_buffer.get(p);
+						auto old_max_id = state.world.nation_get_dominant_ideology(p);
 						auto mask = v > old_max;
-						state.world.nation_set_dominant_ideology(p, ve::select(mask, ve::tagged_vector<dcon::ideology_id>(c), state.world.nation_get_dominant_ideology(p)));
+						auto second_mask = v > old_second;
+						state.world.nation_set_second_ideology(p, ve::select(mask, old_max_id, ve::select(second_mask, ve::tagged_vector<dcon::ideology_id>(c), state.world.nation_get_second_ideology(p))));
+						second_buffer.set(p, ve::select(mask, old_max, ve::select(second_mask, v, old_second)));
+						state.world.nation_set_dominant_ideology(p, ve::select(mask, ve::tagged_vector<dcon::ideology_id>(c), old_max_id));
 						max_buffer.set(p, ve::select(mask, v, old_max));
 					});
 				});
+				state.world.execute_serial_over_nation([&](auto p) {
+					auto total_pop = state.world.nation_get_demographics(p, total);
+					state.world.nation_set_dominant_ideology_share(p, ve::select(total_pop > 0.0f, max_buffer.get(p) / total_pop, 0.0f));
+					state.world.nation_set_second_ideology_share(p, ve::select(total_pop > 0.0f, second_buffer.get(p) / total_pop, 0.0f));
+				});
 				break;
 			}
 			case 9:
 			{
-				static ve::vectorizable_buffer<float, dcon::province_id> max_buffer = state.world.province_make_vectorizable_float_buffer();
+				static ve::vectorizable_buffer<float, dcon::province_id> max_buffer(uint32_t(1));
+				static ve::vectorizable_buffer<float, dcon::province_id> second_buffer(uint32_t(1));
+				static uint32_t old_count = 1;
+
+				auto new_count = state.world.province_size();
+				if(new_count > old_count) {
+					max_buffer = state.world.province_make_vectorizable_float_buffer();
+					second_buffer = state.world.province_make_vectorizable_float_buffer();
+					old_count = new_count;
+				}
 
 				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&](auto p) {
 					max_buffer.set(p, ve::fp_vector());
+					second_buffer.set(p, ve::fp_vector());
+					state.world.province_set_dominant_issue_option(p, ve::tagged_vector<dcon::issue_option_id>());
+					state.world.province_set_second_issue_option(p, ve::tagged_vector<dcon::issue_option_id>());
 				});
 				state.world.for_each_issue_option([&](dcon::issue_option_id c) {
 					ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&](auto p) {
 						auto v = state.world.province_get_demographics(p, to_key(state, c));
 						auto old_max = max_buffer.get(p);
+						auto old_second = second_buffer.get(p);
+						auto old_max_id = state.world.province_get_dominant_issue_option(p);
 						auto mask = v > old_max;
-						state.world.province_set_dominant_issue_option(p, ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.province_get_dominant_issue_option(p)));
+						auto second_mask = v > old_second;
+						state.world.province_set_second_issue_option(p, ve::select(mask, old_max_id, ve::select(second_mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.province_get_second_issue_option(p))));
+						second_buffer.set(p, ve::select(mask, old_max, ve::select(second_mask, v, old_second)));
+						state.world.province_set_dominant_issue_option(p, ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), old_max_id));
 						max_buffer.set(p, ve::select(mask, v, old_max));
 					});
 				});
+				ve::execute_serial<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()), [&](auto p) {
+					auto total_pop = state.world.province_get_demographics(p, total);
+					state.world.province_set_dominant_issue_option_share(p, ve::select(total_pop > 0.0f, max_buffer.get(p) / total_pop, 0.0f));
+					state.world.province_set_second_issue_option_share(p, ve::select(total_pop > 0.0f, second_buffer.get(p) / total_pop, 0.0f));
+				});
 				break;
 			}
 			case 10:
 			{
 				static ve::vectorizable_buffer<float, dcon::state_instance_id> max_buffer(uint32_t(1));
+				static ve::vectorizable_buffer<float, dcon::state_instance_id> second_buffer(uint32_t(1));
 				static uint32_t old_count = 1;
 
 				auto new_count = state.world.state_instance_size();
 				if(new_count > old_count) {
 					max_buffer = state.world.state_instance_make_vectorizable_float_buffer();
+					second_buffer = state.world.state_instance_make_vectorizable_float_buffer();
 					old_count = new_count;
 				}
 				state.world.execute_serial_over_state_instance([&](auto p) {
 					max_buffer.set(p, ve::fp_vector());
+					second_buffer.set(p, ve::fp_vector());
+					state.world.state_instance_set_dominant_issue_option(p, ve::tagged_vector<dcon::issue_option_id>());
+					state.world.state_instance_set_second_issue_option(p, ve::tagged_vector<dcon::issue_option_id>());
 				});
 				state.world.for_each_issue_option([&](dcon::issue_option_id c) {
 					state.world.execute_serial_over_state_instance([&](auto p) {
 						auto v = state.world.state_instance_get_demographics(p, to_key(state, c));
 						auto old_max = max_buffer.get(p);
+						auto old_second = second_buffer.get(p);
+						auto old_max_id = state.world.state_instance_get_dominant_issue_option(p);
 						auto mask = v > old_max;
-						state.world.state_instance_set_dominant_issue_option(p, ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.state_instance_get_dominant_issue_option(p)));
+						auto second_mask = v > old_second;
+						state.world.state_instance_set_second_issue_option(p, ve::select(mask, old_max_id, ve::select(second_mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.state_instance_get_second_issue_option(p))));
+						second_buffer.set(p, ve::select(mask, old_max, ve::select(second_mask, v, old_second)));
+						state.world.state_instance_set_dominant_issue_option(p, ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), old_max_id));
 						max_buffer.set(p, ve::select(mask, v, old_max));
 					});
 				});
+				state.world.execute_serial_over_state_instance([&](auto p) {
+					auto total_pop = state.world.state_instance_get_demographics(p, total);
+					state.world.state_instance_set_dominant_issue_option_share(p, ve::select(total_pop > 0.0f, max_buffer.get(p) / total_pop, 0.0f));
+					state.world.state_instance_set_second_issue_option_share(p, ve::select(total_pop > 0.0f, second_buffer.get(p) / total_pop, 0.0f));
+				});
 				break;
 			}
 			case 11:
 			{
 				static ve::vectorizable_buffer<float, dcon::nation_id> max_buffer(uint32_t(1));
+				static ve::vectorizable_buffer<float, dcon::nation_id> second_buffer(uint32_t(1));
 				static uint32_t old_count = 1;
 
 				auto new_count = state.world.nation_size();
 				if(new_count > old_count) {
 					max_buffer = state.world.nation_make_vectorizable_float_buffer();
+					second_buffer = state.world.nation_make_vectorizable_float_buffer();
 					old_count = new_count;
 				}
 				state.world.execute_serial_over_nation([&](auto p) {
 					max_buffer.set(p, ve::fp_vector());
+					second_buffer.set(p, ve::fp_vector());
+					state.world.nation_set_dominant_issue_option(p, ve::tagged_vector<dcon::issue_option_id>());
+					state.world.nation_set_second_issue_option(p, ve::tagged_vector<dcon::issue_option_id>());
 				});
 				state.world.for_each_issue_option([&](dcon::issue_option_id c) {
 					state.world.execute_serial_over_nation([&](auto p) {
 						auto v = state.world.nation_get_demographics(p, to_key(state, c));
 						auto old_max = max_buffer.get(p);
+						auto old_second = second_buffer.get(p);
+						auto old_max_id = state.world.nation_get_dominant_issue_option(p);
 						auto mask = v > old_max;
-						state.world.nation_set_dominant_issue_option(p, ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.nation_get_dominant_issue_option(p)));
+						auto second_mask = v > old_second;
+						state.world.nation_set_second_issue_option(p, ve::select(mask, old_max_id, ve::select(second_mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.nation_get_second_issue_option(p))));
+						second_buffer.set(p, ve::select(mask, old_max, ve::select(second_mask, v, old_second)));
+						state.world.nation_set_dominant_issue_option(p, ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), old_max_id));
 						max_buffer.set(p, ve::select(mask, v, old_max));
 					});
 				});
+				state.world.execute_serial_over_nation([&](auto p) {
+					auto total_pop = state.world.nation_get_demographics(p, total);
+					state.world.nation_set_dominant_issue_option_share(p, ve::select(total_pop > 0.0f, max_buffer.get(p) / total_pop, 0.0f));
+					state.world.nation_set_second_issue_option_share(p, ve::select(total_pop > 0.0f, second_buffer.get(p) / total_pop, 0.0f));
+				});
 				break;
 			}
 			case 12:
@@ -537,7 +831,13 @@ void regenerate_from_pop_data(sys::state& state) {
 				});
 				state.world.for_each_issue_option([&](dcon::issue_option_id c) {
 					state.world.execute_serial_over_pop([&](auto p) {
-						auto v = state.world.pop_get_demographics(p, pop_demographics::to_key(state, c));
+						// within a single pop, the raw stored values can be compared directly, whatever the storage mode
+						auto v = [&]() {
+							if constexpr(pop_demographics::quantized_storage)
+								return ve::to_float(state.world.pop_get_quantized_demographics(p, pop_demographics::to_key(state, c)));
+							else
+								return state.world.pop_get_demographics(p, pop_demographics::to_key(state, c));
+						}();
 						auto old_max = max_buffer.get(p);
 						auto mask = v > old_max;
 						state.world.pop_set_dominant_issue_option(p, ve::select(mask, ve::tagged_vector<dcon::issue_option_id>(c), state.world.pop_get_dominant_issue_option(p)));
@@ -561,7 +861,13 @@ void regenerate_from_pop_data(sys::state& state) {
 				});
 				state.world.for_each_ideology([&](dcon::ideology_id c) {
 					state.world.execute_serial_over_pop([&](auto p) {
-						auto v = state.world.pop_get_demographics(p, pop_demographics::to_key(state, c));
+						// within a single pop, the raw stored values can be compared directly, whatever the storage mode
+						auto v = [&]() {
+							if constexpr(pop_demographics::quantized_storage)
+								return ve::to_float(state.world.pop_get_quantized_demographics(p, pop_demographics::to_key(state, c)));
+							else
+								return state.world.pop_get_demographics(p, pop_demographics::to_key(state, c));
+						}();
 						auto old_max = max_buffer.get(p);
 						auto mask = v > old_max;
 						state.world.pop_set_dominant_ideology(p, ve::select(mask, ve::tagged_vector<dcon::ideology_id>(c), state.world.pop_get_dominant_ideology(p)));
@@ -604,6 +910,9 @@ void regenerate_from_pop_data(sys::state& state) {
 				break;
 		}
 	});
+
+	// demographics are summed again for every province, and from them every nation
+	state.mark_changed(ui::update_domain::nation | ui::update_domain::province);
 }
 
 
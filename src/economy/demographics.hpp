@@ -1,12 +1,44 @@
 #pragma once
 #include "dcon_generated.hpp"
 #include "container_types.hpp"
+#include "ve_scalar_extensions.hpp"
 
 namespace pop_demographics {
 
+// When ALICE_QUANTIZED_POP_DEMOGRAPHICS is defined, the ideology and issue support of each pop is stored in the
+// quantized_demographics property as a 16 bit fixed point fraction of the pop's size instead of as an absolute
+// amount in the demographics property. Only the property in use is ever resized; the other one stays empty.
+// Code outside of this module should go through get_demo / set_demo rather than touching either property directly.
+#ifdef ALICE_QUANTIZED_POP_DEMOGRAPHICS
+constexpr inline bool quantized_storage = true;
+#else
+constexpr inline bool quantized_storage = false;
+#endif
+
+constexpr inline float quantization_max = 65535.0f;
+
 dcon::pop_demographics_key to_key(sys::state const& state, dcon::ideology_id v);
 dcon::pop_demographics_key to_key(sys::state const& state, dcon::issue_option_id v);
 uint32_t size(sys::state const& state);
+void resize_storage(sys::state& state);
+
+inline uint16_t pack_share(float share) {
+	return uint16_t(std::clamp(share, 0.0f, 1.0f) * quantization_max + 0.5f);
+}
+template<typename T>
+auto unpack_share(T packed) {
+	return ve::to_float(packed) * (1.0f / quantization_max);
+}
+
+// the absolute amount of the pop supporting the ideology / issue (i.e. the share times the size of the pop)
+float get_demo(sys::state const& state, dcon::pop_id p, dcon::pop_demographics_key key);
+template<typename T>
+ve::fp_vector get_demo(sys::state const& state, T pop_ids, dcon::pop_demographics_key key);
+// the fraction of the pop supporting the ideology / issue
+float get_demo_share(sys::state const& state, dcon::pop_id p, dcon::pop_demographics_key key);
+template<typename T>
+ve::fp_vector get_demo_share(sys::state const& state, T pop_ids, dcon::pop_demographics_key key);
+void set_demo(sys::state& state, dcon::pop_id p, dcon::pop_demographics_key key, float amount);
 
 }
 namespace demographics {
@@ -1,6 +1,8 @@
 #include "economy.hpp"
 #include "dcon_generated.hpp"
+#include "demographics.hpp"
 #include "system_state.hpp"
+#include <algorithm>
 
 namespace economy {
 
@@ -36,5 +38,289 @@ bool is_bankrupt_debtor_to(sys::state& state, dcon::nation_id debt_holder, dcon:
 		state.world.unilateral_relationship_get_owns_debt_of(state.world.get_unilateral_relationship_by_unilateral_pair(debtor, debt_holder)) > 0.1f;
 }
 
+float desired_needs_spending(sys::state const& state, dcon::pop_id p) {
+	auto t = state.world.pop_get_poptype(p);
+	return state.world.pop_get_size(p) * needs_scaling_factor * (state.world.pop_type_get_life_needs_cost(t) + state.world.pop_type_get_everyday_needs_cost(t) + state.world.pop_type_get_luxury_needs_cost(t));
 }
+template<typename T>
+ve::fp_vector desired_needs_spending(sys::state const& state, T pop_indices) {
+	auto t = state.world.pop_get_poptype(pop_indices);
+	return state.world.pop_get_size(pop_indices) * needs_scaling_factor * (state.world.pop_type_get_life_needs_cost(t) + state.world.pop_type_get_everyday_needs_cost(t) + state.world.pop_type_get_luxury_needs_cost(t));
+}
+
+void initialize(sys::state& state) {
+	state.world.execute_serial_over_commodity([&](auto ids) {
+		state.world.commodity_set_current_price(ids, state.world.commodity_get_cost(ids));
+	});
+}
+
+/*
+* The daily update is organized as a handful of passes, each of which touches only a few columns of the data container.
+* Anything that runs over every pop is written against whole vectors of pops, except for the one pass that sums the pops
+* by type; the other loops that remain scalar run over pop types, commodities, factories or provinces, of which there are
+* far fewer.
+*/
+
+namespace {
+
+// cost of the needs baskets of every pop type at current prices, and which fraction of that basket (by value) the market could supply yesterday
+void update_needs_costs(sys::state& state) {
+	state.world.execute_serial_over_pop_type([&](auto ids) {
+		ve::fp_vector life_cost;
+		ve::fp_vector everyday_cost;
+		ve::fp_vector luxury_cost;
+		ve::fp_vector life_available;
+		ve::fp_vector everyday_available;
+		ve::fp_vector luxury_available;
+		state.world.for_each_commodity([&](dcon::commodity_id c) {
+			auto price = state.world.commodity_get_current_price(c);
+			auto available_price = price * state.world.commodity_get_demand_satisfaction(c);
+
+			auto life = state.world.pop_type_get_life_needs(ids, c);
+			life_cost = ve::multiply_and_add(price, life, life_cost);
+			life_available = ve::multiply_and_add(available_price, life, life_available);
+
+			auto everyday = state.world.pop_type_get_everyday_needs(ids, c);
+			everyday_cost = ve::multiply_and_add(price, everyday, everyday_cost);
+			everyday_available = ve::multiply_and_add(available_price, everyday, everyday_available);
+
+			auto luxury = state.world.pop_type_get_luxury_needs(ids, c);
+			luxury_cost = ve::multiply_and_add(price, luxury, luxury_cost);
+			luxury_available = ve::multiply_and_add(available_price, luxury, luxury_available);
+		});
+		state.world.pop_type_set_life_needs_cost(ids, life_cost);
+		state.world.pop_type_set_everyday_needs_cost(ids, everyday_cost);
+		state.world.pop_type_set_luxury_needs_cost(ids, luxury_cost);
+		state.world.pop_type_set_life_needs_availability(ids, ve::select(life_cost > 0.0f, life_available / life_cost, 1.0f));
+		state.world.pop_type_set_everyday_needs_availability(ids, ve::select(everyday_cost > 0.0f, everyday_available / everyday_cost, 1.0f));
+		state.world.pop_type_set_luxury_needs_availability(ids, ve::select(luxury_cost > 0.0f, luxury_available / luxury_cost, 1.0f));
+	});
+}
+
+// pops are paid out of yesterday's production and then buy life, everyday and luxury needs, in that order, out of their savings
+void update_pop_consumption(sys::state& state) {
+	state.world.execute_parallel_over_pop([&](auto ids) {
+		auto types = state.world.pop_get_poptype(ids);
+		auto size = state.world.pop_get_size(ids);
+		auto owner = state.world.province_get_nation_from_province_ownership(state.world.pop_get_province_from_pop_location(ids));
+
+		auto workers = ve::select(state.world.pop_type_get_has_unemployment(types), size, 0.0f);
+		auto owners = ve::select(state.world.pop_type_get_strata(types) == uint8_t(culture::pop_strata::rich), size, 0.0f);
+		auto budget = state.world.pop_get_savings(ids)
+			+ workers * state.world.nation_get_worker_wage(owner)
+			+ owners * state.world.nation_get_owner_dividend(owner);
+
+		auto scale = size * needs_scaling_factor;
+
+		auto life_cost = scale * state.world.pop_type_get_life_needs_cost(types);
+		auto life_satisfaction = ve::min(state.world.pop_type_get_life_needs_availability(types), ve::select(life_cost > 0.0f, budget / life_cost, 1.0f));
+		budget = ve::max(budget - life_cost * life_satisfaction, 0.0f);
+
+		auto everyday_cost = scale * state.world.pop_type_get_everyday_needs_cost(types);
+		auto everyday_satisfaction = ve::min(state.world.pop_type_get_everyday_needs_availability(types), ve::select(everyday_cost > 0.0f, budget / everyday_cost, 1.0f));
+		budget = ve::max(budget - everyday_cost * everyday_satisfaction, 0.0f);
+
+		auto luxury_cost = scale * state.world.pop_type_get_luxury_needs_cost(types);
+		auto luxury_satisfaction = ve::min(state.world.pop_type_get_luxury_needs_availability(types), ve::select(luxury_cost > 0.0f, budget / luxury_cost, 1.0f));
+		budget = ve::max(budget - luxury_cost * luxury_satisfaction, 0.0f);
+
+		state.world.pop_set_life_needs_satisfaction(ids, life_satisfaction);
+		state.world.pop_set_everyday_needs_satisfaction(ids, everyday_satisfaction);
+		state.world.pop_set_luxury_needs_satisfaction(ids, luxury_satisfaction);
+		state.world.pop_set_savings(ids, budget);
+	});
+}
+
+struct needs_weights {
+	float life = 0.0f;
+	float everyday = 0.0f;
+	float luxury = 0.0f;
+};
+// the number of pops summed by one task in gather_needs_weights
+constexpr inline uint32_t needs_block_size = 4096;
+
+// for each pop type, the number of needs baskets its pops actually bought today
+// a single pass over the pops: each block of pops sums into its own row of per-type partials, and the rows are added up
+// afterwards in block order, so the result does not depend on how the blocks were scheduled
+void gather_needs_weights(sys::state& state, std::vector<needs_weights>& weights) {
+	static std::vector<needs_weights> partials;
+
+	uint32_t type_count = state.world.pop_type_size();
+	uint32_t pop_count = state.world.pop_size();
+	uint32_t block_count = (pop_count + needs_block_size - 1) / needs_block_size;
+	partials.assign(size_t(block_count) * type_count, needs_weights{});
+
+	concurrency::parallel_for(uint32_t(0), block_count, [&](uint32_t block) {
+		auto row = partials.data() + size_t(block) * type_count;
+		uint32_t last = std::min(pop_count, (block + 1) * needs_block_size);
+		// the pops are scattered to the slot of their type, which has no vector form
+		for(uint32_t i = block * needs_block_size; i < last; ++i) {
+			dcon::pop_id p{ dcon::pop_id::value_base_t(i) };
+			auto t = state.world.pop_get_poptype(p);
+			if(!t)
+				continue;
+			auto scale = state.world.pop_get_size(p) * needs_scaling_factor;
+			auto& w = row[t.index()];
+			w.life += scale * state.world.pop_get_life_needs_satisfaction(p);
+			w.everyday += scale * state.world.pop_get_everyday_needs_satisfaction(p);
+			w.luxury += scale * state.world.pop_get_luxury_needs_satisfaction(p);
+		}
+	});
+
+	weights.assign(type_count, needs_weights{});
+	for(uint32_t block = 0; block < block_count; ++block) {
+		auto row = partials.data() + size_t(block) * type_count;
+		for(uint32_t t = 0; t < type_count; ++t) {
+			weights[t].life += row[t].life;
+			weights[t].everyday += row[t].everyday;
+			weights[t].luxury += row[t].luxury;
+		}
+	}
+}
+
+// rgo and factory output of every state, the inputs its factories ask for, and the value added in it
+void update_production(sys::state& state, std::vector<float>& value_added) {
+	value_added.resize(state.world.state_instance_size());
+	concurrency::parallel_for(uint32_t(0), state.world.state_instance_size(), [&](uint32_t index) {
+		dcon::state_instance_id si{ dcon::state_instance_id::value_base_t(index) };
+		state.world.for_each_commodity([&](dcon::commodity_id c) {
+			state.world.state_instance_set_last_production(si, c, 0.0f);
+			state.world.state_instance_set_last_demand(si, c, 0.0f);
+		});
+		value_added[index] = 0.0f;
+		if(!state.world.state_instance_is_valid(si))
+			return;
+
+		auto owner = state.world.state_instance_get_nation_from_state_ownership(si);
+		auto sdef = state.world.state_instance_get_definition(si);
+		float value = 0.0f;
+
+		for(auto m : state.world.state_definition_get_abstract_state_membership(sdef)) {
+			auto p = m.get_province();
+			if(p.get_nation_from_province_ownership() != owner)
+				continue;
 
+			if(auto c = p.get_rgo(); c) {
+				auto workforce = float(state.world.commodity_get_rgo_workforce(c));
+				if(workforce > 0.0f) {
+					auto amount = state.world.commodity_get_rgo_amount(c) * p.get_demographics(demographics::employable) / workforce
+						* (1.0f + state.world.nation_get_rgo_goods_output(owner, c));
+					state.world.state_instance_get_last_production(si, c) += amount;
+					value += amount * state.world.commodity_get_current_price(c);
+				}
+			}
+
+			for(auto fl : p.get_factory_location()) {
+				auto type = fl.get_factory().get_building_type();
+				auto level = float(fl.get_factory().get_level());
+				auto& inputs = state.world.factory_type_get_inputs(type);
+
+				// a factory can only run as far as the scarcest of its inputs was available yesterday
+				float input_ratio = 1.0f;
+				for(uint32_t i = 0; i < commodity_set::set_size; ++i) {
+					if(inputs.commodity_type[i])
+						input_ratio = std::min(input_ratio, state.world.commodity_get_demand_satisfaction(inputs.commodity_type[i]));
+				}
+				for(uint32_t i = 0; i < commodity_set::set_size; ++i) {
+					if(auto c = inputs.commodity_type[i]; c) {
+						auto amount = level * inputs.commodity_amounts[i];
+						state.world.state_instance_get_last_demand(si, c) += amount;
+						value -= amount * input_ratio * state.world.commodity_get_current_price(c);
+					}
+				}
+
+				auto output = state.world.factory_type_get_output(type);
+				auto amount = level * state.world.factory_type_get_output_amount(type) * input_ratio
+					* (1.0f + state.world.nation_get_factory_goods_output(owner, output));
+				state.world.state_instance_get_last_production(si, output) += amount;
+				value += amount * state.world.commodity_get_current_price(output);
+			}
+		}
+
+		value_added[index] = value;
+	});
+}
+
+// splits the value added in each nation between its workers and its rich pops, to be paid out tomorrow
+void update_national_income(sys::state& state, std::vector<float> const& value_added) {
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t index) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(index) };
+		state.world.for_each_commodity([&](dcon::commodity_id c) {
+			state.world.nation_set_last_production(n, c, 0.0f);
+		});
+
+		float value = 0.0f;
+		for(auto so : state.world.nation_get_state_ownership(n)) {
+			auto si = so.get_state();
+			value += value_added[si.id.index()];
+			state.world.for_each_commodity([&](dcon::commodity_id c) {
+				state.world.nation_get_last_production(n, c) += si.get_last_production(c);
+			});
+		}
+		value = std::max(value, 0.0f);
+
+		auto workers = state.world.nation_get_demographics(n, demographics::employable);
+		auto owners = state.world.nation_get_demographics(n, demographics::rich_total);
+		state.world.nation_set_worker_wage(n, workers > 0.0f ? value * worker_share / workers : 0.0f);
+		state.world.nation_set_owner_dividend(n, owners > 0.0f ? value * (1.0f - worker_share) / owners : 0.0f);
+	});
+}
+
+// total supply and demand of each commodity on the world market
+void gather_market_totals(sys::state& state, std::vector<needs_weights> const& weights) {
+	concurrency::parallel_for(uint32_t(0), state.world.commodity_size(), [&](uint32_t index) {
+		dcon::commodity_id c{ dcon::commodity_id::value_base_t(index) };
+
+		float pop_demand = 0.0f;
+		state.world.for_each_pop_type([&](dcon::pop_type_id t) {
+			auto& w = weights[t.index()];
+			pop_demand += state.world.pop_type_get_life_needs(t, c) * w.life
+				+ state.world.pop_type_get_everyday_needs(t, c) * w.everyday
+				+ state.world.pop_type_get_luxury_needs(t, c) * w.luxury;
+		});
+
+		ve::fp_vector supply;
+		ve::fp_vector factory_demand;
+		state.world.execute_serial_over_state_instance([&](auto ids) {
+			supply = supply + state.world.state_instance_get_last_production(ids, c);
+			factory_demand = factory_demand + state.world.state_instance_get_last_demand(ids, c);
+		});
+
+		state.world.commodity_set_total_production(c, supply.reduce());
+		state.world.commodity_set_total_demand(c, pop_demand + factory_demand.reduce());
+	});
+}
+
+// prices move towards the point where supply meets demand, but never further than price_range from the base cost
+void update_prices(sys::state& state) {
+	state.world.execute_serial_over_commodity([&](auto ids) {
+		auto supply = state.world.commodity_get_total_production(ids);
+		auto demand = state.world.commodity_get_total_demand(ids);
+		auto cost = state.world.commodity_get_cost(ids);
+
+		auto excess = ve::select(supply + demand > 0.0f, (demand - supply) / (supply + demand), 0.0f);
+		auto price = state.world.commodity_get_current_price(ids) * (1.0f + price_speed * excess);
+		state.world.commodity_set_current_price(ids, ve::min(ve::max(price, cost / price_range), cost * price_range));
+		state.world.commodity_set_demand_satisfaction(ids, ve::select(demand > 0.0f, ve::min(supply / demand, 1.0f), 1.0f));
+	});
+}
+
+}
+
+void daily_update(sys::state& state) {
+	static std::vector<needs_weights> weights;
+	static std::vector<float> value_added;
+
+	update_needs_costs(state);
+	update_pop_consumption(state);
+	gather_needs_weights(state, weights);
+	update_production(state, value_added);
+	update_national_income(state, value_added);
+	gather_market_totals(state, weights);
+	update_prices(state);
+
+	// pop consumption and national income are rewritten for everyone
+	state.mark_changed(ui::update_domain::nation | ui::update_domain::province);
+}
+
+}
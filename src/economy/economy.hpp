@@ -43,13 +43,25 @@ enum class worker_effect : uint8_t {
 	none = 0, input, output, throughput
 };
 
+constexpr inline dcon::commodity_id money(0);
+
+// the needs vectors of a pop type are given per this many people
+constexpr inline float needs_scaling_factor = 1.0f / 200000.0f;
+// how far the price of a commodity may move away from its base cost, in either direction
+constexpr inline float price_range = 5.0f;
+// the largest fraction by which a price moves in a single day
+constexpr inline float price_speed = 0.01f;
+// the part of the value added in a nation that is paid out to its workers; the rest goes to its rich pops
+constexpr inline float worker_share = 0.7f;
+
+// the cost of buying all of the needs of the pop at current prices
+float desired_needs_spending(sys::state const& state, dcon::pop_id p);
 template<typename T>
-auto desired_needs_spending(sys::state const& state, T pop_indices) {
-	// TODO: gather pop types, extract cached needs sum, etc etc
-	return 0.0f;
-}
+ve::fp_vector desired_needs_spending(sys::state const& state, T pop_indices);
 
-constexpr inline dcon::commodity_id money(0);
+void initialize(sys::state& state);
+// runs one day of the market: pop consumption, production and price adjustment
+void daily_update(sys::state& state);
 
 bool has_factory(sys::state const& state, dcon::state_instance_id si);
 bool has_building(sys::state const& state, dcon::state_instance_id si, dcon::factory_type_id fac);
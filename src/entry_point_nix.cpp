@@ -8,10 +8,13 @@ int main() {
 	add_root(game_state->common_fs, NATIVE_M(GAME_DIR)); // game files directory is overlaid on top of that
 
 
-	if(!sys::try_read_scenario_and_save_file(*game_state, NATIVE("development_test_file.bin"))) {
+	auto scenario_name = sys::scenario_file_name(game_state->common_fs);
+	if(!sys::try_read_scenario_and_save_file(*game_state, scenario_name)) {
 		// scenario making functions
+		simple_fs::start_recording_accesses(game_state->common_fs);
 		game_state->load_scenario_data();
-		sys::write_scenario_file(*game_state, NATIVE("development_test_file.bin"));
+		auto manifest = sys::make_scenario_manifest(game_state->common_fs, simple_fs::stop_recording_accesses(game_state->common_fs));
+		sys::write_scenario_file(*game_state, scenario_name, manifest);
 	}
 
 	// scenario loading functions (would have to run these even when scenario is pre-built
@@ -26,7 +29,7 @@ int main() {
 
 	window::create_window(*game_state, window::creation_parameters());
 
-	game_state->quit_signaled.store(true, std::memory_order_release);
+	game_state->signal_quit();
 	update_thread.join();
 
 	return EXIT_SUCCESS;
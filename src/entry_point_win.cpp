@@ -35,10 +35,13 @@ int WINAPI wWinMain(
 		add_root(game_state->common_fs, NATIVE(".")); // will add the working directory as first root -- for the moment this lets us find the shader files
 		add_root(game_state->common_fs, NATIVE_M(GAME_DIR)); // game files directory is overlaid on top of that
 
-		if(!sys::try_read_scenario_and_save_file(*game_state, NATIVE("development_test_file.bin"))) {
+		auto scenario_name = sys::scenario_file_name(game_state->common_fs);
+		if(!sys::try_read_scenario_and_save_file(*game_state, scenario_name)) {
 			// scenario making functions
+			simple_fs::start_recording_accesses(game_state->common_fs);
 			game_state->load_scenario_data();
-			sys::write_scenario_file(*game_state, NATIVE("development_test_file.bin"));
+			auto manifest = sys::make_scenario_manifest(game_state->common_fs, simple_fs::stop_recording_accesses(game_state->common_fs));
+			sys::write_scenario_file(*game_state, scenario_name, manifest);
 		}
 
 		// scenario loading functions (would have to run these even when scenario is pre-built
@@ -55,7 +58,7 @@ int WINAPI wWinMain(
 		// entire game runs during this line
 		window::create_window(*game_state, window::creation_parameters{ 1024, 780, sys::window_state::maximized, game_state->user_settings.prefer_fullscreen });
 
-		game_state->quit_signaled.store(true, std::memory_order_release);
+		game_state->signal_quit();
 		update_thread.join();
 		CoUninitialize();
 	}
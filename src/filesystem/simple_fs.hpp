@@ -12,6 +12,10 @@
 #include <stdint.h>
 #include <vector>
 #include <optional>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include "unordered_dense.h"
 
 namespace simple_fs {
 	class file;
@@ -23,6 +27,33 @@ namespace simple_fs {
 		char const* data = nullptr;
 		uint32_t file_size = 0;
 	};
+
+	enum class access_type : uint8_t {
+		file_contents, // first = absolute path of a file that was opened or listed
+		file_resolution, // first = relative directory, second = file name that was looked up through the roots
+		directory_listing, // first = relative directory, second = extension of the files that were listed
+		subdirectory_listing // first = relative directory whose subdirectories were listed
+	};
+	struct recorded_access {
+		access_type type = access_type::file_contents;
+		native_string first;
+		native_string second;
+	};
+
+	void record_access(file_system const& fs, access_type type, native_string_view first, native_string_view second);
+
+	// the merged contents of one relative directory across all of the roots of a file system
+	// each name appears once, attributed to the last root that contains it, and in the order that a
+	// walk over the roots from last to first would encounter it
+	struct overlay_file {
+		native_string name;
+		uint32_t root = 0;
+	};
+	struct overlay_directory {
+		std::vector<overlay_file> files;
+		std::vector<native_string> subdirectories;
+		ankerl::unordered_dense::map<native_string, uint32_t> file_lookup; // normalized name -> index into files
+	};
 }
 
 #ifdef _WIN64
@@ -48,6 +79,10 @@ namespace simple_fs {
 	native_string extract_state(file_system const& fs);
 	void restore_state(file_system& fs, native_string_view data);
 
+	// while recording, every file opened, looked up, or listed through the roots of the file system is noted down
+	void start_recording_accesses(file_system& fs);
+	std::vector<recorded_access> stop_recording_accesses(file_system& fs);
+
 	// directory functions
 	std::vector<unopened_file> list_files(directory const& dir, native_char const* extension);
 	std::vector<directory> list_subdirectories(directory const& dir);
@@ -71,6 +106,7 @@ namespace simple_fs {
 	directory get_or_create_save_game_directory();
 	directory get_or_create_scenario_directory();
 	directory get_or_create_settings_directory();
+	directory get_or_create_cache_directory(); // for data derived from the game files that can be regenerated at any time
 
 	// necessary for reading paths out of data from inside older paradox files:
 	// even on linux, this must do something, because win1250 isn't ascii or utf8
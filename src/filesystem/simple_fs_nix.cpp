@@ -77,12 +77,19 @@ std::optional<file> open_file(unopened_file const& f) {
     return result;
 }
 
+void clear_overlay(file_system& fs) {
+    std::lock_guard lock(fs.overlay_lock);
+    fs.overlay_directories.clear();
+}
+
 void reset(file_system& fs) {
     fs.ordered_roots.clear();
+    clear_overlay(fs);
 }
 
 void add_root(file_system& fs, native_string_view root_path) {
     fs.ordered_roots.emplace_back(root_path);
+    clear_overlay(fs);
 }
 
 void add_relative_root(file_system& fs, native_string_view root_path) {
@@ -96,6 +103,7 @@ void add_relative_root(file_system& fs, native_string_view root_path) {
     }
 
     fs.ordered_roots.push_back(native_string(module_name) + native_string(root_path));
+    clear_overlay(fs);
 }
 
 directory get_root(file_system const& fs) {
@@ -120,41 +128,106 @@ void restore_state(file_system& fs, native_string_view data) {
         fs.ordered_roots.emplace_back(position, next_semicolon);
         position = next_semicolon + 1;
     }
+    clear_overlay(fs);
+}
+
+void start_recording_accesses(file_system& fs) {
+    std::lock_guard lock(fs.access_record_lock);
+    fs.recorded_accesses.clear();
+    fs.recording_accesses.store(true, std::memory_order::release);
+}
+std::vector<recorded_access> stop_recording_accesses(file_system& fs) {
+    std::lock_guard lock(fs.access_record_lock);
+    fs.recording_accesses.store(false, std::memory_order::release);
+    return std::move(fs.recorded_accesses);
+}
+void record_access(file_system const& fs, access_type type, native_string_view first, native_string_view second) {
+    if (!fs.recording_accesses.load(std::memory_order::acquire))
+        return;
+    std::lock_guard lock(fs.access_record_lock);
+    fs.recorded_accesses.push_back(recorded_access{type, native_string(first), native_string(second)});
+}
+
+bool has_extension(char const* name, native_char const* extension) {
+    if (!extension[0])
+        return true;
+    char const* dot = strrchr(name, '.');
+    if (!dot || dot == name)
+        return false;
+    return strcmp(dot, extension) == 0;
+}
+
+overlay_directory const& find_overlay_directory(file_system const& fs, native_string const& relative_path) {
+    std::lock_guard lock(fs.overlay_lock);
+    if (auto it = fs.overlay_directories.find(relative_path); it != fs.overlay_directories.end())
+        return *(it->second);
+
+    auto result = std::make_unique<overlay_directory>();
+    ankerl::unordered_dense::set<native_string> seen_directories;
+    for (size_t i = fs.ordered_roots.size(); i-- > 0;) {
+        const auto appended_path = fs.ordered_roots[i] + relative_path;
+        DIR* d = opendir(appended_path.c_str());
+        if (!d)
+            continue;
+        struct dirent* dir_ent;
+        while ((dir_ent = readdir(d)) != nullptr) {
+            auto type = dir_ent->d_type;
+            // Links, and file systems that do not report a type, are resolved to what they point at
+            if (type == DT_LNK || type == DT_UNKNOWN) {
+                struct stat stat_buf;
+                if (fstatat(dirfd(d), dir_ent->d_name, &stat_buf, 0) == -1)
+                    continue;
+                type = S_ISREG(stat_buf.st_mode) ? DT_REG : (S_ISDIR(stat_buf.st_mode) ? DT_DIR : DT_UNKNOWN);
+            }
+
+            if (type == DT_REG) {
+                native_string name(dir_ent->d_name);
+                if (result->file_lookup.find(name) == result->file_lookup.end()) {
+                    result->file_lookup.insert_or_assign(name, uint32_t(result->files.size()));
+                    result->files.push_back(overlay_file{std::move(name), uint32_t(i)});
+                }
+            } else if (type == DT_DIR && dir_ent->d_name[0] != NATIVE('.')) {
+                if (seen_directories.insert(native_string(dir_ent->d_name)).second) {
+                    result->subdirectories.emplace_back(dir_ent->d_name);
+                }
+            }
+        }
+        closedir(d);
+    }
+    auto& stored = fs.overlay_directories.insert_or_assign(relative_path, std::move(result)).first->second;
+    return *stored;
+}
+
+// finds which root, if any, provides a file that is named relative to a directory
+// the file name may itself contain directories, in which case the directory that holds it is looked up instead
+std::optional<native_string> resolve_file(directory const& dir, native_string_view file_name) {
+    native_string directory_path = dir.relative_path;
+    native_string_view leaf_name = file_name;
+    if (auto last_separator = file_name.find_last_of(NATIVE('/')); last_separator != native_string_view::npos) {
+        directory_path += NATIVE('/');
+        directory_path += file_name.substr(0, last_separator);
+        leaf_name = file_name.substr(last_separator + 1);
+    }
+
+    auto const& overlay = find_overlay_directory(*dir.parent_system, directory_path);
+    if (auto it = overlay.file_lookup.find(native_string(leaf_name)); it != overlay.file_lookup.end()) {
+        return dir.parent_system->ordered_roots[overlay.files[it->second].root] + dir.relative_path + NATIVE('/') + native_string(file_name);
+    }
+    return std::optional<native_string>{};
 }
 
 std::vector<unopened_file> list_files(directory const& dir, native_char const* extension) {
     std::vector<unopened_file> accumulated_results;
     if (dir.parent_system) {
-        for (size_t i = dir.parent_system->ordered_roots.size(); i-- > 0;) {
-            DIR* d;
-            struct dirent* dir_ent;
-            const auto appended_path = dir.parent_system->ordered_roots[i] + dir.relative_path;
-            d = opendir(appended_path.c_str());
-            if (d) {
-                while ((dir_ent = readdir(d)) != nullptr) {
-                    // Check if it's a file. Not POSIX standard but included in Linux
-                    if (dir_ent->d_type != DT_REG)
-                        continue;
-					
-					// Check if the file is of the right extension
-					if (strlen(extension)) {
-					    char* dot = strrchr(dir_ent->d_name, '.');
-						if(!dot || dot == dir_ent->d_name)
-							continue;
-						if (strcmp(dot, extension))
-							continue;
-					}
-
-                    auto search_result = std::find_if(accumulated_results.begin(), accumulated_results.end(), [n = dir_ent->d_name](const auto& f) {
-                        return f.file_name.compare(n) == 0;
-                    });
-                    if (search_result == accumulated_results.end()) {
-                        accumulated_results.emplace_back(dir.parent_system->ordered_roots[i] + dir.relative_path + NATIVE("/") + dir_ent->d_name, dir_ent->d_name);
-                    }
-                }
-                closedir(d);
+        auto const& overlay = find_overlay_directory(*dir.parent_system, dir.relative_path);
+        for (auto const& f : overlay.files) {
+            if (has_extension(f.name.c_str(), extension)) {
+                accumulated_results.emplace_back(dir.parent_system->ordered_roots[f.root] + dir.relative_path + NATIVE("/") + f.name, f.name);
             }
         }
+        record_access(*dir.parent_system, access_type::directory_listing, dir.relative_path, extension);
+        for (auto const& f : accumulated_results)
+            record_access(*dir.parent_system, access_type::file_contents, f.absolute_path, NATIVE(""));
     } else {
         const auto appended_path = dir.relative_path;
         DIR* d;
@@ -165,15 +238,10 @@ std::vector<unopened_file> list_files(directory const& dir, native_char const* e
                 // Check if it's a file. Not POSIX standard but included in Linux
                 if (dir_ent->d_type != DT_REG)
                     continue;
-					
-				// Check if the file is of the right extension
-				if (strlen(extension)) {
-					char* dot = strrchr(dir_ent->d_name, '.');
-					if(!dot || dot == dir_ent->d_name)
-						continue;
-					if (strcmp(dot, extension))
-						continue;
-				}
+
+                // Check if the file is of the right extension
+                if (!has_extension(dir_ent->d_name, extension))
+                    continue;
 
                 accumulated_results.emplace_back(dir.relative_path + NATIVE("/") + dir_ent->d_name, dir_ent->d_name);
             }
@@ -185,30 +253,11 @@ std::vector<unopened_file> list_files(directory const& dir, native_char const* e
 std::vector<directory> list_subdirectories(directory const& dir) {
     std::vector<directory> accumulated_results;
     if (dir.parent_system) {
-        for (size_t i = dir.parent_system->ordered_roots.size(); i-- > 0;) {
-            const auto appended_path = dir.parent_system->ordered_roots[i] + dir.relative_path;
-            DIR* d;
-            struct dirent* dir_ent;
-            d = opendir(appended_path.c_str());
-            if (d) {
-                while ((dir_ent = readdir(d)) != nullptr) {
-                    // Check if it's a directory. Not POSIX standard but included in Linux
-                    if (dir_ent->d_type != DT_DIR)
-                        continue;
-
-                    native_string const rel_name = dir.relative_path + NATIVE("/") + dir_ent->d_name;
-                    if (dir_ent->d_name[0] != NATIVE('.')) {
-                        auto search_result = std::find_if(accumulated_results.begin(), accumulated_results.end(), [&rel_name](const auto& s) {
-                            return s.relative_path.compare(rel_name) == 0;
-                        });
-                        if (search_result == accumulated_results.end()) {
-                            accumulated_results.emplace_back(dir.parent_system, rel_name);
-                        }
-                    }
-                }
-                closedir(d);
-            }
+        auto const& overlay = find_overlay_directory(*dir.parent_system, dir.relative_path);
+        for (auto const& name : overlay.subdirectories) {
+            accumulated_results.emplace_back(dir.parent_system, dir.relative_path + NATIVE("/") + name);
         }
+        record_access(*dir.parent_system, access_type::subdirectory_listing, dir.relative_path, NATIVE(""));
     } else {
         const auto appended_path = dir.relative_path;
         DIR* d;
@@ -237,11 +286,12 @@ directory open_directory(directory const& dir, native_string_view directory_name
 
 std::optional<file> open_file(directory const& dir, native_string_view file_name) {
     if (dir.parent_system) {
-        for (size_t i = dir.parent_system->ordered_roots.size(); i-- > 0;) {
-            native_string full_path = dir.parent_system->ordered_roots[i] + dir.relative_path + NATIVE('/') + native_string(file_name);
-            int file_descriptor = open(full_path.c_str(), O_RDONLY | O_NONBLOCK);
+        record_access(*dir.parent_system, access_type::file_resolution, dir.relative_path, file_name);
+        if (auto full_path = resolve_file(dir, file_name); full_path) {
+            int file_descriptor = open(full_path->c_str(), O_RDONLY | O_NONBLOCK);
             if (file_descriptor != -1) {
-                return std::optional<file>(file(file_descriptor, full_path));
+                record_access(*dir.parent_system, access_type::file_contents, *full_path, NATIVE(""));
+                return std::optional<file>(file(file_descriptor, *full_path));
             }
         }
     } else {
@@ -256,13 +306,9 @@ std::optional<file> open_file(directory const& dir, native_string_view file_name
 
 std::optional<unopened_file> peek_file(directory const& dir, native_string_view file_name) {
     if (dir.parent_system) {
-        for (size_t i = dir.parent_system->ordered_roots.size(); i-- > 0;) {
-            native_string full_path = dir.parent_system->ordered_roots[i] + dir.relative_path + NATIVE('/') + native_string(file_name);
-            struct stat stat_buf;
-            int result = stat(full_path.c_str(), &stat_buf);
-            if (result != -1 && S_ISREG(stat_buf.st_mode)) {
-                return std::optional<unopened_file>(unopened_file(full_path, file_name));
-            }
+        record_access(*dir.parent_system, access_type::file_resolution, dir.relative_path, file_name);
+        if (auto full_path = resolve_file(dir, file_name); full_path) {
+            return std::optional<unopened_file>(unopened_file(*full_path, file_name));
         }
     } else {
         native_string full_path = dir.relative_path + NATIVE('/') + native_string(file_name);
@@ -336,6 +382,13 @@ directory get_or_create_settings_directory() {
     return directory(nullptr, path);
 }
 
+directory get_or_create_cache_directory() {
+    native_string path = native_string(getenv("HOME")) + "/.local/share/Alice/cache/";
+    make_directories(path);
+
+    return directory(nullptr, path);
+}
+
 directory get_or_create_save_game_directory() {
     native_string path = native_string(getenv("HOME")) + "/.local/share/Alice/saves/";
     make_directories(path);
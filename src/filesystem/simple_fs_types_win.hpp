@@ -18,6 +18,15 @@ namespace simple_fs {
 	class file_system {
 		std::vector<native_string> ordered_roots;
 
+		mutable std::mutex access_record_lock;
+		mutable std::vector<recorded_access> recorded_accesses;
+		std::atomic<bool> recording_accesses = false;
+
+		// directories are scanned once, the first time they are touched through the roots, and are then answered
+		// from memory until the roots change
+		mutable std::mutex overlay_lock;
+		mutable ankerl::unordered_dense::map<native_string, std::unique_ptr<overlay_directory>> overlay_directories;
+
 		void operator=(file_system const& other) = delete;
 		void operator=(file_system&& other) = delete;
 	public:
@@ -33,6 +42,12 @@ namespace simple_fs {
 		friend std::vector<directory> list_subdirectories(directory const& dir);
 		friend std::vector<unopened_file> list_files(directory const& dir, native_char const* extension);
 		friend std::optional<unopened_file> peek_file(directory const& dir, native_string_view file_name);
+		friend void start_recording_accesses(file_system& fs);
+		friend std::vector<recorded_access> stop_recording_accesses(file_system& fs);
+		friend void record_access(file_system const& fs, access_type type, native_string_view first, native_string_view second);
+		friend overlay_directory const& find_overlay_directory(file_system const& fs, native_string const& relative_path);
+		friend void clear_overlay(file_system& fs);
+		friend std::optional<native_string> resolve_file(directory const& dir, native_string_view file_name);
 	};
 
 
@@ -50,6 +65,7 @@ namespace simple_fs {
 		friend std::optional<unopened_file> peek_file(directory const& dir, native_string_view file_name);
 		friend void write_file(directory const& dir, native_string_view file_name, char const* file_data, uint32_t file_size);
 		friend directory open_directory(directory const& dir, native_string_view directory_name);
+		friend std::optional<native_string> resolve_file(directory const& dir, native_string_view file_name);
 		friend native_string get_full_name(directory const& f);
 	};
 
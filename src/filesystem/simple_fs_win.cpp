@@ -79,12 +79,19 @@ namespace simple_fs {
 		return result;
 	}
 
+	void clear_overlay(file_system& fs) {
+		std::lock_guard lock(fs.overlay_lock);
+		fs.overlay_directories.clear();
+	}
+
 	void reset(file_system& fs) {
 		fs.ordered_roots.clear();
+		clear_overlay(fs);
 	}
 
 	void add_root(file_system& fs, native_string_view root_path) {
 		fs.ordered_roots.emplace_back(root_path);
+		clear_overlay(fs);
 	}
 
 	void add_relative_root(file_system& fs, native_string_view root_path) {
@@ -96,6 +103,7 @@ namespace simple_fs {
 		}
 
 		fs.ordered_roots.push_back(native_string(module_name) + native_string(root_path));
+		clear_overlay(fs);
 	}
 
 	directory get_root(file_system const& fs) {
@@ -120,29 +128,110 @@ namespace simple_fs {
 			fs.ordered_roots.emplace_back(position, next_semicolon);
 			position = next_semicolon + 1;
 		}
+		clear_overlay(fs);
+	}
+
+	void start_recording_accesses(file_system& fs) {
+		std::lock_guard lock(fs.access_record_lock);
+		fs.recorded_accesses.clear();
+		fs.recording_accesses.store(true, std::memory_order::release);
+	}
+	std::vector<recorded_access> stop_recording_accesses(file_system& fs) {
+		std::lock_guard lock(fs.access_record_lock);
+		fs.recording_accesses.store(false, std::memory_order::release);
+		return std::move(fs.recorded_accesses);
+	}
+	void record_access(file_system const& fs, access_type type, native_string_view first, native_string_view second) {
+		if(!fs.recording_accesses.load(std::memory_order::acquire))
+			return;
+		std::lock_guard lock(fs.access_record_lock);
+		fs.recorded_accesses.push_back(recorded_access{ type, native_string(first), native_string(second) });
+	}
+
+	// names are compared the way that the file system compares them: case insensitively and with either separator
+	native_string normalize_name(native_string_view name) {
+		native_string result(name);
+		for(auto& ch : result) {
+			if(ch == NATIVE('/'))
+				ch = NATIVE('\\');
+			else
+				ch = native_char(towlower(ch));
+		}
+		return result;
+	}
+
+	bool has_extension(native_string const& name, native_char const* extension) {
+		auto extension_length = wcslen(extension);
+		if(extension_length == 0)
+			return true;
+		if(name.length() < extension_length)
+			return false;
+		return _wcsicmp(name.c_str() + (name.length() - extension_length), extension) == 0;
+	}
+
+	overlay_directory const& find_overlay_directory(file_system const& fs, native_string const& relative_path) {
+		auto key = normalize_name(relative_path);
+		std::lock_guard lock(fs.overlay_lock);
+		if(auto it = fs.overlay_directories.find(key); it != fs.overlay_directories.end())
+			return *(it->second);
+
+		auto result = std::make_unique<overlay_directory>();
+		ankerl::unordered_dense::set<native_string> seen_directories;
+		for(size_t i = fs.ordered_roots.size(); i-- > 0; ) {
+			const auto appended_path = fs.ordered_roots[i] + relative_path + NATIVE("\\*");
+			WIN32_FIND_DATAW find_result;
+			auto find_handle = FindFirstFileW(appended_path.c_str(), &find_result);
+			if(find_handle == INVALID_HANDLE_VALUE)
+				continue;
+			do {
+				auto normalized = normalize_name(find_result.cFileName);
+				if(!(find_result.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+					if(result->file_lookup.find(normalized) == result->file_lookup.end()) {
+						result->file_lookup.insert_or_assign(std::move(normalized), uint32_t(result->files.size()));
+						result->files.push_back(overlay_file{ native_string(find_result.cFileName), uint32_t(i) });
+					}
+				} else if(find_result.cFileName[0] != NATIVE('.')) {
+					if(seen_directories.insert(std::move(normalized)).second) {
+						result->subdirectories.emplace_back(find_result.cFileName);
+					}
+				}
+			} while(FindNextFileW(find_handle, &find_result) != 0);
+			FindClose(find_handle);
+		}
+		auto& stored = fs.overlay_directories.insert_or_assign(std::move(key), std::move(result)).first->second;
+		return *stored;
+	}
+
+	// finds which root, if any, provides a file that is named relative to a directory
+	// the file name may itself contain directories, in which case the directory that holds it is looked up instead
+	std::optional<native_string> resolve_file(directory const& dir, native_string_view file_name) {
+		native_string directory_path = dir.relative_path;
+		native_string_view leaf_name = file_name;
+		if(auto last_separator = file_name.find_last_of(NATIVE("\\/")); last_separator != native_string_view::npos) {
+			directory_path += NATIVE('\\');
+			directory_path += file_name.substr(0, last_separator);
+			leaf_name = file_name.substr(last_separator + 1);
+		}
+
+		auto const& overlay = find_overlay_directory(*dir.parent_system, directory_path);
+		if(auto it = overlay.file_lookup.find(normalize_name(leaf_name)); it != overlay.file_lookup.end()) {
+			return dir.parent_system->ordered_roots[overlay.files[it->second].root] + dir.relative_path + NATIVE('\\') + native_string(file_name);
+		}
+		return std::optional<native_string>{};
 	}
 
 	std::vector<unopened_file> list_files(directory const& dir, native_char const* extension) {
 		std::vector<unopened_file> accumulated_results;
 		if(dir.parent_system) {
-			for(size_t i = dir.parent_system->ordered_roots.size(); i-- > 0; ) {
-				const auto appended_path = dir.parent_system->ordered_roots[i] + dir.relative_path + NATIVE("\\*") + extension;
-				WIN32_FIND_DATAW find_result;
-				auto find_handle = FindFirstFileW(appended_path.c_str(), &find_result);
-				if(find_handle != INVALID_HANDLE_VALUE) {
-					do {
-						if(!(find_result.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
-							if(auto search_result = std::find_if(accumulated_results.begin(), accumulated_results.end(), [n = find_result.cFileName](const auto& f) {
-								return f.file_name.compare(n) == 0;
-								}); search_result == accumulated_results.end()) {
-
-								accumulated_results.emplace_back(dir.parent_system->ordered_roots[i] + dir.relative_path + NATIVE("\\") + find_result.cFileName, find_result.cFileName);
-							}
-						}
-					} while(FindNextFileW(find_handle, &find_result) != 0);
-					FindClose(find_handle);
+			auto const& overlay = find_overlay_directory(*dir.parent_system, dir.relative_path);
+			for(auto const& f : overlay.files) {
+				if(has_extension(f.name, extension)) {
+					accumulated_results.emplace_back(dir.parent_system->ordered_roots[f.root] + dir.relative_path + NATIVE("\\") + f.name, f.name);
 				}
 			}
+			record_access(*dir.parent_system, access_type::directory_listing, dir.relative_path, extension);
+			for(auto const& f : accumulated_results)
+				record_access(*dir.parent_system, access_type::file_contents, f.absolute_path, NATIVE(""));
 		} else {
 			const auto appended_path = dir.relative_path + NATIVE("\\*") + extension;
 			WIN32_FIND_DATAW find_result;
@@ -162,26 +251,11 @@ namespace simple_fs {
 	std::vector<directory> list_subdirectories(directory const& dir) {
 		std::vector<directory> accumulated_results;
 		if(dir.parent_system) {
-			for(size_t i = dir.parent_system->ordered_roots.size(); i-- > 0; ) {
-				const auto appended_path = dir.parent_system->ordered_roots[i] + dir.relative_path + NATIVE("\\*");
-				WIN32_FIND_DATAW find_result;
-				auto find_handle = FindFirstFileW(appended_path.c_str(), &find_result);
-				if(find_handle != INVALID_HANDLE_VALUE) {
-					do {
-						if(find_result.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
-							native_string const rel_name = dir.relative_path + NATIVE("\\") + find_result.cFileName;
-							if(find_result.cFileName[0] != NATIVE('.')
-								&& std::find_if(accumulated_results.begin(), accumulated_results.end(),
-									[&rel_name](const auto& s) {
-										return s.relative_path.compare(rel_name) == 0;
-									}) == accumulated_results.end()) {
-								accumulated_results.emplace_back(dir.parent_system, rel_name);
-							}
-						}
-					} while(FindNextFileW(find_handle, &find_result) != 0);
-					FindClose(find_handle);
-				}
+			auto const& overlay = find_overlay_directory(*dir.parent_system, dir.relative_path);
+			for(auto const& name : overlay.subdirectories) {
+				accumulated_results.emplace_back(dir.parent_system, dir.relative_path + NATIVE("\\") + name);
 			}
+			record_access(*dir.parent_system, access_type::subdirectory_listing, dir.relative_path, NATIVE(""));
 		} else {
 			const auto appended_path = dir.relative_path + NATIVE("\\*");
 			WIN32_FIND_DATAW find_result;
@@ -211,11 +285,12 @@ namespace simple_fs {
 
 	std::optional<file> open_file(directory const& dir, native_string_view file_name) {
 		if(dir.parent_system) {
-			for(size_t i = dir.parent_system->ordered_roots.size(); i-- > 0; ) {
-				native_string full_path = dir.parent_system->ordered_roots[i] + dir.relative_path + NATIVE('\\') + native_string(file_name);
-				HANDLE file_handle = CreateFileW(full_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			record_access(*dir.parent_system, access_type::file_resolution, dir.relative_path, file_name);
+			if(auto full_path = resolve_file(dir, file_name); full_path) {
+				HANDLE file_handle = CreateFileW(full_path->c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
 				if(file_handle != INVALID_HANDLE_VALUE) {
-					return std::optional<file>(file(file_handle, full_path));
+					record_access(*dir.parent_system, access_type::file_contents, *full_path, NATIVE(""));
+					return std::optional<file>(file(file_handle, *full_path));
 				}
 			}
 		} else {
@@ -230,12 +305,9 @@ namespace simple_fs {
 
 	std::optional<unopened_file> peek_file(directory const& dir, native_string_view file_name) {
 		if(dir.parent_system) {
-			for(size_t i = dir.parent_system->ordered_roots.size(); i-- > 0; ) {
-				native_string full_path = dir.parent_system->ordered_roots[i] + dir.relative_path + NATIVE('\\') + native_string(file_name);
-				DWORD dwAttrib = GetFileAttributesW(full_path.c_str());
-				if(dwAttrib != INVALID_FILE_ATTRIBUTES && !(dwAttrib & FILE_ATTRIBUTE_DIRECTORY)) {
-					return std::optional<unopened_file>(unopened_file(full_path, file_name));
-				}
+			record_access(*dir.parent_system, access_type::file_resolution, dir.relative_path, file_name);
+			if(auto full_path = resolve_file(dir, file_name); full_path) {
+				return std::optional<unopened_file>(unopened_file(*full_path, file_name));
 			}
 		} else {
 			native_string full_path = dir.relative_path + NATIVE('\\') + native_string(file_name);
@@ -286,6 +358,21 @@ namespace simple_fs {
 		return directory(nullptr, base_path);
 	}
 
+	directory get_or_create_cache_directory() {
+		wchar_t* local_path_out = nullptr;
+		std::wstring base_path;
+		if(SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &local_path_out) == S_OK) {
+			base_path = std::wstring(local_path_out) + L"\\Project Alice";
+		}
+		CoTaskMemFree(local_path_out);
+		if(base_path.length() > 0) {
+			CreateDirectoryW(base_path.c_str(), nullptr);
+			base_path += NATIVE("\\cache");
+			CreateDirectoryW(base_path.c_str(), nullptr);
+		}
+		return directory(nullptr, base_path);
+	}
+
 	directory get_or_create_save_game_directory() {
 		wchar_t* local_path_out = nullptr;
 		std::wstring base_path;
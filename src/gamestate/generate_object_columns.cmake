@@ -0,0 +1,106 @@
+# Writes a header of X-macros listing the properties of one object in the container definition, and the relationships it
+# takes part in, so that code which has to touch every column of that object (such as the pop sort in province.cpp) follows
+# the definition file instead of a hand-maintained list.
+#
+# usage: cmake -DINPUT=<definition .txt> -DOBJECT=<object name> -DOUTPUT=<header> -P generate_object_columns.cmake
+#
+# The generated header defines:
+#   DCON_<OBJECT>_PROPERTIES(SCALAR, ARRAY)  SCALAR(name) for each plain property, ARRAY(name, index_type) for each array
+#   DCON_<OBJECT>_UNIQUE_RELATIONSHIPS(X)    X(relationship, other_link) where the object is the first, unique link
+#   DCON_<OBJECT>_MANY_RELATIONSHIPS(X)      X(relationship, link) where the object is a non-unique link
+
+if(NOT INPUT OR NOT OBJECT OR NOT OUTPUT)
+	message(FATAL_ERROR "generate_object_columns.cmake requires INPUT, OBJECT, and OUTPUT")
+endif()
+
+file(READ ${INPUT} definitions)
+string(REGEX REPLACE "[ \t\r\n]+" "" definitions "${definitions}")
+string(TOUPPER ${OBJECT} object_upper)
+
+# the object itself: everything from its opening up to the next top level declaration
+string(FIND "${definitions}" "object{name{${OBJECT}}" object_start)
+if(object_start EQUAL -1)
+	message(FATAL_ERROR "object ${OBJECT} not found in ${INPUT}")
+endif()
+string(SUBSTRING "${definitions}" ${object_start} -1 object_text)
+string(SUBSTRING "${object_text}" 1 -1 object_rest)
+foreach(next_declaration "}object{" "}relationship{")
+	string(FIND "${object_rest}" "${next_declaration}" declaration_end)
+	if(NOT declaration_end EQUAL -1)
+		string(SUBSTRING "${object_rest}" 0 ${declaration_end} object_rest)
+	endif()
+endforeach()
+
+set(property_lines "")
+string(REGEX MATCHALL "property{name{[A-Za-z0-9_]+}type{[^}]*(}{[^}]*)?}" properties "${object_rest}")
+string(REGEX MATCHALL "property{" property_openings "${object_rest}")
+list(LENGTH properties property_count)
+list(LENGTH property_openings property_opening_count)
+if(NOT property_count EQUAL property_opening_count)
+	message(FATAL_ERROR "${OBJECT}: every property must start with its name followed by its type")
+endif()
+foreach(property ${properties})
+	string(REGEX REPLACE "^property{name{([A-Za-z0-9_]+)}.*$" "\\1" property_name "${property}")
+	if(property MATCHES "type{array{([A-Za-z0-9_]+)}")
+		string(APPEND property_lines "\tARRAY(${property_name}, ${CMAKE_MATCH_1}) \\\n")
+	else()
+		string(APPEND property_lines "\tSCALAR(${property_name}) \\\n")
+	endif()
+endforeach()
+
+# relationships: split the file at each declaration and keep those with a link to the object
+set(unique_lines "")
+set(many_lines "")
+string(REPLACE "relationship{" ";relationship{" relationship_split "${definitions}")
+string(REPLACE "object{name{" ";object{name{" relationship_split "${relationship_split}")
+foreach(declaration ${relationship_split})
+	if(NOT declaration MATCHES "^relationship{name{([A-Za-z0-9_]+)}")
+		continue()
+	endif()
+	set(relationship_name ${CMAKE_MATCH_1})
+	string(REGEX MATCHALL "link{object{[A-Za-z0-9_]+}name{[A-Za-z0-9_]+}type{[A-Za-z0-9_]+}" links "${declaration}")
+	set(link_index 0)
+	set(object_link "")
+	set(object_link_type "")
+	set(object_link_index -1)
+	set(other_link "")
+	foreach(link ${links})
+		string(REGEX REPLACE "^link{object{([A-Za-z0-9_]+)}name{([A-Za-z0-9_]+)}type{([A-Za-z0-9_]+)}$" "\\1;\\2;\\3" link_parts "${link}")
+		list(GET link_parts 0 link_object)
+		list(GET link_parts 1 link_name)
+		list(GET link_parts 2 link_type)
+		if(link_object STREQUAL OBJECT AND object_link_index EQUAL -1)
+			set(object_link ${link_name})
+			set(object_link_type ${link_type})
+			set(object_link_index ${link_index})
+		elseif(other_link STREQUAL "")
+			set(other_link ${link_name})
+		endif()
+		math(EXPR link_index "${link_index} + 1")
+	endforeach()
+	if(object_link_index EQUAL -1)
+		continue()
+	endif()
+	if(object_link_type STREQUAL "unique")
+		if(NOT object_link_index EQUAL 0 OR NOT link_index EQUAL 2)
+			message(FATAL_ERROR "${relationship_name}: only two-way relationships with ${OBJECT} as the first link are supported")
+		endif()
+		string(APPEND unique_lines "\tX(${relationship_name}, ${other_link}) \\\n")
+	else()
+		string(APPEND many_lines "\tX(${relationship_name}, ${object_link}) \\\n")
+	endif()
+endforeach()
+
+set(header "// generated by generate_object_columns.cmake from ${OBJECT} in dcon_generated.txt -- do not edit\n\n#pragma once\n\n")
+string(APPEND header "#define DCON_${object_upper}_PROPERTIES(SCALAR, ARRAY) \\\n${property_lines}\n")
+string(APPEND header "#define DCON_${object_upper}_UNIQUE_RELATIONSHIPS(X) \\\n${unique_lines}\n")
+string(APPEND header "#define DCON_${object_upper}_MANY_RELATIONSHIPS(X) \\\n${many_lines}\n")
+
+# only touch the output when it changes, so that a definition edit elsewhere does not rebuild everything
+if(EXISTS ${OUTPUT})
+	file(READ ${OUTPUT} previous)
+	if(previous STREQUAL header)
+		return()
+	endif()
+endif()
+file(WRITE ${OUTPUT} "${header}")
@@ -6,6 +6,7 @@
 #define XXH_NAMESPACE ZSTD_
 
 #include "zstd.h"
+#include "xxhash.h"
 
 namespace sys {
 
@@ -82,6 +83,7 @@ uint8_t const* read_scenario_section(uint8_t const* ptr_in, uint8_t const* secti
 		ptr_in = memcpy_deserialize(ptr_in, state.map_display.size_x);
 		ptr_in = memcpy_deserialize(ptr_in, state.map_display.size_y);
 		ptr_in = deserialize(ptr_in, state.map_display.border_vertices);
+		ptr_in = deserialize(ptr_in, state.map_display.border_tiles);
 		ptr_in = deserialize(ptr_in, state.map_display.terrain_id_map);
 		ptr_in = deserialize(ptr_in, state.map_display.province_id_map);
 	}
@@ -221,6 +223,7 @@ uint8_t const* read_scenario_section(uint8_t const* ptr_in, uint8_t const* secti
 	ptr_in = memcpy_deserialize(ptr_in, state.start_date);
 	ptr_in = memcpy_deserialize(ptr_in, state.end_date);
 	ptr_in = deserialize(ptr_in, state.trigger_data);
+	state.trigger_memo.clear();
 	ptr_in = deserialize(ptr_in, state.effect_data);
 	ptr_in = deserialize(ptr_in, state.value_modifier_segments);
 	ptr_in = deserialize(ptr_in, state.value_modifiers);
@@ -248,6 +251,7 @@ uint8_t* write_scenario_section(uint8_t* ptr_in, sys::state& state) {
 		ptr_in = memcpy_serialize(ptr_in, state.map_display.size_x);
 		ptr_in = memcpy_serialize(ptr_in, state.map_display.size_y);
 		ptr_in = serialize(ptr_in, state.map_display.border_vertices);
+		ptr_in = serialize(ptr_in, state.map_display.border_tiles);
 		ptr_in = serialize(ptr_in, state.map_display.terrain_id_map);
 		ptr_in = serialize(ptr_in, state.map_display.province_id_map);
 	}
@@ -414,6 +418,7 @@ size_t sizeof_scenario_section(sys::state& state) {
 		sz += sizeof(state.map_display.size_x);
 		sz += sizeof(state.map_display.size_y);
 		sz += serialize_size(state.map_display.border_vertices);
+		sz += serialize_size(state.map_display.border_tiles);
 		sz += serialize_size(state.map_display.terrain_id_map);
 		sz += serialize_size(state.map_display.province_id_map);
 	}
@@ -650,20 +655,203 @@ size_t sizeof_save_section(sys::state& state) {
 	return sz;
 }
 
-void write_scenario_file(sys::state& state, native_string_view name) {
+namespace {
+
+uint64_t hash_native_string(native_string_view str, uint64_t seed) {
+	return ZSTD_XXH64(str.data(), str.length() * sizeof(native_char), seed);
+}
+
+uint64_t hash_access(simple_fs::file_system const& fs, simple_fs::access_type type, native_string const& first, native_string const& second) {
+	switch(type) {
+		case simple_fs::access_type::file_contents:
+		{
+			auto f = simple_fs::open_file(simple_fs::unopened_file(first, NATIVE("")));
+			if(!f)
+				return 0;
+			auto contents = simple_fs::view_contents(*f);
+			return ZSTD_XXH64(contents.data, contents.file_size, 1);
+		}
+		case simple_fs::access_type::file_resolution:
+		{
+			// which root the file was found in, if any
+			auto f = simple_fs::peek_file(simple_fs::directory(&fs, first), second);
+			if(!f)
+				return 0;
+			return hash_native_string(simple_fs::get_full_name(*f), 2);
+		}
+		case simple_fs::access_type::directory_listing:
+		{
+			auto files = simple_fs::list_files(simple_fs::directory(&fs, first), second.c_str());
+			std::vector<native_string> names;
+			names.reserve(files.size());
+			for(auto const& f : files)
+				names.push_back(simple_fs::get_full_name(f));
+			std::sort(names.begin(), names.end());
+			uint64_t result = 3;
+			for(auto const& n : names)
+				result = hash_native_string(n, result);
+			return result;
+		}
+		case simple_fs::access_type::subdirectory_listing:
+		{
+			auto directories = simple_fs::list_subdirectories(simple_fs::directory(&fs, first));
+			std::vector<native_string> names;
+			names.reserve(directories.size());
+			for(auto const& d : directories)
+				names.push_back(simple_fs::get_full_name(d));
+			std::sort(names.begin(), names.end());
+			uint64_t result = 4;
+			for(auto const& n : names)
+				result = hash_native_string(n, result);
+			return result;
+		}
+	}
+	return 0;
+}
+
+size_t sizeof_manifest(std::vector<scenario_manifest_entry> const& manifest) {
+	size_t sz = sizeof(uint32_t);
+	for(auto const& e : manifest) {
+		sz += sizeof(uint8_t) + sizeof(uint64_t) + sizeof(uint32_t) * 2;
+		sz += (e.first.length() + e.second.length()) * sizeof(native_char);
+	}
+	return sz;
+}
+
+uint8_t* write_native_string(uint8_t* ptr_in, native_string const& str) {
+	uint32_t length = uint32_t(str.length());
+	memcpy(ptr_in, &length, sizeof(uint32_t));
+	memcpy(ptr_in + sizeof(uint32_t), str.data(), length * sizeof(native_char));
+	return ptr_in + sizeof(uint32_t) + length * sizeof(native_char);
+}
+
+uint8_t const* read_native_string(uint8_t const* ptr_in, uint8_t const* end, native_string& str) {
+	uint32_t length = 0;
+	if(end - ptr_in < ptrdiff_t(sizeof(uint32_t)))
+		return nullptr;
+	memcpy(&length, ptr_in, sizeof(uint32_t));
+	ptr_in += sizeof(uint32_t);
+	if(uint64_t(end - ptr_in) < uint64_t(length) * sizeof(native_char))
+		return nullptr;
+	str.resize(length);
+	memcpy(str.data(), ptr_in, length * sizeof(native_char));
+	return ptr_in + length * sizeof(native_char);
+}
+
+uint8_t* write_manifest(uint8_t* ptr_in, std::vector<scenario_manifest_entry> const& manifest) {
+	uint32_t count = uint32_t(manifest.size());
+	ptr_in = memcpy_serialize(ptr_in, count);
+	for(auto const& e : manifest) {
+		ptr_in = memcpy_serialize(ptr_in, uint8_t(e.type));
+		ptr_in = memcpy_serialize(ptr_in, e.hash);
+		ptr_in = write_native_string(ptr_in, e.first);
+		ptr_in = write_native_string(ptr_in, e.second);
+	}
+	return ptr_in;
+}
+
+// returns nullptr if the manifest is truncated
+uint8_t const* read_manifest(uint8_t const* ptr_in, uint8_t const* end, std::vector<scenario_manifest_entry>& manifest) {
+	uint32_t count = 0;
+	if(end - ptr_in < ptrdiff_t(sizeof(uint32_t)))
+		return nullptr;
+	ptr_in = memcpy_deserialize(ptr_in, count);
+	manifest.clear();
+	for(uint32_t i = 0; i < count; ++i) {
+		if(end - ptr_in < ptrdiff_t(sizeof(uint8_t) + sizeof(uint64_t)))
+			return nullptr;
+		auto& e = manifest.emplace_back();
+		uint8_t type = 0;
+		ptr_in = memcpy_deserialize(ptr_in, type);
+		ptr_in = memcpy_deserialize(ptr_in, e.hash);
+		e.type = simple_fs::access_type(type);
+		ptr_in = read_native_string(ptr_in, end, e.first);
+		if(!ptr_in)
+			return nullptr;
+		ptr_in = read_native_string(ptr_in, end, e.second);
+		if(!ptr_in)
+			return nullptr;
+	}
+	return ptr_in;
+}
+
+// reads the header and manifest; returns nullptr if the file is out of date or was made by a different version
+uint8_t const* read_and_validate_scenario_prefix(simple_fs::file_system const& fs, uint8_t const* buffer_pos, uint8_t const* file_end) {
+	scenario_header header;
+	header.version = 0;
+
+	if(size_t(file_end - buffer_pos) > sizeof_scenario_header(header)) {
+		buffer_pos = read_scenario_header(buffer_pos, header);
+	}
+	if(header.version != sys::scenario_file_version) {
+		return nullptr;
+	}
+
+	std::vector<scenario_manifest_entry> manifest;
+	buffer_pos = read_manifest(buffer_pos, file_end, manifest);
+	if(!buffer_pos || !scenario_manifest_is_current(fs, manifest)) {
+		return nullptr;
+	}
+	return buffer_pos;
+}
+
+} // namespace
+
+std::vector<scenario_manifest_entry> make_scenario_manifest(simple_fs::file_system const& fs, std::vector<simple_fs::recorded_access> accesses) {
+	std::sort(accesses.begin(), accesses.end(), [](simple_fs::recorded_access const& a, simple_fs::recorded_access const& b) {
+		return std::tie(a.type, a.first, a.second) < std::tie(b.type, b.first, b.second);
+	});
+	accesses.erase(std::unique(accesses.begin(), accesses.end(), [](simple_fs::recorded_access const& a, simple_fs::recorded_access const& b) {
+		return a.type == b.type && a.first == b.first && a.second == b.second;
+	}), accesses.end());
+
+	std::vector<scenario_manifest_entry> result(accesses.size());
+	concurrency::parallel_for(size_t(0), accesses.size(), [&](size_t i) {
+		result[i].type = accesses[i].type;
+		result[i].first = std::move(accesses[i].first);
+		result[i].second = std::move(accesses[i].second);
+		result[i].hash = hash_access(fs, result[i].type, result[i].first, result[i].second);
+	});
+	return result;
+}
+
+bool scenario_manifest_is_current(simple_fs::file_system const& fs, std::vector<scenario_manifest_entry> const& manifest) {
+	std::atomic<bool> current = true;
+	concurrency::parallel_for(size_t(0), manifest.size(), [&](size_t i) {
+		if(!current.load(std::memory_order::relaxed))
+			return;
+		auto const& e = manifest[i];
+		if(hash_access(fs, e.type, e.first, e.second) != e.hash)
+			current.store(false, std::memory_order::relaxed);
+	});
+	return current.load();
+}
+
+native_string scenario_file_name(simple_fs::file_system const& fs) {
+	auto roots_hash = hash_native_string(simple_fs::extract_state(fs), 0);
+	native_string result = NATIVE("scenario_");
+	for(int32_t i = 60; i >= 0; i -= 4) {
+		result += native_char("0123456789abcdef"[(roots_hash >> i) & 0xF]);
+	}
+	result += NATIVE(".bin");
+	return result;
+}
+
+void write_scenario_file(sys::state& state, native_string_view name, std::vector<scenario_manifest_entry> const& manifest) {
 	scenario_header header;
 
 	size_t scenario_space = sizeof_scenario_section(state);
 	size_t save_space = sizeof_save_section(state);
 
 	// this is an upper bound, since compacting the data may require less space
-	size_t total_size = sizeof_scenario_header(header) + ZSTD_compressBound(scenario_space) + ZSTD_compressBound(save_space)
-		+ sizeof(uint32_t) * 4;
+	size_t total_size = sizeof_scenario_header(header) + sizeof_manifest(manifest) + ZSTD_compressBound(scenario_space)
+		+ ZSTD_compressBound(save_space) + sizeof(uint32_t) * 4;
 
 	uint8_t* temp_buffer = new uint8_t[total_size];
 	uint8_t* buffer_position = temp_buffer;
 
 	buffer_position = write_scenario_header(buffer_position, header);
+	buffer_position = write_manifest(buffer_position, manifest);
 
 
 	uint8_t* temp_scenario_buffer = new uint8_t[scenario_space];
@@ -690,18 +878,12 @@ bool try_read_scenario_file(sys::state& state, native_string_view name) {
 	auto dir = simple_fs::get_or_create_scenario_directory();
 	auto save_file = open_file(dir, name);
 	if(save_file) {
-		scenario_header header;
-		header.version = 0;
-
 		auto contents = simple_fs::view_contents(*save_file);
 		uint8_t const* buffer_pos = reinterpret_cast<uint8_t const*>(contents.data);
 		auto file_end = buffer_pos + contents.file_size;
 
-		if(contents.file_size > sizeof_scenario_header(header)) {
-			buffer_pos = read_scenario_header(buffer_pos, header);
-		}
-
-		if(header.version != sys::scenario_file_version) {
+		buffer_pos = read_and_validate_scenario_prefix(state.common_fs, buffer_pos, file_end);
+		if(!buffer_pos) {
 			return false;
 		}
 
@@ -719,18 +901,12 @@ bool try_read_scenario_and_save_file(sys::state& state, native_string_view name)
 	auto dir = simple_fs::get_or_create_scenario_directory();
 	auto save_file = open_file(dir, name);
 	if(save_file) {
-		scenario_header header;
-		header.version = 0;
-
 		auto contents = simple_fs::view_contents(*save_file);
 		uint8_t const* buffer_pos = reinterpret_cast<uint8_t const*>(contents.data);
 		auto file_end = buffer_pos + contents.file_size;
 
-		if(contents.file_size > sizeof_scenario_header(header)) {
-			buffer_pos = read_scenario_header(buffer_pos, header);
-		}
-
-		if(header.version != sys::scenario_file_version) {
+		buffer_pos = read_and_validate_scenario_prefix(state.common_fs, buffer_pos, file_end);
+		if(!buffer_pos) {
 			return false;
 		}
 
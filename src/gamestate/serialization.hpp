@@ -102,8 +102,12 @@ uint8_t const* deserialize(uint8_t const* ptr_in, ankerl::unordered_dense::map<d
 	return ptr_in + sizeof(uint32_t) + sizeof(vec.values()[0]) * length;
 }
 
-constexpr inline uint32_t save_file_version = 11;
-constexpr inline uint32_t scenario_file_version = 11 + save_file_version;
+#ifdef ALICE_QUANTIZED_POP_DEMOGRAPHICS
+constexpr inline uint32_t save_file_version = 12 | 0x00010000; // saves using the two pop demographics storage modes are not interchangeable
+#else
+constexpr inline uint32_t save_file_version = 12;
+#endif
+constexpr inline uint32_t scenario_file_version = 14 + save_file_version;
 
 
 struct scenario_header {
@@ -123,6 +127,23 @@ size_t sizeof_save_header(save_header const& header_in);
 
 uint8_t* write_compressed_section(uint8_t* ptr_out, uint8_t const* ptr_in, uint32_t uncompressed_size);
 
+// A scenario file is only valid for the exact set of game files that it was built from. While the scenario is being
+// built, the file system records every file it resolves, opens, or lists (see simple_fs::start_recording_accesses);
+// the resulting manifest stores a hash of the outcome of each of those accesses, and is written uncompressed
+// directly after the header so that it can be checked without decompressing the rest of the file.
+struct scenario_manifest_entry {
+	simple_fs::access_type type = simple_fs::access_type::file_contents;
+	uint64_t hash = 0;
+	native_string first;
+	native_string second;
+};
+
+std::vector<scenario_manifest_entry> make_scenario_manifest(simple_fs::file_system const& fs, std::vector<simple_fs::recorded_access> accesses);
+// an empty manifest (a scenario written without recording accesses) is always considered current
+bool scenario_manifest_is_current(simple_fs::file_system const& fs, std::vector<scenario_manifest_entry> const& manifest);
+// each distinct set of roots gets its own scenario file, so that switching between mod sets does not evict the others
+native_string scenario_file_name(simple_fs::file_system const& fs);
+
 // Note: these functions are for read / writing the *uncompressed* data
 uint8_t const* read_scenario_section(uint8_t const* ptr_in, uint8_t const* section_end, sys::state& state);
 uint8_t const* read_save_section(uint8_t const* ptr_in, uint8_t const* section_end, sys::state& state);
@@ -131,7 +152,7 @@ uint8_t* write_save_section(uint8_t* ptr_in, sys::state& state);
 size_t sizeof_scenario_section(sys::state& state);
 size_t sizeof_save_section(sys::state& state);
 
-void write_scenario_file(sys::state& state, native_string_view name);
+void write_scenario_file(sys::state& state, native_string_view name, std::vector<scenario_manifest_entry> const& manifest = {});
 bool try_read_scenario_file(sys::state& state, native_string_view name);
 bool try_read_scenario_and_save_file(sys::state& state, native_string_view name);
 
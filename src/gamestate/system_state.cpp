@@ -21,6 +21,7 @@ namespace sys {
 	//
 
 	void state::on_rbutton_down(int32_t x, int32_t y, key_modifiers mod) {
+		ui::invalidate_mouse_probe(*this); // any of these may move, open, or close windows
 		// Lose focus on text
 		ui_state.edit_target = nullptr;
 		
@@ -36,6 +37,7 @@ namespace sys {
 		map_display.on_mbuttom_down(x, y, x_size, y_size, mod);
 	}
 	void state::on_lbutton_down(int32_t x, int32_t y, key_modifiers mod) {
+		ui::invalidate_mouse_probe(*this);
 		// Lose focus on text
 		ui_state.edit_target = nullptr;
 
@@ -61,6 +63,7 @@ namespace sys {
 		map_display.on_mbuttom_up(x, y, mod);
 	}
 	void state::on_lbutton_up(int32_t x, int32_t y, key_modifiers mod) {
+		ui::invalidate_mouse_probe(*this);
 		is_dragging = false;
 		if(ui_state.drag_target) {
 			on_drag_finished(x, y, mod);
@@ -78,6 +81,7 @@ namespace sys {
 		}
 	}
 	void state::on_mouse_drag(int32_t x, int32_t y, key_modifiers mod) { // called when the left button is held down
+		ui::invalidate_mouse_probe(*this);
 		is_dragging = true;
 
 		if(ui_state.drag_target)
@@ -93,12 +97,14 @@ namespace sys {
 		}
 	}
 	void state::on_resize(int32_t x, int32_t y, window_state win_state) {
+		ui::invalidate_mouse_probe(*this);
 		if(win_state != window_state::minimized) {
 			ui_state.root->base_data.size.x = int16_t(x / user_settings.ui_scale);
 			ui_state.root->base_data.size.y = int16_t(y / user_settings.ui_scale);
 		}
 	}
 	void state::on_mouse_wheel(int32_t x, int32_t y, key_modifiers mod, float amount) { // an amount of 1.0 is one "click" of the wheel
+		ui::invalidate_mouse_probe(*this);
 		if(ui_state.under_mouse != nullptr) {
 			auto r = ui_state.under_mouse->impl_on_scroll(*this, ui_state.relative_mouse_location.x, ui_state.relative_mouse_location.y, amount, mod);
 			if(r != ui::message_result::consumed) {
@@ -110,6 +116,7 @@ namespace sys {
 		}
 	}
 	void state::on_key_down(virtual_key keycode, key_modifiers mod) {
+		ui::invalidate_mouse_probe(*this);
 		if(ui_state.edit_target) {
 			ui_state.edit_target->impl_on_key_down(*this, keycode, mod);
 		} else {
@@ -127,15 +134,18 @@ namespace sys {
 		map_display.on_key_up(keycode, mod);
 	}
 	void state::on_text(char c) { // c is win1250 codepage value
+		ui::invalidate_mouse_probe(*this);
 		if(ui_state.edit_target)
 			ui_state.edit_target->on_text(*this, c);
 	}
 	void state::render() { // called to render the frame may (and should) delay returning until the frame is rendered, including waiting for vsync
-		auto game_state_was_updated = game_state_updated.exchange(false, std::memory_order::acq_rel);
+		auto game_state_was_updated = consume_finished_day(ui_day_report);
 		bool tooltip_updated = false;
 
 		if(game_state_was_updated) {
-			ui_state.root->impl_on_update(*this);
+			ui_state.root->impl_on_update(*this, ui_changes);
+			ui_changes.clear();
+			ui::invalidate_mouse_probe(*this);
 			map_mode::update_map_mode(*this);
 			// TODO also need to update any tooltips (which probably exist outside the root container)
 
@@ -156,7 +166,7 @@ namespace sys {
 			}
 		}
 
-		auto mouse_probe = ui_state.root->impl_probe_mouse(*this, int32_t(mouse_x_position / user_settings.ui_scale), int32_t(mouse_y_position / user_settings.ui_scale));
+		auto mouse_probe = ui::cached_probe_mouse(*this, int32_t(mouse_x_position / user_settings.ui_scale), int32_t(mouse_y_position / user_settings.ui_scale));
 
 		if(ui_state.last_tooltip != mouse_probe.under_mouse) {
 			ui_state.last_tooltip = mouse_probe.under_mouse;
@@ -236,6 +246,7 @@ namespace sys {
 		if(ui_state.tooltip->is_visible()) {
 			ui_state.tooltip->impl_render(*this, ui_state.tooltip->base_data.position.x, ui_state.tooltip->base_data.position.y);
 		}
+		ogl::flush_ui_batch(*this);
 	}
 	void state::on_create() {
 		local_player_nation = dcon::nation_id{42};
@@ -387,6 +398,7 @@ namespace sys {
 			user_settings.music_volume = std::clamp(user_settings.music_volume, 0.0f, 1.0f);
 			user_settings.effects_volume = std::clamp(user_settings.effects_volume, 0.0f, 1.0f);
 			user_settings.master_volume = std::clamp(user_settings.master_volume, 0.0f, 1.0f);
+			user_settings.frame_rate_cap = std::clamp(user_settings.frame_rate_cap, 0, 1000);
 		}
 	}
 
@@ -422,7 +434,7 @@ namespace sys {
 			auto name_id = text::find_or_add_key(context.state, utf8typename);
 			auto type_id = state.world.create_pop_type();
 			state.world.pop_type_set_name(type_id, name_id);
-			context.map_of_poptypes.insert_or_assign(std::string(utf8typename), type_id);
+			context.map_of_poptypes.insert_or_assign(context.key_storage.store(utf8typename), type_id);
 		}
 	}
 
@@ -1007,9 +1019,9 @@ namespace sys {
 		{
 			auto poptypes = open_directory(root, NATIVE("poptypes"));
 			for(auto pr : context.map_of_poptypes) {
-				auto opened_file = open_file(poptypes, simple_fs::utf8_to_native(pr.first + ".txt"));
+				auto opened_file = open_file(poptypes, simple_fs::utf8_to_native(std::string(pr.first) + ".txt"));
 				if(opened_file) {
-					err.file_name = pr.first + ".txt";
+					err.file_name = std::string(pr.first) + ".txt";
 					auto content = view_contents(*opened_file);
 					parsers::poptype_context inner_context{context, pr.second};
 					parsers::token_generator gen(content.data, content.data + content.file_size);
@@ -1312,9 +1324,11 @@ namespace sys {
 		nations::generate_initial_state_instances(*this);
 		world.nation_resize_stockpiles(world.commodity_size());
 		world.nation_resize_variables(uint32_t(national_definitions.num_allocated_national_variables));
-		world.pop_resize_demographics(pop_demographics::size(*this));
+		pop_demographics::resize_storage(*this);
 		world.nation_resize_last_production(world.commodity_size());
 		world.state_instance_resize_last_production(world.commodity_size());
+		world.state_instance_resize_last_demand(world.commodity_size());
+		economy::initialize(*this);
 		national_definitions.global_flag_variables.resize((national_definitions.num_allocated_global_flags + 7) / 8, dcon::bitfield_type{0});
 
 		world.for_each_ideology([&](dcon::ideology_id id) {
@@ -1382,6 +1396,10 @@ namespace sys {
 
 		world.province_resize_modifier_values(provincial_mod_offsets::count);
 
+		world.for_each_commodity([&](dcon::commodity_id c) {
+			world.commodity_set_demand_satisfaction(c, 1.0f);
+		});
+
 		world.nation_resize_demographics(demographics::size(*this));
 		world.state_instance_resize_demographics(demographics::size(*this));
 		world.province_resize_demographics(demographics::size(*this));
@@ -1392,8 +1410,9 @@ namespace sys {
 			world.nation_set_adjective(id, world.national_identity_get_adjective(ident));
 			world.nation_set_color(id, world.national_identity_get_color(ident));
 		});
+		map_display.mark_all_provinces_dirty(); // the nation colors may have changed
 
-		nations_by_rank.resize(1000); // TODO: take this value directly from the data container: max number of nations
+		national_rankings_out_of_date = true; // the rank arrays are rebuilt from the data container on the next ranking update
 		crisis_participants.resize(1000);
 
 		world.for_each_issue([&](dcon::issue_id id) {
@@ -1433,6 +1452,8 @@ namespace sys {
 
 		sys::repopulate_modifier_effects(*this);
 		province::update_connected_regions(*this);
+		pop_ranges_out_of_date = true;
+		province::sort_pops_by_location(*this);
 		nations::update_national_rankings(*this);
 
 		military::restore_unsaved_values(*this);
@@ -1455,44 +1476,121 @@ namespace sys {
 		250, // speed 4 -- 0.25 seconds
 	};
 
+	void state::set_game_speed(int32_t speed) {
+		{
+			// the store happens under the lock so that the game loop can't miss it between checking and waiting
+			std::lock_guard lock(game_loop_lock);
+			actual_game_speed.store(speed, std::memory_order::release);
+		}
+		game_loop_wakeup.notify_one();
+	}
+
+	void state::signal_quit() {
+		{
+			std::lock_guard lock(game_loop_lock);
+			quit_signaled.store(true, std::memory_order::release);
+		}
+		game_loop_wakeup.notify_one();
+	}
+
+	bool state::has_finished_day() const {
+		return finished_day_sequence.load(std::memory_order::acquire) != ui_seen_day_sequence;
+	}
+
+	bool state::consume_finished_day(day_report& out) {
+		if(!has_finished_day())
+			return false;
+		std::lock_guard lock(finished_day_lock);
+		out = finished_days[front_day_report];
+		ui_changes.merge(pending_ui_changes);
+		pending_ui_changes.clear();
+		ui_seen_day_sequence = finished_day_sequence.load(std::memory_order::relaxed);
+		return true;
+	}
+
+	void state::single_game_tick() {
+		trigger_memo.begin_tick();
+
+		// do update logic
+		province::update_connected_regions(*this);
+		nations::update_national_rankings(*this);
+
+		current_date += 1;
+		mark_changed(ui::update_domain::date);
+
+		if(current_date.to_ymd(start_date).day == 1) { // monthly cleanup
+			province::sort_pops_by_location(*this);
+			trigger_memo.clear(); // the pops have been renumbered
+		}
+
+		// basic repopulation of demographics derived values
+		demographics::regenerate_from_pop_data(*this);
+
+		// values updates pass 1 (mostly trivial things, can be done in parallel
+		concurrency::parallel_for(0, 2, [&](int32_t index) {
+			switch(index) {
+				case 0:
+					nations::update_administrative_efficiency(*this);
+					break;
+				case 1:
+					nations::update_research_points(*this);
+					break;
+			}
+		});
+		mark_changed(ui::update_domain::nation); // both passes write every nation
+
+		economy::daily_update(*this);
+
+		trigger_memo.end_tick();
+
+		// hand the finished day to the ui
+		auto& back = finished_days[1 - front_day_report];
+		back.date = current_date;
+		back.days_completed = finished_days[front_day_report].days_completed + 1;
+		back.trigger_memo_hits = trigger_memo.hits.exchange(0, std::memory_order::relaxed);
+		back.trigger_memo_misses = trigger_memo.misses.exchange(0, std::memory_order::relaxed);
+		{
+			std::lock_guard lock(finished_day_lock);
+			pending_ui_changes.merge(tick_changes);
+			front_day_report = 1 - front_day_report;
+			finished_day_sequence.fetch_add(1, std::memory_order::release);
+		}
+		tick_changes.clear();
+	}
+
 	void state::game_loop() {
+		auto speed_or_quit_changed = [&](int32_t speed) {
+			return quit_signaled.load(std::memory_order::acquire) || actual_game_speed.load(std::memory_order::acquire) != speed;
+		};
+
 		while(quit_signaled.load(std::memory_order::acquire) == false) {
 			auto speed = actual_game_speed.load(std::memory_order::acquire);
-			if(speed <= 0 || internally_paused == true) {
-				std::this_thread::sleep_for(std::chrono::milliseconds(15));
-			} else {
-				auto entry_time = std::chrono::steady_clock::now();
-				auto ms_count = std::chrono::duration_cast<std::chrono::milliseconds>(entry_time - last_update).count();
-
-				if(speed >= 5 || ms_count >= game_speed[speed]) { /*enough time has passed*/
-					last_update = entry_time;
-
-					// do update logic
-					province::update_connected_regions(*this);
-					nations::update_national_rankings(*this);
-
-					current_date += 1;
-
-					// basic repopulation of demographics derived values
-					demographics::regenerate_from_pop_data(*this);
-
-					// values updates pass 1 (mostly trivial things, can be done in parallel
-					concurrency::parallel_for(0, 2, [&](int32_t index) {
-						switch(index) {
-							case 0:
-								nations::update_administrative_efficiency(*this);
-								break;
-							case 1:
-								nations::update_research_points(*this);
-								break;
-						}
-						
-					});
-					game_state_updated.store(true, std::memory_order::release);
-				} else {
-					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			if(speed <= 0 || internally_paused.load(std::memory_order::acquire)) {
+				std::unique_lock lock(game_loop_lock);
+				game_loop_wakeup.wait(lock, [&]() {
+					return speed_or_quit_changed(speed) || (speed > 0 && !internally_paused.load(std::memory_order::acquire));
+				});
+				continue;
+			}
+
+			auto tick_time = std::chrono::steady_clock::now();
+			if(speed < 5) {
+				auto interval = std::chrono::milliseconds(game_speed[speed]);
+				auto deadline = last_update + interval;
+				if(tick_time < deadline) {
+					std::unique_lock lock(game_loop_lock);
+					if(game_loop_wakeup.wait_until(lock, deadline, [&]() { return speed_or_quit_changed(speed); }))
+						continue; // recompute the deadline for the new speed
+					tick_time = std::chrono::steady_clock::now();
 				}
+				// schedule from the deadline rather than from when we woke up so that wakeup latency doesn't
+				// accumulate, unless we have fallen more than a whole interval behind (e.g. just unpaused)
+				last_update = (tick_time - deadline < interval) ? deadline : tick_time;
+			} else {
+				last_update = tick_time; // max speed: no waiting between ticks at all
 			}
+
+			single_game_tick();
 		}
 	}
 }
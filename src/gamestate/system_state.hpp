@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include <atomic>
 #include <chrono>
+#include <mutex>
+#include <condition_variable>
 
 #include "constants.hpp"
 #include "dcon_generated.hpp"
@@ -21,6 +23,7 @@
 #include "date_interface.hpp"
 #include "defines.hpp"
 #include "province.hpp"
+#include "triggers.hpp"
 
 // this header will eventually contain the highest-level objects
 // that represent the overall state of the program
@@ -44,7 +47,9 @@ namespace sys {
 		float effects_volume = 1.0f;
 		float interface_volume = 1.0f;
 		bool prefer_fullscreen = false;
-
+		int32_t frame_rate_cap = 0; // frames per second, 0 = uncapped (vsync still applies)
+		bool vsync = true;
+		bool render_on_demand = true; // when nothing has changed, wait for input instead of redrawing the same frame
 	};
 
 	struct global_scenario_data_s { // this struct holds miscellaneous global properties of the scenario
@@ -59,6 +64,14 @@ namespace sys {
 		none = 0, claim = 1, liberation = 2, colonial = 3
 	};
 
+	// what the game loop hands to the ui thread each time it finishes a day
+	struct day_report {
+		sys::date date;
+		uint32_t days_completed = 0; // total number of days completed since the game loop started
+		uint64_t trigger_memo_hits = 0; // memoized trigger lookups during the day that were answered from a table
+		uint64_t trigger_memo_misses = 0;
+	};
+
 	struct alignas(64) state {
 		// the state struct will eventually include (at least pointers to)
 		// the state of the sound system, the state of the windowing system,
@@ -90,15 +103,22 @@ namespace sys {
 		std::vector<uint16_t> effect_data;
 		std::vector<value_modifier_segment> value_modifier_segments;
 		tagged_vector<value_modifier_description, dcon::value_modifier_key> value_modifiers;
+		trigger::memo_state trigger_memo;
 
 		std::vector<char> text_data; // stores string data in the win1250 codepage
 		std::vector<text::text_component> text_components;
 		tagged_vector<text::text_sequence, dcon::text_sequence_id> text_sequences;
 		ankerl::unordered_dense::map<dcon::text_key, dcon::text_sequence_id, text::vector_backed_hash, text::vector_backed_eq> key_to_text_sequence;
 
+		province::path_cache province_paths;
+
 		bool adjacency_data_out_of_date = true;
-		bool national_rankings_out_of_date = true;
+		bool pop_ranges_out_of_date = true; // set whenever pops are created, deleted, or moved between provinces
+		bool national_rankings_out_of_date = true; // set whenever nations are created or destroyed
 		std::vector<dcon::nation_id> nations_by_rank;
+		std::vector<dcon::nation_id> nations_by_industrial_score;
+		std::vector<dcon::nation_id> nations_by_military_score;
+		std::vector<dcon::nation_id> nations_by_prestige_score;
 
 		dcon::state_instance_id crisis_state;
 		std::vector<crisis_member_def> crisis_participants;
@@ -134,13 +154,31 @@ namespace sys {
 		text::font_manager font_collection;
 
 		// synchronization data (between main update logic and ui thread)
-		std::atomic<bool> game_state_updated = false; // game state -> ui signal
-		std::atomic<bool> quit_signaled = false; // ui -> game state signal
-		std::atomic<int32_t> actual_game_speed = 0; // ui -> game state message
+		// game state -> ui: the game loop fills in the back report, then swaps it to the front under the lock
+		// a day has finished that the ui has not seen yet whenever finished_day_sequence != ui_seen_day_sequence
+		day_report finished_days[2];
+		uint32_t front_day_report = 0;
+		std::mutex finished_day_lock;
+		std::atomic<uint32_t> finished_day_sequence = 0;
+		uint32_t ui_seen_day_sequence = 0; // only touched by the ui thread
+		day_report ui_day_report; // the most recent report consumed by the ui; only touched by the ui thread
+		// what changed: marked by the game loop while a day runs, moved to pending_ui_changes (under finished_day_lock) when the
+		// day is finished, and taken from there by the ui along with the day report
+		ui::dirty_state tick_changes; // game loop only; change through mark_changed
+		ui::dirty_state pending_ui_changes;
+		ui::dirty_state ui_changes; // ui thread only
+
+		// ui -> game state: change these through set_game_speed / signal_quit so that the game loop is woken up
+		std::atomic<bool> quit_signaled = false;
+		std::atomic<int32_t> actual_game_speed = 0;
+		std::mutex game_loop_lock;
+		std::condition_variable game_loop_wakeup;
 
 		// internal game timer / update logic
 		std::chrono::time_point<std::chrono::steady_clock> last_update = std::chrono::steady_clock::now();
-		bool internally_paused = false; // should NOT be set from the ui context (but may be read)
+		// should NOT be set from the ui context (but may be read); store it while holding game_loop_lock and then notify
+		// game_loop_wakeup, as set_game_speed does, so that the game loop notices when the pause is lifted
+		std::atomic<bool> internally_paused = false;
 
 		// common data for the window
 		int32_t x_size = 0;
@@ -178,6 +216,22 @@ namespace sys {
 		// this function runs the internal logic of the game. It will return *only* after a quit notification is sent to it
 
 		void game_loop();
+		void single_game_tick();
+
+		void set_game_speed(int32_t speed); // ui -> game state
+		void signal_quit(); // ui -> game state
+		// game state only, and not from inside a parallel section: records what the ui will have to refresh
+		void mark_changed(uint32_t domains) {
+			tick_changes.mark(domains);
+		}
+		void mark_changed(dcon::nation_id n) {
+			tick_changes.mark(n);
+		}
+		void mark_changed(dcon::province_id p) {
+			tick_changes.mark(p);
+		}
+		bool has_finished_day() const; // ui thread only
+		bool consume_finished_day(day_report& out); // ui thread only; returns false if no new day has finished since the last call
 
 		// the following function are for interacting with the string pool
 
@@ -12,52 +12,37 @@ namespace ui {
 template<class T>
 class generic_name_text : public simple_text_element_base {
 protected:
-	T obj_id{};
+	context_ref<T> obj_id{this};
 
 public:
 	void on_update(sys::state& state) noexcept override {
-		auto fat_id = dcon::fatten(state.world, obj_id);
+		auto fat_id = dcon::fatten(state.world, obj_id.get());
 		set_text(state, text::get_name_as_string(state, fat_id));
 	}
-
-	message_result set(sys::state& state, Cyto::Any& payload) noexcept override {
-		if(payload.holds_type<T>()) {
-			obj_id = any_cast<T>(payload);
-			on_update(state);
-			return message_result::consumed;
-		} else {
-			return message_result::unseen;
-		}
-	}
 };
 class standard_province_icon : public image_element_base {
 protected:
-	dcon::province_id prov_id{};
+	context_ref<dcon::province_id> prov_id{this};
 
 public:
 	virtual int32_t get_icon_frame(sys::state& state) noexcept {
 		return 0;
 	}
 
-	void on_update(sys::state& state) noexcept override {
-		frame = get_icon_frame(state);
+	void on_create(sys::state& state) noexcept override {
+		image_element_base::on_create(state);
+		set_update_domains(update_domain::province);
 	}
 
-	message_result set(sys::state& state, Cyto::Any& payload) noexcept override {
-		if(payload.holds_type<dcon::province_id>()) {
-			prov_id = any_cast<dcon::province_id>(payload);
-			on_update(state);
-			return message_result::consumed;
-		} else {
-			return message_result::unseen;
-		}
+	void on_update(sys::state& state) noexcept override {
+		frame = get_icon_frame(state);
 	}
 };
 
 class province_rgo_icon : public standard_province_icon {
 public:
 	int32_t get_icon_frame(sys::state& state) noexcept override {
-		auto fat_id = dcon::fatten(state.world, prov_id);
+		auto fat_id = dcon::fatten(state.world, prov_id.get());
 		return fat_id.get_rgo().get_icon();
 	}
 };
@@ -65,7 +50,7 @@ public:
 class province_fort_icon : public standard_province_icon {
 public:
 	int32_t get_icon_frame(sys::state& state) noexcept override {
-		auto fat_id = dcon::fatten(state.world, prov_id);
+		auto fat_id = dcon::fatten(state.world, prov_id.get());
 		return fat_id.get_fort_level();
 	}
 };
@@ -73,7 +58,7 @@ public:
 class province_naval_base_icon : public standard_province_icon {
 public:
 	int32_t get_icon_frame(sys::state& state) noexcept override {
-		auto fat_id = dcon::fatten(state.world, prov_id);
+		auto fat_id = dcon::fatten(state.world, prov_id.get());
 		return fat_id.get_naval_base_level();
 	}
 };
@@ -81,39 +66,34 @@ public:
 class province_railroad_icon : public standard_province_icon {
 public:
 	int32_t get_icon_frame(sys::state& state) noexcept override {
-		auto fat_id = dcon::fatten(state.world, prov_id);
+		auto fat_id = dcon::fatten(state.world, prov_id.get());
 		return fat_id.get_railroad_level();
 	}
 };
 
 class standard_province_text : public simple_text_element_base {
 protected:
-	dcon::province_id province_id{};
+	context_ref<dcon::province_id> province_id{this};
 
 public:
 	virtual std::string get_text(sys::state& state) noexcept {
 		return "";
 	}
 
-	void on_update(sys::state& state) noexcept override {
-		set_text(state, get_text(state));
+	void on_create(sys::state& state) noexcept override {
+		simple_text_element_base::on_create(state);
+		set_update_domains(update_domain::province);
 	}
 
-	message_result set(sys::state& state, Cyto::Any& payload) noexcept override {
-		if(payload.holds_type<dcon::province_id>()) {
-			province_id = any_cast<dcon::province_id>(payload);
-			on_update(state);
-			return message_result::consumed;
-		} else {
-			return message_result::unseen;
-		}
+	void on_update(sys::state& state) noexcept override {
+		set_text(state, get_text(state));
 	}
 };
 
 class province_population_text : public standard_province_text {
 public:
 	virtual std::string get_text(sys::state& state) noexcept {
-		auto total_pop = state.world.province_get_demographics(province_id, demographics::total);
+		auto total_pop = state.world.province_get_demographics(province_id.get(), demographics::total);
 		return text::prettify(int32_t(total_pop));
 	}
 };
@@ -134,6 +114,8 @@ public:
 	message_result set(sys::state& state, Cyto::Any& payload) noexcept override {
 		if(payload.holds_type<dcon::nation_id>()) {
 			nation_id = any_cast<dcon::nation_id>(payload);
+			set_update_domains(update_domain::nation);
+			set_update_target(nation_id);
 			on_update(state);
 			return message_result::consumed;
 		} else {
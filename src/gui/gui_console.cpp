@@ -34,6 +34,14 @@ void ui::console_edit::edit_box_enter(sys::state& state, std::string_view s) noe
     }
     Cyto::Any output = std::string(s);
     parent->impl_get(state, output);
+    if(s == "memo") { // trigger memoization over the last finished day
+        auto const& report = state.ui_day_report;
+        auto lookups = report.trigger_memo_hits + report.trigger_memo_misses;
+        Cyto::Any counts = std::string("trigger memo: ") + std::to_string(report.trigger_memo_hits) + " hits, "
+            + std::to_string(report.trigger_memo_misses) + " misses"
+            + (lookups != 0 ? " (" + std::to_string(report.trigger_memo_hits * 100 / lookups) + "% hits)" : std::string());
+        parent->impl_get(state, counts);
+    }
 }
 
 void ui::console_window::show_toggle(sys::state& state) {
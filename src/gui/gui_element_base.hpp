@@ -1,9 +1,25 @@
 #pragma once
 
+#include <algorithm>
 #include "gui_graphics.hpp"
 
 namespace ui {
 
+template<typename T>
+class context_slot;
+template<typename T>
+class context_ref;
+
+// the untyped side of a context_ref, so that an element can subscribe all of its refs at once
+class context_subscriber {
+public:
+	virtual void subscribe() noexcept = 0;
+};
+
+// one distinct address per context type, used to tell the published slots of an element apart
+template<typename T>
+inline char const context_type_tag = 0;
+
 class element_base {
 public:
 	static constexpr uint8_t is_invisible_mask = 0x01;
@@ -11,6 +27,13 @@ public:
 	element_data base_data;
 	element_base* parent = nullptr;
 	uint8_t flags = 0;
+	uint32_t update_domains = update_domain::all; // what on_update depends on after a tick; narrow it with set_update_domains
+	uint32_t subtree_update_domains = update_domain::none; // union of the update_domains of all descendants
+	// the nation / province that on_update reads, if it reads only one; when set, only changes to it count
+	dcon::nation_id update_nation{};
+	dcon::province_id update_province{};
+	std::vector<std::pair<void const*, void*>> published_contexts; // (context_type_tag<T>, context_slot<T>*) visible to descendants
+	std::vector<context_subscriber*> context_subscribers; // the context_refs held by this element
 
 
 	bool is_visible() const {
@@ -25,6 +48,51 @@ public:
 		} else if(!vis && old_visibility) {
 			on_hide(state);
 		}
+		if(vis != old_visibility)
+			invalidate_mouse_probe(state);
+	}
+	void set_update_domains(uint32_t domains) {
+		update_domains = domains;
+		for(auto p = parent; p; p = p->parent)
+			p->subtree_update_domains |= domains;
+	}
+	void set_update_target(dcon::nation_id n) {
+		update_nation = n;
+	}
+	void set_update_target(dcon::province_id p) {
+		update_province = p;
+	}
+	bool depends_on(dirty_state const& dirty) const {
+		auto domains = update_domains & dirty.domains();
+		if((domains & ~(update_domain::nation | update_domain::province)) != 0)
+			return true;
+		if((domains & update_domain::nation) != 0 && (!update_nation || dirty.changed(update_nation)))
+			return true;
+		if((domains & update_domain::province) != 0 && (!update_province || dirty.changed(update_province)))
+			return true;
+		return false;
+	}
+
+	// makes the slot visible to this element and all of its descendants; the slot must outlive the children
+	template<typename T>
+	void publish_context(context_slot<T>& slot) {
+		published_contexts.emplace_back(&context_type_tag<T>, &slot);
+	}
+	// the nearest slot of the given type published by this element or one of its ancestors
+	template<typename T>
+	context_slot<T>* find_context() const noexcept {
+		for(auto e = this; e; e = e->parent) {
+			for(auto& c : e->published_contexts) {
+				if(c.first == &context_type_tag<T>)
+					return static_cast<context_slot<T>*>(c.second);
+			}
+		}
+		return nullptr;
+	}
+	// called by a context_slot that this element reads from when its value changes
+	virtual void on_context_change(sys::state& state) noexcept {
+		if(is_visible())
+			impl_on_update(state);
 	}
 
 	element_base() { }
@@ -39,7 +107,12 @@ public:
 	virtual message_result impl_on_key_down(sys::state& state, sys::virtual_key key, sys::key_modifiers mods) noexcept;
 	virtual message_result impl_on_scroll(sys::state& state, int32_t x, int32_t y, float amount, sys::key_modifiers mods) noexcept;
 	virtual message_result impl_on_mouse_move(sys::state& state, int32_t x, int32_t y, sys::key_modifiers mods) noexcept;
-	virtual void impl_on_update(sys::state& state) noexcept;
+	virtual void impl_on_update(sys::state& state) noexcept; // updates every visible element
+	virtual void impl_on_update(sys::state& state, dirty_state const& dirty) noexcept; // updates only the elements that depend on what is dirty
+	virtual void impl_subscribe_contexts() noexcept { // called when attached to a parent, for this element and its descendants
+		for(auto s : context_subscribers)
+			s->subscribe();
+	}
 	message_result impl_get(sys::state& state, Cyto::Any& payload) noexcept;
 	virtual message_result impl_set(sys::state& state, Cyto::Any& payload) noexcept;
 	virtual void impl_render(sys::state& state, int32_t x, int32_t y) noexcept;
@@ -109,5 +182,85 @@ public:
 	friend std::unique_ptr<element_base> make_element_by_type(sys::state& state, std::string_view name);
 };
 
-}
+// a typed value (the province, nation, ... a window is showing) published by a window to its descendants,
+// replacing a broadcast of Cyto::Any payloads through impl_set and a search through impl_get on every update
+template<typename T>
+class context_slot {
+	T value{};
+	std::vector<context_ref<T>*> subscribers;
+
+public:
+	context_slot() = default;
+	context_slot(context_slot const&) = delete;
+	context_slot& operator=(context_slot const&) = delete;
+	~context_slot() {
+		for(auto s : subscribers)
+			s->source = nullptr;
+	}
+
+	T const& get() const noexcept {
+		return value;
+	}
+	// notifies only the elements that read this slot, and only when the value actually changes
+	void set(sys::state& state, T v) noexcept {
+		if(v == value)
+			return;
+		value = v;
+		for(size_t i = 0; i < subscribers.size(); ++i) { // an update may add subscribers
+			subscribers[i]->route(value);
+			subscribers[i]->owner->on_context_change(state);
+		}
+	}
+
+	friend class context_ref<T>;
+};
+
+// the reading side of a context_slot, held as a member of the element that reads it;
+// the slot is looked up as soon as the element is attached under the element publishing it (and again on use, until found),
+// so the element hears about changes even if it never reads the value first; after that reading the value is a pointer load
+// a nation or province held by the slot is also made the owner's update target (see element_base::set_update_target)
+// whenever the ref is subscribed or the slot changes
+template<typename T>
+class context_ref : public context_subscriber {
+	element_base* owner = nullptr;
+	context_slot<T>* source = nullptr;
+
+	void route(T const& v) noexcept {
+		if constexpr(std::is_same_v<T, dcon::nation_id> || std::is_same_v<T, dcon::province_id>)
+			owner->set_update_target(v);
+	}
+
+public:
+	explicit context_ref(element_base* owner) : owner(owner) {
+		owner->context_subscribers.push_back(this);
+	}
+	context_ref(context_ref const&) = delete;
+	context_ref& operator=(context_ref const&) = delete;
+	~context_ref() {
+		if(source)
+			source->subscribers.erase(std::find(source->subscribers.begin(), source->subscribers.end(), this));
+	}
 
+	void subscribe() noexcept override {
+		resolve();
+	}
+	// not cached while it fails: elements are created before they are attached to their parent
+	context_slot<T>* resolve() noexcept {
+		if(!source) {
+			source = owner->find_context<T>();
+			if(source) {
+				source->subscribers.push_back(this);
+				route(source->get());
+			}
+		}
+		return source;
+	}
+	T get() noexcept {
+		auto s = resolve();
+		return s ? s->get() : T{};
+	}
+
+	friend class context_slot<T>;
+};
+
+}
@@ -53,6 +53,25 @@ void container_base::impl_on_update(sys::state& state) noexcept {
 	}
 	on_update(state);
 }
+void container_base::impl_on_update(sys::state& state, dirty_state const& dirty) noexcept {
+	auto dirty_domains = dirty.domains();
+	if(((update_domains | subtree_update_domains) & dirty_domains) == 0)
+		return;
+	if((subtree_update_domains & dirty_domains) != 0) {
+		for(auto& c : children) {
+			if(c->is_visible()) {
+				c->impl_on_update(state, dirty);
+			}
+		}
+	}
+	if(depends_on(dirty))
+		on_update(state);
+}
+void container_base::impl_subscribe_contexts() noexcept {
+	element_base::impl_subscribe_contexts();
+	for(auto& c : children)
+		c->impl_subscribe_contexts();
+}
 message_result container_base::impl_set(sys::state& state, Cyto::Any& payload) noexcept {
 	message_result res = message_result::unseen;
 	for(auto& c : children) {
@@ -101,6 +120,9 @@ void container_base::move_child_to_back(element_base* child) noexcept {
 }
 void container_base::add_child_to_front(std::unique_ptr<element_base> child) noexcept {
 	child->parent = this;
+	for(element_base* p = this; p; p = p->parent)
+		p->subtree_update_domains |= child->update_domains | child->subtree_update_domains;
+	child->impl_subscribe_contexts();
 	children.emplace_back(std::move(child));
 	if(children.size() > 1) {
 		std::rotate(children.begin(), children.end() - 1, children.end());
@@ -108,6 +130,9 @@ void container_base::add_child_to_front(std::unique_ptr<element_base> child) noe
 }
 void container_base::add_child_to_back(std::unique_ptr<element_base> child) noexcept {
 	child->parent = this;
+	for(element_base* p = this; p; p = p->parent)
+		p->subtree_update_domains |= child->update_domains | child->subtree_update_domains;
+	child->impl_subscribe_contexts();
 	children.emplace_back(std::move(child));
 }
 element_base* container_base::get_child_by_name(sys::state const& state, std::string_view name) noexcept {
@@ -232,7 +257,7 @@ ogl::color3f get_text_color(text::text_color text_color) {
 
 void button_element_base::set_button_text(sys::state& state, std::string const& new_text) {
 	stored_text = new_text;
-	text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].text_extent(stored_text.c_str(), uint32_t(stored_text.length()), font_size)) / 2.0f;
+	text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].get_layout(stored_text.c_str(), uint32_t(stored_text.length()), font_size).extent) / 2.0f;
 }
 
 void button_element_base::on_create(sys::state& state) noexcept {
@@ -242,7 +267,7 @@ void button_element_base::on_create(sys::state& state) noexcept {
 		font_id = text::font_index_from_font_id(base_data.data.button.font_handle);
 		font_size = text::size_from_font_id(base_data.data.button.font_handle);
 		black_text = text::is_black_from_font_id(base_data.data.button.font_handle);
-		text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].text_extent(stored_text.c_str(), uint32_t(stored_text.length()), font_size)) / 2.0f;
+		text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].get_layout(stored_text.c_str(), uint32_t(stored_text.length()), font_size).extent) / 2.0f;
 	}
 }
 
@@ -365,10 +390,10 @@ void simple_text_element_base::set_text(sys::state& state, std::string const& ne
 		switch(base_data.data.button.get_alignment()) {
 			case alignment::centered:
 			case alignment::justified:
-				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].text_extent(stored_text.c_str(), uint32_t(stored_text.length()), font_size)) / 2.0f;
+				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].get_layout(stored_text.c_str(), uint32_t(stored_text.length()), font_size).extent) / 2.0f;
 				break;
 			case alignment::right:
-				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].text_extent(stored_text.c_str(), uint32_t(stored_text.length()), font_size));
+				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].get_layout(stored_text.c_str(), uint32_t(stored_text.length()), font_size).extent);
 				break;
 			case alignment::left:
 				text_offset = 0.0f;
@@ -379,10 +404,10 @@ void simple_text_element_base::set_text(sys::state& state, std::string const& ne
 		switch(base_data.data.button.get_alignment()) {
 			case alignment::centered:
 			case alignment::justified:
-				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].text_extent(stored_text.c_str(), uint32_t(stored_text.length()), font_size) - base_data.data.text.border_size.x) / 2.0f;
+				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].get_layout(stored_text.c_str(), uint32_t(stored_text.length()), font_size).extent - base_data.data.text.border_size.x) / 2.0f;
 				break;
 			case alignment::right:
-				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].text_extent(stored_text.c_str(), uint32_t(stored_text.length()), font_size) - base_data.data.text.border_size.x);
+				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].get_layout(stored_text.c_str(), uint32_t(stored_text.length()), font_size).extent - base_data.data.text.border_size.x);
 				break;
 			case alignment::left:
 				text_offset = base_data.data.text.border_size.x;
@@ -402,10 +427,10 @@ void simple_text_element_base::on_create(sys::state& state) noexcept {
 		switch(base_data.data.button.get_alignment()) {
 			case alignment::centered:
 			case alignment::justified:
-				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].text_extent(stored_text.c_str(), uint32_t(stored_text.length()), font_size)) / 2.0f;
+				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].get_layout(stored_text.c_str(), uint32_t(stored_text.length()), font_size).extent) / 2.0f;
 				break;
 			case alignment::right:
-				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].text_extent(stored_text.c_str(), uint32_t(stored_text.length()), font_size));
+				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].get_layout(stored_text.c_str(), uint32_t(stored_text.length()), font_size).extent);
 				break;
 			case alignment::left:
 				text_offset = 0.0f;
@@ -423,10 +448,10 @@ void simple_text_element_base::on_create(sys::state& state) noexcept {
 		switch(base_data.data.button.get_alignment()) {
 			case alignment::centered:
 			case alignment::justified:
-				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].text_extent(stored_text.c_str(), uint32_t(stored_text.length()), font_size) - base_data.data.text.border_size.x) / 2.0f;
+				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].get_layout(stored_text.c_str(), uint32_t(stored_text.length()), font_size).extent - base_data.data.text.border_size.x) / 2.0f;
 				break;
 			case alignment::right:
-				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].text_extent(stored_text.c_str(), uint32_t(stored_text.length()), font_size) - base_data.data.text.border_size.x);
+				text_offset = (base_data.size.x - state.font_collection.fonts[font_id - 1].get_layout(stored_text.c_str(), uint32_t(stored_text.length()), font_size).extent - base_data.data.text.border_size.x);
 				break;
 			case alignment::left:
 				text_offset = base_data.data.text.border_size.x;
@@ -765,12 +790,10 @@ void piechart_element_base::render(sys::state& state, int32_t x, int32_t y) noex
 template<class SrcT, class DemoT>
 std::vector<uint8_t> demographic_piechart<SrcT, DemoT>::get_colors(sys::state& state) noexcept {
 	std::vector<uint8_t> colors(resolution * channels);
-	Cyto::Any obj_id = SrcT{};
 	size_t i = 0;
-	if(parent) {
-		parent->impl_get(state, obj_id);
-		if(obj_id.holds_type<dcon::province_id>()) {
-			auto prov_id = any_cast<dcon::province_id>(obj_id);
+	if(source.resolve()) {
+		if constexpr(std::is_same_v<SrcT, dcon::province_id>) {
+			auto prov_id = source.get();
 			dcon::province_fat_id fat_id = dcon::fatten(state.world, prov_id);
 			auto total_pops = state.world.province_get_demographics(prov_id, demographics::total);
 			if(total_pops <= 0) {
@@ -1009,6 +1032,8 @@ void overlapping_flags_box::on_update(sys::state& state) noexcept {
 message_result overlapping_flags_box::set(sys::state& state, Cyto::Any& payload) noexcept {
 	if(payload.holds_type<dcon::nation_id>()) {
 		current_nation = any_cast<dcon::nation_id>(payload);
+		set_update_domains(update_domain::nation);
+		set_update_target(current_nation);
 		populate_flags(state);
 		return message_result::consumed;
 	} else {
@@ -1089,6 +1114,7 @@ dcon::national_identity_id flag_button::get_current_nation(sys::state& state) no
 	if(parent != nullptr) {
 		parent->impl_get(state, payload);
 		auto nation = any_cast<dcon::nation_id>(payload);
+		set_update_target(nation);
 		auto fat_nation = dcon::fatten(state.world, nation);
 		return fat_nation.get_identity_from_identity_holder().id;
 	} else {
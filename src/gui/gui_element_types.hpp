@@ -40,6 +40,8 @@ public:
 	mouse_probe impl_probe_mouse(sys::state& state, int32_t x, int32_t y) noexcept final;
 	message_result impl_on_key_down(sys::state& state, sys::virtual_key key, sys::key_modifiers mods) noexcept final;
 	void impl_on_update(sys::state& state) noexcept final;
+	void impl_on_update(sys::state& state, dirty_state const& dirty) noexcept final;
+	void impl_subscribe_contexts() noexcept final;
 	message_result impl_set(sys::state& state, Cyto::Any& payload) noexcept final;
 	void impl_render(sys::state& state, int32_t x, int32_t y) noexcept override;
 
@@ -381,8 +383,16 @@ public:
 template<class SrcT, class DemoT>
 class demographic_piechart : public piechart_element_base {
 protected:
+	context_ref<SrcT> source{this};
+
 	std::vector<uint8_t> get_colors(sys::state& state) noexcept override;
 	virtual void for_each_demo(sys::state& state, std::function<void(DemoT)> fun) { }
+
+public:
+	void on_create(sys::state& state) noexcept override {
+		piechart_element_base::on_create(state);
+		set_update_domains(std::is_same_v<SrcT, dcon::province_id> ? update_domain::province : update_domain::nation);
+	}
 };
 
 template<class SrcT>
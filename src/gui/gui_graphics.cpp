@@ -164,6 +164,47 @@ message_result element_base::impl_on_mouse_move(sys::state& state, int32_t x, in
 void element_base::impl_on_update(sys::state& state) noexcept {
 	on_update(state);
 }
+void element_base::impl_on_update(sys::state& state, dirty_state const& dirty) noexcept {
+	if(depends_on(dirty))
+		on_update(state);
+}
+
+void dirty_state::merge(dirty_state const& other) {
+	all_of |= other.all_of;
+	if(nations.size() < other.nations.size())
+		nations.resize(other.nations.size(), 0);
+	for(size_t i = 0; i < other.nations.size(); ++i)
+		nations[i] |= other.nations[i];
+	if(provinces.size() < other.provinces.size())
+		provinces.resize(other.provinces.size(), 0);
+	for(size_t i = 0; i < other.provinces.size(); ++i)
+		provinces[i] |= other.provinces[i];
+	any_nation = any_nation || other.any_nation;
+	any_province = any_province || other.any_province;
+}
+void dirty_state::clear() {
+	all_of = update_domain::none;
+	std::fill(nations.begin(), nations.end(), uint8_t(0));
+	std::fill(provinces.begin(), provinces.end(), uint8_t(0));
+	any_nation = false;
+	any_province = false;
+}
+
+void invalidate_mouse_probe(sys::state& state) {
+	++state.ui_state.layout_generation;
+}
+mouse_probe cached_probe_mouse(sys::state& state, int32_t x, int32_t y) {
+	auto& ui = state.ui_state;
+	if(ui.probe_x != x || ui.probe_y != y || ui.probe_generation != ui.layout_generation) {
+		auto probe = ui.root->impl_probe_mouse(state, x, y);
+		ui.probe_x = x;
+		ui.probe_y = y;
+		ui.probe_generation = ui.layout_generation;
+		ui.probe_under_mouse = probe.under_mouse;
+		ui.probe_relative_location = probe.relative_location;
+	}
+	return mouse_probe{ ui.probe_under_mouse, ui.probe_relative_location };
+}
 message_result element_base::impl_get(sys::state& state, Cyto::Any& payload) noexcept {
 	if(auto res = get(state, payload); res != message_result::consumed) {
 		if(parent)
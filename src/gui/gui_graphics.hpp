@@ -342,6 +342,58 @@ namespace ui {
 		dcon::gui_def_id definition;
 	};
 
+	// the parts of the game state that an element's on_update reads; after a tick only elements
+	// depending on something that actually changed (and the containers above them) are updated
+	namespace update_domain {
+	inline constexpr uint32_t none = 0;
+	inline constexpr uint32_t date = 0x0001;
+	inline constexpr uint32_t nation = 0x0002; // per nation values: rankings, research, administration, ...
+	inline constexpr uint32_t province = 0x0004; // per province values, including pops and demographics
+	inline constexpr uint32_t all = 0xFFFFFFFF;
+	}
+
+	// what the game state has changed since the ui last updated
+	// a domain in all_of changed for everything it covers; otherwise only the nations and provinces marked here changed
+	struct dirty_state {
+		uint32_t all_of = update_domain::none;
+		std::vector<uint8_t> nations; // indexed by nation id, nonzero if the nation changed
+		std::vector<uint8_t> provinces; // indexed by province id, nonzero if the province changed
+		bool any_nation = false;
+		bool any_province = false;
+
+		void mark(uint32_t domains) {
+			all_of |= domains;
+		}
+		void mark(dcon::nation_id n) {
+			if(!n)
+				return;
+			if(nations.size() <= size_t(n.index()))
+				nations.resize(n.index() + 1, 0);
+			nations[n.index()] = 1;
+			any_nation = true;
+		}
+		void mark(dcon::province_id p) {
+			if(!p)
+				return;
+			if(provinces.size() <= size_t(p.index()))
+				provinces.resize(p.index() + 1, 0);
+			provinces[p.index()] = 1;
+			any_province = true;
+		}
+		bool changed(dcon::nation_id n) const {
+			return (all_of & update_domain::nation) != 0 || (size_t(n.index()) < nations.size() && nations[n.index()] != 0);
+		}
+		bool changed(dcon::province_id p) const {
+			return (all_of & update_domain::province) != 0 || (size_t(p.index()) < provinces.size() && provinces[p.index()] != 0);
+		}
+		// every domain in which at least something changed
+		uint32_t domains() const {
+			return all_of | (any_nation ? update_domain::nation : 0) | (any_province ? update_domain::province : 0);
+		}
+		void merge(dirty_state const& other);
+		void clear();
+	};
+
 	class tool_tip;
 
 	struct state {
@@ -367,6 +419,14 @@ namespace ui {
 
 		int32_t held_game_speed = 1; // used to keep track of speed while paused
 
+		// the result of the last mouse probe is reused until the mouse moves or layout_generation changes
+		uint32_t layout_generation = 0;
+		uint32_t probe_generation = 0;
+		int32_t probe_x = -1;
+		int32_t probe_y = -1;
+		element_base* probe_under_mouse = nullptr;
+		xy_pair probe_relative_location = xy_pair{ 0, 0 };
+
 		state();
 	};
 
@@ -380,6 +440,9 @@ namespace ui {
 		return +[](sys::state&, dcon::gui_def_id) { return std::make_unique<T>(); };
 	}
 
+	void invalidate_mouse_probe(sys::state& state); // call whenever elements are shown, hidden, moved, added, or removed
+	mouse_probe cached_probe_mouse(sys::state& state, int32_t x, int32_t y);
+
 	void populate_definitions_map(sys::state& state);
 	void make_size_from_graphics(sys::state& state, ui::element_data& dat);
 	std::unique_ptr<element_base> make_element(sys::state& state, std::string_view name);
@@ -21,11 +21,11 @@ public:
 
 class province_terrain_image : public opaque_element_base {
 private:
-	dcon::province_id province_id{};
+	context_ref<dcon::province_id> province_id{this};
 
 public:
 	void on_update(sys::state& state) noexcept override {
-		auto fat_id = dcon::fatten(state.world, province_id);
+		auto fat_id = dcon::fatten(state.world, province_id.get());
 		auto terrain_id = fat_id.get_terrain().id;
 		auto terrain_image = state.province_definitions.terrain_to_gfx_map[terrain_id];
 		if(base_data.get_element_type() == element_type::image) {
@@ -33,23 +33,13 @@ public:
 		}
 	}
 
-	message_result set(sys::state& state, Cyto::Any& payload) noexcept override {
-		if(payload.holds_type<dcon::province_id>()) {
-			province_id = any_cast<dcon::province_id>(payload);
-			on_update(state);
-			return message_result::consumed;
-		} else {
-			return message_result::unseen;
-		}
-	}
-
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
 		return tooltip_behavior::variable_tooltip;
 	}
 
 	void update_tooltip(sys::state& state, text::columnar_layout& contents) noexcept override {
 		// TODO: display terrain modifier values
-		auto fat_id = dcon::fatten(state.world, province_id);
+		auto fat_id = dcon::fatten(state.world, province_id.get());
 		auto name = fat_id.get_terrain().get_name();
 		if(name) {
 			auto box = text::open_layout_box(contents, 0);
@@ -60,6 +50,9 @@ public:
 };
 
 class slave_state_icon : public pop_type_icon {
+private:
+	context_ref<dcon::province_id> province_id{this};
+
 public:
 	void on_create(sys::state& state) noexcept override {
 		pop_type_icon::on_create(state);
@@ -68,15 +61,10 @@ public:
 		update(state);
 	}
 
-	message_result set(sys::state& state, Cyto::Any& payload) noexcept override {
-		if(payload.holds_type<dcon::province_id>()) {
-			auto province_id = any_cast<dcon::province_id>(payload);
-			auto fat_id = dcon::fatten(state.world, province_id);
-			set_visible(state, fat_id.get_is_slave());
-			return message_result::consumed;
-		} else {
-			return message_result::unseen;
-		}
+	// decides its own visibility, so it has to hear about a new province even while hidden
+	void on_context_change(sys::state& state) noexcept override {
+		auto fat_id = dcon::fatten(state.world, province_id.get());
+		set_visible(state, fat_id.get_is_slave());
 	}
 };
 
@@ -94,19 +82,24 @@ class province_flashpoint_indicator : public standard_province_icon {
 public:
 	void on_update(sys::state& state) noexcept override {
 		standard_province_icon::on_update(state);
-		auto fat_id = dcon::fatten(state.world, prov_id);
+		auto fat_id = dcon::fatten(state.world, prov_id.get());
 		auto tension = fat_id.get_state_membership().get_flashpoint_tension();
 		set_visible(state, tension > 0.f);
 	}
+
+	void on_context_change(sys::state& state) noexcept override {
+		on_update(state);
+	}
 };
 
 class province_controller_flag : public flag_button {
 private:
-	dcon::province_id province_id{};
+	context_ref<dcon::province_id> province_id{this};
 
 public:
 	void on_create(sys::state& state) noexcept override {
 		flag_button::on_create(state);
+		set_update_domains(update_domain::province); // the controller changes with occupation
 		flag_size.x = int16_t(float(flag_size.x) / 1.3f);
 		flag_size.y /= 2;
 		flag_position.x += base_data.size.x / 7;
@@ -114,24 +107,18 @@ public:
 	}
 
 	dcon::national_identity_id get_current_nation(sys::state& state) noexcept override {
-		auto fat_id = dcon::fatten(state.world, province_id);
+		auto fat_id = dcon::fatten(state.world, province_id.get());
 		auto controller_id = fat_id.get_province_control_as_province().get_nation();
 		return controller_id.get_identity_from_identity_holder().id;
 	}
-	
-	message_result set(sys::state& state, Cyto::Any& payload) noexcept override {
-		if(payload.holds_type<dcon::province_id>()) {
-			province_id = any_cast<dcon::province_id>(payload);
-			auto nation = get_current_nation(state);
-			if(bool(nation)) {
-				flag_button::set_current_nation(state, get_current_nation(state));
-				set_visible(state, true);
-			} else {
-				set_visible(state, false);
-			}
-			return message_result::consumed;
+
+	void on_context_change(sys::state& state) noexcept override {
+		auto nation = get_current_nation(state);
+		if(bool(nation)) {
+			flag_button::set_current_nation(state, nation);
+			set_visible(state, true);
 		} else {
-			return message_result::unseen;
+			set_visible(state, false);
 		}
 	}
 
@@ -184,16 +171,6 @@ public:
 			return nullptr;
 		}
 	}
-
-	void update_province_info(sys::state& state, dcon::province_id prov_id) {
-		dcon::province_fat_id fat_id = dcon::fatten(state.world, prov_id);
-		auto state_fat_id = fat_id.get_state_from_abstract_state_membership();
-
-		Cyto::Any prov_id_payload = prov_id;
-		Cyto::Any state_id_payload = state_fat_id.id;
-		impl_set(state, prov_id_payload);
-		impl_set(state, state_id_payload);
-	}
 };
 
 class province_send_diplomat_button : public button_element_base {
@@ -209,6 +186,8 @@ public:
 
 class province_core_flags : public overlapping_flags_box {
 private:
+	context_ref<dcon::province_id> province_id{this};
+
 	void populate(sys::state& state, dcon::province_id prov_id) {
 		contents.clear();
 		auto fat_id = dcon::fatten(state.world, prov_id);
@@ -221,39 +200,33 @@ private:
 	}
 
 public:
-	void on_update(sys::state& state) noexcept override {
-		if(parent) {
-			Cyto::Any payload = dcon::province_id{};
-			parent->impl_get(state, payload);
-			populate(state, any_cast<dcon::province_id>(payload));
-		}
+	void on_create(sys::state& state) noexcept override {
+		overlapping_flags_box::on_create(state);
+		set_update_domains(update_domain::province);
 	}
 
-	message_result set(sys::state& state, Cyto::Any& payload) noexcept override {
-		if(payload.holds_type<dcon::province_id>()) {
-			populate(state, any_cast<dcon::province_id>(payload));
-			return message_result::consumed;
-		} else {
-			return message_result::unseen;
-		}
+	void on_update(sys::state& state) noexcept override {
+		populate(state, province_id.get());
 	}
 };
 
 class province_view_foreign_details : public window_element_base {
 private:
 	flag_button* country_flag_button = nullptr;
-	culture_piechart<dcon::province_id>* culture_chart = nullptr;
-	ideology_piechart<dcon::province_id>* ideology_chart = nullptr;
-	workforce_piechart<dcon::province_id>* workforce_chart = nullptr;
-	dcon::nation_id stored_nation{};
-	dcon::province_id stored_province{};
+	context_slot<dcon::nation_id> nation_context;
 
 public:
+	void on_create(sys::state& state) noexcept override {
+		publish_context(nation_context);
+		window_element_base::on_create(state);
+	}
+
 	std::unique_ptr<element_base> make_child(sys::state& state, std::string_view name, dcon::gui_def_id id) noexcept override {
 		if(name == "country_name") {
 			return make_element_by_type<generic_name_text<dcon::nation_id>>(state, id);
 		} else if(name == "country_flag") {
 			auto ptr = make_element_by_type<flag_button>(state, id);
+			ptr->set_update_domains(update_domain::nation);
 			country_flag_button = ptr.get();
 			return ptr;
 		} else if(name == "country_gov") {
@@ -277,17 +250,11 @@ public:
 		} else if(name == "our_relation") {
 			return make_element_by_type<nation_player_relations_text>(state, id);
 		} else if(name == "workforce_chart") {
-			auto ptr = make_element_by_type<workforce_piechart<dcon::province_id>>(state, id);
-			workforce_chart = ptr.get();
-			return ptr;
+			return make_element_by_type<workforce_piechart<dcon::province_id>>(state, id);
 		} else if(name == "ideology_chart") {
-			auto ptr = make_element_by_type<ideology_piechart<dcon::province_id>>(state, id);
-			ideology_chart = ptr.get();
-			return ptr;
+			return make_element_by_type<ideology_piechart<dcon::province_id>>(state, id);
 		}  else if(name == "culture_chart") {
-			auto ptr = make_element_by_type<culture_piechart<dcon::province_id>>(state, id);
-			culture_chart = ptr.get();
-			return ptr;
+			return make_element_by_type<culture_piechart<dcon::province_id>>(state, id);
 		} else if(name == "goods_type") {
 			return make_element_by_type<province_rgo_icon>(state, id);
 		} else if(name == "build_icon_fort") {
@@ -326,33 +293,23 @@ public:
 	}
 
     void update_province_info(sys::state& state, dcon::province_id prov_id) {
-		stored_province = prov_id;
 		dcon::province_fat_id fat_id = dcon::fatten(state.world, prov_id);
 		auto nation_id = fat_id.get_nation_from_province_ownership();
-		stored_nation = nation_id;
+		nation_context.set(state, nation_id);
 		if(!bool(nation_id) || nation_id.id == state.local_player_nation) {
 			set_visible(state, false);
 		} else {
 			country_flag_button->on_update(state);
 
-			culture_chart->on_update(state);
-			workforce_chart->on_update(state);
-			ideology_chart->on_update(state);
-
 			Cyto::Any nat_id_payload = nation_id.id;
-			Cyto::Any prov_id_payload = prov_id;
 			impl_set(state, nat_id_payload);
-			impl_set(state, prov_id_payload);
 			set_visible(state, true);
 		}
 	}
 
 	message_result get(sys::state& state, Cyto::Any& payload) noexcept override {
 		if(payload.holds_type<dcon::nation_id>()) {
-			payload.emplace<dcon::nation_id>(stored_nation);
-			return message_result::consumed;
-		} else if(payload.holds_type<dcon::province_id>()) {
-			payload.emplace<dcon::province_id>(stored_province);
+			payload.emplace<dcon::nation_id>(nation_context.get());
 			return message_result::consumed;
 		} else {
 			return message_result::unseen;
@@ -361,13 +318,6 @@ public:
 };
 
 class province_view_statistics : public window_element_base {
-private:
-	culture_piechart<dcon::province_id>* culture_chart = nullptr;
-	ideology_piechart<dcon::province_id>* ideology_chart = nullptr;
-	workforce_piechart<dcon::province_id>* workforce_chart = nullptr;
-	dcon::nation_id stored_nation{};
-	dcon::province_id stored_province{};
-
 public:
 	std::unique_ptr<element_base> make_child(sys::state& state, std::string_view name, dcon::gui_def_id id) noexcept override {
 		if(name == "goods_type") {
@@ -375,17 +325,11 @@ public:
 		} else if(name == "total_population") {
 			return make_element_by_type<province_population_text>(state, id);
 		} else if(name == "workforce_chart") {
-			auto ptr = make_element_by_type<workforce_piechart<dcon::province_id>>(state, id);
-			workforce_chart = ptr.get();
-			return ptr;
+			return make_element_by_type<workforce_piechart<dcon::province_id>>(state, id);
 		} else if(name == "ideology_chart") {
-			auto ptr = make_element_by_type<ideology_piechart<dcon::province_id>>(state, id);
-			ideology_chart = ptr.get();
-			return ptr;
+			return make_element_by_type<ideology_piechart<dcon::province_id>>(state, id);
 		}  else if(name == "culture_chart") {
-			auto ptr = make_element_by_type<culture_piechart<dcon::province_id>>(state, id);
-			culture_chart = ptr.get();
-			return ptr;
+			return make_element_by_type<culture_piechart<dcon::province_id>>(state, id);
 		} else if(name == "core_icons") {
 			return make_element_by_type<province_core_flags>(state, id);
 		} else {
@@ -394,33 +338,16 @@ public:
 	}
 
 	void update_province_info(sys::state& state, dcon::province_id prov_id) {
-		stored_province = prov_id;
 		dcon::province_fat_id fat_id = dcon::fatten(state.world, prov_id);
 		auto nation_id = fat_id.get_nation_from_province_ownership();
-		stored_nation = nation_id;
 		if(bool(nation_id) && nation_id.id == state.local_player_nation) {
-			culture_chart->on_update(state);
-			workforce_chart->on_update(state);
-			ideology_chart->on_update(state);
-
 			Cyto::Any nat_id_payload = nation_id.id;
-			Cyto::Any prov_id_payload = prov_id;
 			impl_set(state, nat_id_payload);
-			impl_set(state, prov_id_payload);
 			set_visible(state, true);
 		} else {
 			set_visible(state, false);
 		}
 	}
-
-	message_result get(sys::state& state, Cyto::Any& payload) noexcept override {
-		if(payload.holds_type<dcon::province_id>()) {
-			payload.emplace<dcon::province_id>(stored_province);
-			return message_result::consumed;
-		} else {
-			return message_result::unseen;
-		}
-	}
 };
 
 template<class IconT>
@@ -497,10 +424,6 @@ public:
 };
 
 class province_view_buildings : public window_element_base {
-private:
-	dcon::nation_id stored_nation{};
-	dcon::province_id stored_province{};
-
 public:
 	void on_create(sys::state& state) noexcept override {
 		window_element_base::on_create(state);
@@ -526,15 +449,11 @@ public:
 	}
 
 	void update_province_info(sys::state& state, dcon::province_id prov_id) {
-		stored_province = prov_id;
 		dcon::province_fat_id fat_id = dcon::fatten(state.world, prov_id);
 		auto nation_id = fat_id.get_nation_from_province_ownership();
-		stored_nation = nation_id;
 		if(bool(nation_id) && nation_id.id == state.local_player_nation) {
 			Cyto::Any nat_id_payload = nation_id.id;
-			Cyto::Any prov_id_payload = prov_id;
 			impl_set(state, nat_id_payload);
-			impl_set(state, prov_id_payload);
 			set_visible(state, true);
 		} else {
 			set_visible(state, false);
@@ -546,8 +465,6 @@ class province_window_colony : public window_element_base {
 private:
 	image_element_base* rgo_icon = nullptr;
 	simple_text_element_base* population_box = nullptr;
-	culture_piechart<dcon::province_id>* culture_chart = nullptr;
-	dcon::province_id stored_province{};
 
 public:
 	std::unique_ptr<element_base> make_child(sys::state& state, std::string_view name, dcon::gui_def_id id) noexcept override {
@@ -556,9 +473,7 @@ public:
 			population_box = ptr.get();
 			return ptr;
 		}  else if(name == "culture_chart") {
-			auto ptr = make_element_by_type<culture_piechart<dcon::province_id>>(state, id);
-			culture_chart = ptr.get();
-			return ptr;
+			return make_element_by_type<culture_piechart<dcon::province_id>>(state, id);
 		} else if(name == "goods_type") {
 			auto ptr = make_element_by_type<image_element_base>(state, id);
 			rgo_icon = ptr.get();
@@ -569,7 +484,6 @@ public:
 	}
 
     void update_province_info(sys::state& state, dcon::province_id prov_id) {
-		stored_province = prov_id;
 		dcon::province_fat_id fat_id = dcon::fatten(state.world, prov_id);
 		auto nation_id = fat_id.get_nation_from_province_ownership();
 		if(bool(nation_id)) {
@@ -578,19 +492,9 @@ public:
 			rgo_icon->frame = fat_id.get_rgo().get_icon();
 			auto total_pop = state.world.province_get_demographics(prov_id, demographics::total);
 			population_box->set_text(state, text::prettify(int32_t(total_pop)));
-			culture_chart->on_update(state);
 			set_visible(state, true);
 		}
 	}
-
-	message_result get(sys::state& state, Cyto::Any& payload) noexcept override {
-		if(payload.holds_type<dcon::province_id>()) {
-			payload.emplace<dcon::province_id>(stored_province);
-			return message_result::consumed;
-		} else {
-			return message_result::unseen;
-		}
-	}
 };
 
 class province_national_focus_window : public window_element_base {
@@ -609,7 +513,8 @@ public:
 class province_view_window : public window_element_base {
 private:
 	dcon::province_id active_province{};
-	province_window_header* header_window = nullptr;
+	context_slot<dcon::province_id> province_context;
+	context_slot<dcon::state_definition_id> state_definition_context;
 	province_view_foreign_details* foreign_details_window = nullptr;
 	province_view_statistics* local_details_window = nullptr;
 	province_view_buildings* local_buildings_window = nullptr;
@@ -619,6 +524,8 @@ public:
 	province_national_focus_window* national_focus_window = nullptr;
 
     void on_create(sys::state& state) noexcept override {
+		publish_context(province_context);
+		publish_context(state_definition_context);
 		window_element_base::on_create(state);
 		state.ui_state.province_window = this;
 		set_visible(state, false);
@@ -630,9 +537,7 @@ public:
 		} else if(name == "background") {
 			return make_element_by_type<opaque_element_base>(state, id);
 		} else if(name == "province_view_header") {
-			auto ptr = make_element_by_type<province_window_header>(state, id);
-			header_window = ptr.get();
-			return ptr;
+			return make_element_by_type<province_window_header>(state, id);
 		} else if(name == "province_other") {
 			auto ptr = make_element_by_type<province_view_foreign_details>(state, id);
 			ptr->set_visible(state, false);
@@ -664,7 +569,9 @@ public:
 	}
 
 	void update_province_info(sys::state& state) {
-		header_window->update_province_info(state, active_province);
+		auto fat_id = dcon::fatten(state.world, active_province);
+		province_context.set(state, active_province);
+		state_definition_context.set(state, fat_id.get_state_from_abstract_state_membership().id);
 		foreign_details_window->update_province_info(state, active_province);
 		local_details_window->update_province_info(state, active_province);
 		local_buildings_window->update_province_info(state, active_province);
@@ -60,11 +60,14 @@ class topbar_date_text : public simple_text_element_base {
 
 public:
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, text::date_to_string(state, state.current_date));
+		// until the game loop has finished a day it is idle, and the date can be read directly
+		auto date = state.ui_day_report.days_completed > 0 ? state.ui_day_report.date : state.current_date;
+		set_text(state, text::date_to_string(state, date));
 	}
 
 	void on_create(sys::state& state) noexcept override {
 		simple_text_element_base::on_create(state);
+		set_update_domains(update_domain::date);
 		on_update(state);
 	}
 };
@@ -73,15 +76,20 @@ class topbar_pause_button : public button_element_base {
 public:
 	void button_action(sys::state& state) noexcept override {
 		if(state.actual_game_speed <= 0) {
-			state.actual_game_speed = state.ui_state.held_game_speed;
+			state.set_game_speed(state.ui_state.held_game_speed);
 		} else {
 			state.ui_state.held_game_speed = state.actual_game_speed.load();
-			state.actual_game_speed = 0;
+			state.set_game_speed(0);
 		}
 	}
 
+	void on_create(sys::state& state) noexcept override {
+		button_element_base::on_create(state);
+		set_update_domains(update_domain::date);
+	}
+
 	void on_update(sys::state& state) noexcept override {
-		disabled = state.internally_paused;
+		disabled = state.internally_paused.load(std::memory_order::acquire);
 	}
 };
 
@@ -94,7 +102,7 @@ public:
 
 	void button_action(sys::state& state) noexcept override {
 		if(state.actual_game_speed > 0) {
-			state.actual_game_speed = std::min(5, state.actual_game_speed.load() + 1);
+			state.set_game_speed(std::min(5, state.actual_game_speed.load() + 1));
 		} else {
 			state.ui_state.held_game_speed = std::min(5, state.ui_state.held_game_speed + 1);
 		}
@@ -110,7 +118,7 @@ public:
 
 	void button_action(sys::state& state) noexcept override {
 		if(state.actual_game_speed > 0) {
-			state.actual_game_speed = std::max(1, state.actual_game_speed.load() - 1);
+			state.set_game_speed(std::max(1, state.actual_game_speed.load() - 1));
 		} else {
 			state.ui_state.held_game_speed = std::max(1, state.ui_state.held_game_speed - 1);
 		}
@@ -121,11 +129,12 @@ class topbar_speed_indicator : public topbar_pause_button {
 public:
 	void on_create(sys::state& state) noexcept override {
 		button_element_base::on_create(state);
+		set_update_domains(update_domain::date);
 		base_data.data.button.shortcut = sys::virtual_key::SPACE;
 	}
 
 	void render(sys::state& state, int32_t x, int32_t y) noexcept override {
-		if(state.internally_paused) {
+		if(state.internally_paused.load(std::memory_order::acquire)) {
 			frame = 0;
 		} else {
 			frame = state.actual_game_speed;
@@ -140,6 +149,7 @@ private:
 
 public:
 	void on_update(sys::state& state) noexcept override {
+		set_update_target(state.local_player_nation);
 		if(current_nation != state.local_player_nation) {
 			if(bool(state.local_player_nation)) {
 				dcon::nation_fat_id fat_id = dcon::fatten(state.world, state.local_player_nation);
@@ -153,6 +163,7 @@ public:
 
 	void on_create(sys::state& state) noexcept override {
 		simple_text_element_base::on_create(state);
+		set_update_domains(update_domain::nation);
 		on_update(state);
 	}
 };
@@ -237,7 +248,9 @@ public:
 		} else if(name == "countryname") {
 			return make_element_by_type<topbar_country_name>(state, id);
 		} else if(name == "player_flag") {
-			return make_element_by_type<flag_button>(state, id);
+			auto ptr = make_element_by_type<flag_button>(state, id);
+			ptr->set_update_domains(update_domain::nation);
+			return ptr;
 		} else {
 			return nullptr;
 		}
@@ -3,6 +3,7 @@
 #include "texture.hpp"
 #include "province.hpp"
 #include <cmath>
+#include <cstddef>
 #include <numbers>
 #include <glm/glm.hpp>
 
@@ -110,181 +111,289 @@ GLuint load_dds_texture(simple_fs::directory const& dir, native_string_view file
 	return ogl::SOIL_direct_load_DDS_from_memory(data, content.file_size, size_x, size_y, ogl::SOIL_FLAG_TEXTURE_REPEATS);
 }
 
-void display_data::create_border_data(parsers::scenario_building_context& context) {
-	border_vertices.clear();
-
-	auto add_line = [map_size = glm::vec2(float(size_x), float(size_y))](std::vector<float>& vertices, uint32_t x0, uint32_t y0, glm::vec2 pos1, glm::vec2 pos2) {
-		glm::vec2 dir = normalize(pos2 - pos1);
-		glm::vec2 dir2 = dir;
-		dir = glm::vec2(-dir.y, dir.x);
-
-		pos1 = (pos1 + glm::vec2(x0 + 0.5f, y0 + 0.5f)) / map_size;
-		pos2 = (pos2 + glm::vec2(x0 + 0.5f, y0 + 0.5f)) / map_size;
-
-		// glm::vec2 dir = glm::vec2(100, 100) / map_size;
-		vertices.push_back(pos1.x);
-		vertices.push_back(pos1.y);
-		vertices.push_back(dir.x);
-		vertices.push_back(dir.y);
-		vertices.push_back(dir2.x);
-		vertices.push_back(dir2.y);
-
-		vertices.push_back(pos1.x);
-		vertices.push_back(pos1.y);
-		vertices.push_back(-dir.x);
-		vertices.push_back(-dir.y);
-		vertices.push_back(dir2.x);
-		vertices.push_back(dir2.y);
-
-		vertices.push_back(pos2.x);
-		vertices.push_back(pos2.y);
-		vertices.push_back(-dir.x);
-		vertices.push_back(-dir.y);
-		vertices.push_back(-dir2.x);
-		vertices.push_back(-dir2.y);
-
-		vertices.push_back(pos2.x);
-		vertices.push_back(pos2.y);
-		vertices.push_back(-dir.x);
-		vertices.push_back(-dir.y);
-		vertices.push_back(-dir2.x);
-		vertices.push_back(-dir2.y);
-
-		vertices.push_back(pos2.x);
-		vertices.push_back(pos2.y);
-		vertices.push_back(dir.x);
-		vertices.push_back(dir.y);
-		vertices.push_back(-dir2.x);
-		vertices.push_back(-dir2.y);
-
-		vertices.push_back(pos1.x);
-		vertices.push_back(pos1.y);
-		vertices.push_back(dir.x);
-		vertices.push_back(dir.y);
-		vertices.push_back(dir2.x);
-		vertices.push_back(dir2.y);
-	};
-
-	enum direction {
-		UP = 1 << 3,
-		DOWN = 1 << 2,
-		LEFT = 1 << 1,
-		RIGHT = 1 << 0,
-	};
-	
-	auto add_border = [&](uint32_t x0, uint32_t y0, uint16_t id_ul, uint16_t id_ur, uint16_t id_dl, uint16_t id_dr) {
-		// Yes this can be done better and more optimized. But for its good for now
-		uint8_t diff_u = id_ul != id_ur;
-		uint8_t diff_d = id_dl != id_dr;
-		uint8_t diff_l = id_ul != id_dl;
-		uint8_t diff_r = id_ur != id_dr;
-		uint8_t diff = diff_u << 3 | diff_d << 2 | diff_l << 1 | diff_r;
-
-		float offset = 0.5f * std::cos((float)std::numbers::pi / 4);
-		if(diff == (LEFT | UP)) {
-			glm::vec2 pos1 = glm::vec2(0.0f, 0.5f);
-			glm::vec2 pos2 = glm::vec2(0.5f, 0.0f);
-			add_line(border_vertices, x0, y0, pos1, pos2);
-			return;
-		}
-		if(diff == (LEFT | DOWN)) {
-			glm::vec2 pos1 = glm::vec2(0.0f, 0.5f);
-			glm::vec2 pos2 = glm::vec2(0.5f, 1.0f);
-			add_line(border_vertices, x0, y0, pos1, pos2);
-			return;
-		}
-		if(diff == (RIGHT | UP)) {
-			glm::vec2 pos1 = glm::vec2(1.0f, 0.5f);
-			glm::vec2 pos2 = glm::vec2(0.5f, 0.0f);
-			add_line(border_vertices, x0, y0, pos1, pos2);
-			return;
-		}
-		if(diff == (RIGHT | DOWN)) {
-			glm::vec2 pos1 = glm::vec2(1.0f, 0.5f);
-			glm::vec2 pos2 = glm::vec2(0.5f, 1.0f);
-			add_line(border_vertices, x0, y0, pos1, pos2);
-			return;
-		}
-		if(diff_u) {
-			glm::vec2 pos1 = glm::vec2(0.5f, 0.0f);
-			glm::vec2 pos2 = glm::vec2(0.5f, 0.5f);
-			add_line(border_vertices, x0, y0, pos1, pos2);
-		}
-		if(diff_d) {
-			glm::vec2 pos1 = glm::vec2(0.5f, 0.5f);
-			glm::vec2 pos2 = glm::vec2(0.5f, 1.0f);
-			add_line(border_vertices, x0, y0, pos1, pos2);
+void simplify_polyline(std::vector<glm::vec2> const& in, std::vector<glm::vec2>& out, float tolerance) {
+	out.clear();
+	if(in.size() <= 2) {
+		out = in;
+		return;
+	}
+	std::vector<uint8_t> keep(in.size(), 0);
+	keep.front() = 1;
+	keep.back() = 1;
+
+	std::vector<std::pair<uint32_t, uint32_t>> stack;
+	stack.emplace_back(0, uint32_t(in.size() - 1));
+	while(!stack.empty()) {
+		auto [first, last] = stack.back();
+		stack.pop_back();
+		if(last <= first + 1)
+			continue;
+
+		auto a = in[first];
+		auto ab = in[last] - a;
+		auto ab_length = glm::length(ab);
+		float max_distance = -1.f;
+		uint32_t max_index = first;
+		for(uint32_t i = first + 1; i < last; ++i) {
+			auto ap = in[i] - a;
+			float distance = ab_length > 0.f ? std::abs(ab.x * ap.y - ab.y * ap.x) / ab_length : glm::length(ap);
+			if(distance > max_distance) {
+				max_distance = distance;
+				max_index = i;
+			}
 		}
-		if(diff_l) {
-			glm::vec2 pos1 = glm::vec2(0.0f, 0.5f);
-			glm::vec2 pos2 = glm::vec2(0.5f, 0.5f);
-			add_line(border_vertices, x0, y0, pos1, pos2);
+		if(max_distance > tolerance) {
+			keep[max_index] = 1;
+			stack.emplace_back(first, max_index);
+			stack.emplace_back(max_index, last);
 		}
-		if(diff_r) {
-			glm::vec2 pos1 = glm::vec2(0.5f, 0.5f);
-			glm::vec2 pos2 = glm::vec2(1.0f, 0.5f);
-			add_line(border_vertices, x0, y0, pos1, pos2);
+	}
+	for(size_t i = 0; i < in.size(); ++i) {
+		if(keep[i])
+			out.push_back(in[i]);
+	}
+}
+
+namespace {
+
+// appends a polyline (in map pixels) to a strip as pairs of vertices on either side of it, mitered at the corners
+void append_border_strip(std::vector<border_vertex>& strip, std::vector<glm::vec2> const& points, glm::vec2 map_size, uint16_t province_a, uint16_t province_b, border_type type) {
+	auto const count = points.size();
+	if(count < 2)
+		return;
+	bool const closed = count > 2 && points.front() == points.back();
+	auto perpendicular = [](glm::vec2 d) { return glm::vec2(-d.y, d.x); };
+
+	auto const strip_start = strip.size();
+	for(size_t i = 0; i < count; ++i) {
+		bool const has_previous = i > 0 || closed;
+		bool const has_next = i + 1 < count || closed;
+		auto const previous = i > 0 ? points[i - 1] : points[count - 2];
+		auto const next = i + 1 < count ? points[i + 1] : points[1];
+
+		glm::vec2 side;
+		glm::vec2 extension(0.f, 0.f);
+		if(has_previous && has_next) {
+			auto n0 = perpendicular(glm::normalize(points[i] - previous));
+			auto n1 = perpendicular(glm::normalize(next - points[i]));
+			auto miter = n0 + n1;
+			if(glm::length(miter) < 0.001f) {
+				side = n0;
+			} else {
+				miter = glm::normalize(miter);
+				side = miter / std::max(glm::dot(miter, n0), 0.25f);
+			}
+		} else if(has_next) {
+			auto d = glm::normalize(next - points[i]);
+			side = perpendicular(d);
+			extension = -d; // the open ends reach past their last point so that they close up with the borders they meet
+		} else {
+			auto d = glm::normalize(points[i] - previous);
+			side = perpendicular(d);
+			extension = d;
 		}
-	};
 
+		auto const position = points[i] / map_size;
+		strip.push_back(border_vertex{ position, side + extension, province_a, province_b, type });
+		strip.push_back(border_vertex{ position, -side + extension, province_a, province_b, type });
+	}
+	// consecutive strips in a tile are drawn as one, joined by a pair of degenerate triangles
+	if(strip_start != 0) {
+		auto previous_last = strip[strip_start - 1];
+		auto first = strip[strip_start];
+		strip.insert(strip.begin() + strip_start, { previous_last, first });
+	}
+}
+
+}
+
+void display_data::create_border_data(parsers::scenario_building_context& context) {
 	for(uint32_t y = 0; y < size_y - 1; y++) {
-		for(uint32_t x = 0; x < size_x - 1; x++) {
+		for(uint32_t x = 0; x < size_x; x++) {
+			// the last column is compared against the first: the map wraps around at the international date line
+			auto const x_right = x + 1 < size_x ? x + 1 : 0;
 			auto prov_id_ul = province_id_map[(x + 0) + (y + 0) * size_x];
-			auto prov_id_ur = province_id_map[(x + 1) + (y + 0) * size_x];
+			auto prov_id_ur = province_id_map[x_right + (y + 0) * size_x];
 			auto prov_id_dl = province_id_map[(x + 0) + (y + 1) * size_x];
-			auto prov_id_dr = province_id_map[(x + 1) + (y + 1) * size_x];
+			auto prov_id_dr = province_id_map[x_right + (y + 1) * size_x];
 			if(prov_id_ul != prov_id_ur) {
-				add_border(x, y, prov_id_ul, prov_id_ur, prov_id_dl, prov_id_dr);
 				if(prov_id_ur != 0 && prov_id_ul != 0)
 					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_ur));
 			} else if(prov_id_ul != prov_id_dl) {
-				add_border(x, y, prov_id_ul, prov_id_ur, prov_id_dl, prov_id_dr);
 				if(prov_id_dl != 0 && prov_id_ul != 0)
 					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dl));
 			} else if(prov_id_ul != prov_id_dr) {
-				add_border(x, y, prov_id_ul, prov_id_ur, prov_id_dl, prov_id_dr);
 				if(prov_id_dr != 0 && prov_id_ul != 0)
 					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dr));
 			}
 		}
-		{
-			// handle the international date line
-			auto prov_id_ul = province_id_map[((size_x - 1) + 0) + (y + 0) * size_x];
-			auto prov_id_ur = province_id_map[0 + (y + 0) * size_x];
-			auto prov_id_dl = province_id_map[((size_x - 1) + 0) + (y + 1) * size_x];
-			auto prov_id_dr = province_id_map[0 + (y + 1) * size_x];
-			if(prov_id_ul != prov_id_ur) {
-				add_border((size_x - 1), y, prov_id_ul, prov_id_ur, prov_id_dl, prov_id_dr);
-				if(prov_id_ur != 0 && prov_id_ul != 0)
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_ur));
-			} else if(prov_id_ul != prov_id_dl) {
-				add_border((size_x - 1), y, prov_id_ul, prov_id_ur, prov_id_dl, prov_id_dr);
-				if(prov_id_dl != 0 && prov_id_ul != 0)
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dl));
-			} else if(prov_id_ul != prov_id_dr) {
-				add_border((size_x - 1), y, prov_id_ul, prov_id_ur, prov_id_dl, prov_id_dr);
-				if(prov_id_dr != 0 && prov_id_ul != 0)
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dr));
+	}
+
+	/*
+	* Borders run along the edges between pixels. A vertical edge (x, y) lies between the pixels (x - 1, y) and (x, y) and
+	* runs from the grid point (x, y) to (x, y + 1); a horizontal edge (x, y) lies between the pixels (x, y - 1) and (x, y)
+	* and runs from (x, y) to (x + 1, y). The edges are followed through every grid point where exactly two border edges
+	* meet, which gives one chain per stretch of border between two provinces. Chains are cut where they pass into
+	* another tile, simplified, and appended to the strip of their tile.
+	*/
+	auto const sx = int32_t(size_x);
+	auto const sy = int32_t(size_y);
+	auto const first_sea = province::to_map_id(context.state.province_definitions.first_sea_province);
+	constexpr uint32_t horizontal_bit = 0x80000000;
+
+	auto wrap_x = [sx](int32_t x) { return ((x % sx) + sx) % sx; };
+	auto edge_provinces = [&](uint32_t edge) {
+		auto index = int32_t(edge & ~horizontal_bit);
+		auto x = index % sx;
+		auto y = index / sx;
+		if(edge & horizontal_bit)
+			return std::pair<uint16_t, uint16_t>(province_id_map[x + (y - 1) * sx], province_id_map[x + y * sx]);
+		else
+			return std::pair<uint16_t, uint16_t>(province_id_map[wrap_x(x - 1) + y * sx], province_id_map[x + y * sx]);
+	};
+	auto is_border = [&](uint32_t edge) {
+		auto p = edge_provinces(edge);
+		return p.first != p.second;
+	};
+	// the border edges that end at a grid point
+	auto edges_at = [&](int32_t px, int32_t py, uint32_t* out) {
+		px = wrap_x(px);
+		uint32_t count = 0;
+		if(py >= 1 && is_border(uint32_t((py - 1) * sx + px)))
+			out[count++] = uint32_t((py - 1) * sx + px);
+		if(py < sy && is_border(uint32_t(py * sx + px)))
+			out[count++] = uint32_t(py * sx + px);
+		if(py >= 1 && py < sy) {
+			if(is_border(uint32_t(py * sx + wrap_x(px - 1)) | horizontal_bit))
+				out[count++] = uint32_t(py * sx + wrap_x(px - 1)) | horizontal_bit;
+			if(is_border(uint32_t(py * sx + px) | horizontal_bit))
+				out[count++] = uint32_t(py * sx + px) | horizontal_bit;
+		}
+		return count;
+	};
+	// the step from one end of an edge to the other
+	auto step_along = [&](uint32_t edge, glm::ivec2 from) {
+		auto index = int32_t(edge & ~horizontal_bit);
+		if(edge & horizontal_bit)
+			return glm::ivec2(wrap_x(from.x) == index % sx ? 1 : -1, 0);
+		else
+			return glm::ivec2(0, from.y == index / sx ? 1 : -1);
+	};
+	auto edge_tile = [&](glm::ivec2 from, glm::ivec2 step) {
+		auto tx = uint32_t(wrap_x(from.x + std::min(step.x, 0))) / tile_size;
+		auto ty = uint32_t(from.y + std::min(step.y, 0)) / tile_size;
+		return ty * tiles_x + tx;
+	};
+
+	tiles_x = (size_x + tile_size - 1) / tile_size;
+	tiles_y = (size_y + tile_size - 1) / tile_size;
+	std::vector<std::vector<border_vertex>> tile_strips(tiles_x * tiles_y);
+
+	std::vector<uint8_t> visited_vertical(size_x * size_y, 0);
+	std::vector<uint8_t> visited_horizontal(size_x * size_y, 0);
+	auto visited = [&](uint32_t edge) -> uint8_t& {
+		return (edge & horizontal_bit) ? visited_horizontal[edge & ~horizontal_bit] : visited_vertical[edge];
+	};
+
+	std::vector<glm::vec2> piece;
+	std::vector<glm::vec2> simplified;
+	auto const map_size = glm::vec2(float(size_x), float(size_y));
+
+	for(uint32_t kind = 0; kind < 2; ++kind) {
+		for(int32_t y = (kind == 0 ? 0 : 1); y < sy; ++y) {
+			for(int32_t x = 0; x < sx; ++x) {
+				uint32_t const start_edge = uint32_t(y * sx + x) | (kind == 0 ? 0 : horizontal_bit);
+				if(visited(start_edge) || !is_border(start_edge))
+					continue;
+
+				auto provinces = edge_provinces(start_edge);
+				auto const province_a = std::min(provinces.first, provinces.second);
+				auto const province_b = std::max(provinces.first, provinces.second);
+				border_type type = border_type::province;
+				if(province_a == 0)
+					type = border_type::impassable;
+				else if(province_a >= first_sea)
+					type = border_type::sea;
+				else if(province_b >= first_sea)
+					type = border_type::coast;
+
+				// walk backwards to the start of the chain (or around the loop that it forms)
+				uint32_t edge = start_edge;
+				glm::ivec2 point(x, y);
+				uint32_t incident[4];
+				while(true) {
+					if(edges_at(point.x, point.y, incident) != 2)
+						break;
+					auto next = incident[0] == edge ? incident[1] : incident[0];
+					if(next == start_edge)
+						break;
+					point += step_along(next, point);
+					edge = next;
+				}
+
+				// then forwards, cutting it where it passes into another tile; each piece is placed in the copy of the
+				// map that its tile lies in
+				uint32_t current_tile = tiles_x * tiles_y;
+				int32_t x_shift = 0;
+				auto finish_piece = [&]() {
+					simplify_polyline(piece, simplified, 0.75f);
+					append_border_strip(tile_strips[current_tile], simplified, map_size, province_a, province_b, type);
+				};
+				while(true) {
+					visited(edge) = 1;
+					auto step = step_along(edge, point);
+					auto tile = edge_tile(point, step);
+					if(tile != current_tile) {
+						if(current_tile != tiles_x * tiles_y)
+							finish_piece();
+						current_tile = tile;
+						auto const edge_x = point.x + std::min(step.x, 0);
+						x_shift = edge_x - wrap_x(edge_x);
+						piece.clear();
+						piece.push_back(glm::vec2(float(point.x - x_shift), float(point.y)));
+					}
+					point += step;
+					piece.push_back(glm::vec2(float(point.x - x_shift), float(point.y)));
+
+					if(edges_at(point.x, point.y, incident) != 2)
+						break;
+					auto next = incident[0] == edge ? incident[1] : incident[0];
+					if(visited(next))
+						break;
+					edge = next;
+				}
+				finish_piece();
 			}
 		}
 	}
+
+	border_vertices.clear();
+	border_tiles.assign(tiles_x * tiles_y, mesh_tile{});
+	for(uint32_t t = 0; t < tiles_x * tiles_y; ++t) {
+		border_tiles[t].first = uint32_t(border_vertices.size());
+		border_tiles[t].count = uint32_t(tile_strips[t].size());
+		border_vertices.insert(border_vertices.end(), tile_strips[t].begin(), tile_strips[t].end());
+	}
 }
+
 void display_data::create_border_ogl_objects() {
-	border_indicies = ((uint32_t)border_vertices.size()) / 3;
+	border_indicies = uint32_t(border_vertices.size());
 
 	glGenVertexArrays(1, &border_vao);
 	glBindVertexArray(border_vao);
 
 	glGenBuffers(1, &border_vbo);
 	glBindBuffer(GL_ARRAY_BUFFER, border_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * border_vertices.size(), &border_vertices[0], GL_STATIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(border_vertex) * border_vertices.size(), border_vertices.data(), GL_STATIC_DRAW);
 
-	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(border_vertex), (void*)offsetof(border_vertex, position));
 	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(2 * sizeof(float)));
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(border_vertex), (void*)offsetof(border_vertex, normal));
 	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(4 * sizeof(float)));
+	glVertexAttribIPointer(2, 2, GL_UNSIGNED_SHORT, sizeof(border_vertex), (void*)offsetof(border_vertex, province_a));
 	glEnableVertexAttribArray(2);
+	glVertexAttribIPointer(3, 1, GL_UNSIGNED_BYTE, sizeof(border_vertex), (void*)offsetof(border_vertex, type));
+	glEnableVertexAttribArray(3);
 
 	glBindVertexArray(0);
 }
@@ -469,26 +578,47 @@ void display_data::create_meshes() {
 	};
 
 
-	uint32_t index = 0;
-	for(uint32_t y = 0; y < size_y; y++) {
-		uint32_t last_x = 0;
-		bool last_is_water = terrain_id_map[index++] > 64;
-		for(uint32_t x = 1; x < size_x; x++) {
-			bool is_water = terrain_id_map[index++] > 64;
-			if(is_water != last_is_water || (x & (256 - 1)) == 0) {
-				if(last_is_water)
-					add_quad(water_vertices, last_x, y, x, y + 1);
-				else
-					add_quad(land_vertices, last_x, y, x, y + 1);
-
-				last_x = x;
-				last_is_water = is_water;
+	tiles_x = (size_x + tile_size - 1) / tile_size;
+	tiles_y = (size_y + tile_size - 1) / tile_size;
+	auto const tile_count = tiles_x * tiles_y;
+	land_tiles.assign(tile_count * lod_levels, mesh_tile{});
+	water_tiles.assign(tile_count * lod_levels, mesh_tile{});
+
+	auto is_water = [&](uint32_t x, uint32_t y) { return terrain_id_map[x + y * size_x] > 64; };
+
+	// each block of a level takes the type of its top left pixel; runs of blocks of the same type become one quad
+	for(uint32_t lod = 0; lod < lod_levels; ++lod) {
+		uint32_t const step = 1 << lod;
+		for(uint32_t ty = 0; ty < tiles_y; ++ty) {
+			for(uint32_t tx = 0; tx < tiles_x; ++tx) {
+				auto& land_tile = land_tiles[lod * tile_count + ty * tiles_x + tx];
+				auto& water_tile = water_tiles[lod * tile_count + ty * tiles_x + tx];
+				land_tile.first = uint32_t(land_vertices.size() / 2);
+				water_tile.first = uint32_t(water_vertices.size() / 2);
+
+				uint32_t const x_start = tx * tile_size;
+				uint32_t const x_end = std::min(x_start + tile_size, size_x);
+				uint32_t const y_start = ty * tile_size;
+				uint32_t const y_end = std::min(y_start + tile_size, size_y);
+				for(uint32_t y = y_start; y < y_end; y += step) {
+					uint32_t const y_next = std::min(y + step, y_end);
+					uint32_t last_x = x_start;
+					bool last_is_water = is_water(x_start, y);
+					for(uint32_t x = x_start + step; x < x_end; x += step) {
+						bool water = is_water(x, y);
+						if(water != last_is_water) {
+							add_quad(last_is_water ? water_vertices : land_vertices, last_x, y, x, y_next);
+							last_x = x;
+							last_is_water = water;
+						}
+					}
+					add_quad(last_is_water ? water_vertices : land_vertices, last_x, y, x_end, y_next);
+				}
+
+				land_tile.count = uint32_t(land_vertices.size() / 2) - land_tile.first;
+				water_tile.count = uint32_t(water_vertices.size() / 2) - water_tile.first;
 			}
 		}
-		if(last_is_water)
-			add_quad(water_vertices, last_x, y, size_x, y + 1);
-		else
-			add_quad(land_vertices, last_x, y, size_x, y + 1);
 	}
 
 	water_indicies = ((uint32_t)water_vertices.size()) / 3 * 2;
@@ -512,6 +642,52 @@ void display_data::create_meshes() {
 	create_border_ogl_objects();
 }
 
+void display_data::find_visible_tiles(uint32_t screen_x, uint32_t screen_y) {
+	visible_tiles.clear();
+
+	// the inverse of the transform in map_v.glsl: the screen spans half_width either side of 0.5 in world x and
+	// half_height either side of 0.5 in world y, and vertex = world + (offset_x, -offset_y)
+	float const aspect_ratio = screen_x / float(screen_y);
+	float const half_width = aspect_ratio * float(size_y) / (2.f * zoom * float(size_x));
+	float const half_height = 1.f / (2.f * zoom);
+	// a little slack, as the border lines reach a bit past the pixel that they are stored under
+	float const margin_x = 2.f / float(size_x);
+	float const margin_y = 2.f / float(size_y);
+
+	float const x_min = (offset_x + 0.5f - half_width - margin_x) * float(size_x) / float(tile_size);
+	float const x_max = (offset_x + 0.5f + half_width + margin_x) * float(size_x) / float(tile_size);
+	float const y_min = (0.5f - half_height - offset_y - margin_y) * float(size_y) / float(tile_size);
+	float const y_max = (0.5f + half_height - offset_y + margin_y) * float(size_y) / float(tile_size);
+
+	auto const ty_first = uint32_t(std::clamp(int32_t(std::floor(y_min)), 0, int32_t(tiles_y) - 1));
+	auto const ty_last = uint32_t(std::clamp(int32_t(std::floor(y_max)), 0, int32_t(tiles_y) - 1));
+
+	// the map wraps horizontally
+	auto const tx_first = int32_t(std::floor(x_min));
+	auto const tx_last = std::min(int32_t(std::floor(x_max)), tx_first + int32_t(tiles_x) - 1);
+
+	for(uint32_t ty = ty_first; ty <= ty_last; ++ty) {
+		for(int32_t i = tx_first; i <= tx_last; ++i) {
+			auto tx = uint32_t(((i % int32_t(tiles_x)) + int32_t(tiles_x)) % int32_t(tiles_x));
+			visible_tiles.push_back(ty * tiles_x + tx);
+		}
+	}
+}
+
+void display_data::draw_tiles(GLenum mode, std::vector<mesh_tile> const& tiles, uint32_t first_tile) {
+	draw_firsts.clear();
+	draw_counts.clear();
+	for(auto t : visible_tiles) {
+		auto const& range = tiles[first_tile + t];
+		if(range.count != 0) {
+			draw_firsts.push_back(GLint(range.first));
+			draw_counts.push_back(GLsizei(range.count));
+		}
+	}
+	if(!draw_firsts.empty())
+		glMultiDrawArrays(mode, draw_firsts.data(), draw_counts.data(), GLsizei(draw_firsts.size()));
+}
+
 display_data::~display_data() {
 	if(provinces_texture_handle)
 		glDeleteTextures(1, &provinces_texture_handle);
@@ -642,6 +818,15 @@ void display_data::render(sys::state& state, uint32_t screen_x, uint32_t screen_
 	glActiveTexture(GL_TEXTURE11);
 	glBindTexture(GL_TEXTURE_2D, stripes_texture);
 
+	find_visible_tiles(screen_x, screen_y);
+
+	// the coarsest level of detail that still has at least one block per screen pixel
+	uint32_t lod = 0;
+	float const map_pixels_per_screen_pixel = float(size_y) / (zoom * float(screen_y));
+	while(lod + 1 < lod_levels && float(2 << lod) <= map_pixels_per_screen_pixel)
+		++lod;
+	uint32_t const lod_first_tile = lod * tiles_x * tiles_y;
+
 	glBindVertexArray(vao);
 
 	if(active_map_mode == map_mode::mode::terrain)
@@ -665,7 +850,7 @@ void display_data::render(sys::state& state, uint32_t screen_x, uint32_t screen_
 	//glUniform2f(0, offset_x - 1.f, offset_y);
 	//glDrawArrays(GL_TRIANGLES, 0, land_indicies);
 	glUniform2f(0, offset_x + 0.f, offset_y);
-	glDrawArrays(GL_TRIANGLES, 0, land_indicies);
+	draw_tiles(GL_TRIANGLES, land_tiles, lod_first_tile);
 	//glUniform2f(0, offset_x + 1.f, offset_y);
 	//glDrawArrays(GL_TRIANGLES, 0, land_indicies);
 
@@ -689,13 +874,15 @@ void display_data::render(sys::state& state, uint32_t screen_x, uint32_t screen_
 	//glUniform2f(0, offset_x - 1.f, offset_y);
 	//glDrawArrays(GL_TRIANGLES, 0, water_indicies);
 	glUniform2f(0, offset_x + 0.f, offset_y);
-	glDrawArrays(GL_TRIANGLES, 0, water_indicies);
+	draw_tiles(GL_TRIANGLES, water_tiles, lod_first_tile);
 	//glUniform2f(0, offset_x + 1.f, offset_y);
 	//glDrawArrays(GL_TRIANGLES, 0, water_indicies);
 
 	glActiveTexture(GL_TEXTURE0);
 	glBindTexture(GL_TEXTURE_2D, border_texture);
 
+	// the strips of a tile are joined by degenerate triangles, which flip their winding
+	glDisable(GL_CULL_FACE);
 	glBindVertexArray(border_vao);
 
 	glUseProgram(line_border_shader);
@@ -707,12 +894,12 @@ void display_data::render(sys::state& state, uint32_t screen_x, uint32_t screen_
 	// uniform vec2 map_size
 	glUniform2f(3, GLfloat(size_x), GLfloat(size_y));
 
-	glBindVertexBuffer(0, border_vbo, 0, sizeof(GLfloat) * 6);
+	glBindVertexBuffer(0, border_vbo, 0, sizeof(border_vertex));
 
 	//glUniform2f(0, offset_x - 1.f, offset_y);
 	//glDrawArrays(GL_TRIANGLES, 0, border_indicies);
 	glUniform2f(0, offset_x + 0.f, offset_y);
-	glDrawArrays(GL_TRIANGLES, 0, border_indicies);
+	draw_tiles(GL_TRIANGLE_STRIP, border_tiles, 0);
 	//glUniform2f(0, offset_x + 1.f, offset_y);
 	//glDrawArrays(GL_TRIANGLES, 0, border_indicies);
 
@@ -772,9 +959,68 @@ void display_data::gen_prov_color_texture(GLuint texture_handle, std::vector<uin
 }
 
 
-void display_data::set_province_color(std::vector<uint32_t> const& prov_color, map_mode::mode new_map_mode) {
-	active_map_mode = new_map_mode;
-	gen_prov_color_texture(province_color, prov_color, 2);
+void display_data::set_province_color(sys::state& state, std::vector<uint32_t> const& prov_color, map_mode::mode new_map_mode) {
+	if(new_map_mode != active_map_mode || prov_color.size() != province_colors.size()) {
+		active_map_mode = new_map_mode;
+		province_colors = prov_color;
+		gen_prov_color_texture(province_color, prov_color, 2);
+		return;
+	}
+
+	// upload, for each row of each layer, the span between the first and the last texel that changed
+	glBindTexture(GL_TEXTURE_2D_ARRAY, province_color);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, state.open_gl.stream.handle);
+	uint32_t layer_size = uint32_t(prov_color.size() / 2);
+	for(uint32_t layer = 0; layer < 2; ++layer) {
+		for(uint32_t row_start = 0; row_start < layer_size; row_start += 256) {
+			uint32_t row_end = std::min(row_start + 256, layer_size);
+			uint32_t first = row_end;
+			uint32_t last = row_start;
+			for(uint32_t i = row_start; i < row_end; ++i) {
+				if(prov_color[layer * layer_size + i] != province_colors[layer * layer_size + i]) {
+					first = std::min(first, i);
+					last = i;
+				}
+			}
+			if(first == row_end)
+				continue;
+			std::copy(prov_color.begin() + (layer * layer_size + first), prov_color.begin() + (layer * layer_size + last + 1), province_colors.begin() + (layer * layer_size + first));
+			auto space = ogl::allocate_stream(state, uint32_t(sizeof(uint32_t) * (last - first + 1)));
+			memcpy(space.data, &province_colors[layer * layer_size + first], sizeof(uint32_t) * (last - first + 1));
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, first - row_start, row_start / 256, layer, last - first + 1, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<void const*>(space.offset));
+		}
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+// writes a single texel of the province_highlight texture through the stream buffer
+void set_highlight_texel(sys::state& state, GLuint texture_handle, int16_t province, uint32_t value) {
+	auto space = ogl::allocate_stream(state, sizeof(uint32_t));
+	memcpy(space.data, &value, sizeof(uint32_t));
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, space.buffer);
+	glBindTexture(GL_TEXTURE_2D, texture_handle);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, province % 256, province / 256, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<void const*>(space.offset));
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void display_data::mark_province_dirty(dcon::province_id prov_id) {
+	auto i = uint32_t(province::to_map_id(prov_id));
+	if(i / 64 < dirty_province_words)
+		dirty_provinces[i / 64].fetch_or(uint64_t(1) << (i % 64), std::memory_order::release);
+}
+
+void display_data::mark_all_provinces_dirty() {
+	for(uint32_t w = 0; w < dirty_province_words; ++w)
+		dirty_provinces[w].store(~uint64_t(0), std::memory_order::release);
+}
+
+void display_data::reset_dirty_provinces(uint32_t province_count) {
+	dirty_province_words = (province_count + 63) / 64;
+	dirty_provinces = std::unique_ptr<std::atomic<uint64_t>[]>(new std::atomic<uint64_t>[dirty_province_words]);
+	mark_all_provinces_dirty();
 }
 
 void display_data::set_terrain_map_mode() {
@@ -932,6 +1178,7 @@ void display_data::load_map(sys::state& state) {
 	uint32_t province_size = state.world.province_size() + 1;
 	province_size += 256 - province_size % 256;
 
+	reset_dirty_provinces(province_size);
 
 	std::vector<uint32_t> testHighlight(province_size);
 	std::vector<uint32_t> testColor(province_size * 4);
@@ -945,7 +1192,7 @@ void display_data::load_map(sys::state& state) {
 		testColor[i] = 255;
 	}
 
-	set_province_color(testColor, map_mode::mode::terrain);
+	set_province_color(state, testColor, map_mode::mode::terrain);
 }
 
 void display_data::update(sys::state& state) {
@@ -987,14 +1234,20 @@ void display_data::update(sys::state& state) {
 
 	if(unhandled_province_selection) {
 		map_mode::update_map_mode(state);
-		std::vector<uint32_t> province_highlights(state.world.province_size() + 1);
+		// only the texels of the previous and the new selection change
+		if(highlighted_province)
+			set_highlight_texel(state, province_highlight, highlighted_province, 0);
 		if(selected_province)
-			province_highlights[selected_province] = 0x2B2B2B2B;
-		gen_prov_color_texture(province_highlight, province_highlights);
+			set_highlight_texel(state, province_highlight, selected_province, 0x2B2B2B2B);
+		highlighted_province = selected_province;
 		unhandled_province_selection = false;
 	}
 }
 
+bool display_data::is_animating() const {
+	return is_dragging || pos_velocity != glm::vec2(0.f) || glm::length(scroll_pos_velocity) > 1e-6f || std::abs(zoom_change) > 1e-6f;
+}
+
 void display_data::on_key_down(sys::virtual_key keycode, sys::key_modifiers mod) {
 	if(keycode == sys::virtual_key::LEFT) {
 		pos_velocity.x = -1.f;
@@ -3,10 +3,41 @@
 #include "system_state.hpp"
 #include "map_modes.hpp"
 #include <glm/vec2.hpp>
+#include <bit>
 #include "parsers_declarations.hpp"
 
 namespace map {
 
+// a range of vertices within one of the map vbos
+struct mesh_tile {
+	uint32_t first = 0;
+	uint32_t count = 0;
+};
+
+// what a stretch of border separates
+enum class border_type : uint8_t {
+	province = 0, // two land provinces
+	coast = 1, // a land province and a sea province
+	sea = 2, // two sea provinces
+	impassable = 3 // a province and unassigned map pixels
+};
+
+// The borders are triangle strips that follow the simplified outline between each pair of provinces. Every vertex
+// carries the pair of provinces and the type of the border that it belongs to, so that borders can be styled per
+// province pair without rebuilding the mesh.
+struct border_vertex {
+	glm::vec2 position; // 0-1 across the map
+	glm::vec2 normal; // in units of half the border width, from the center line to this side of the strip
+	uint16_t province_a = 0; // map ids, province_a < province_b
+	uint16_t province_b = 0;
+	border_type type = border_type::province;
+	uint8_t padding[3] = { 0, 0, 0 };
+};
+
+// Douglas-Peucker: removes the points of a polyline that lie within tolerance of the line through their neighbours
+// that are kept; the first and last points are always kept
+void simplify_polyline(std::vector<glm::vec2> const& in, std::vector<glm::vec2>& out, float tolerance);
+
 class display_data {
 public:
 	display_data() {};
@@ -19,13 +50,41 @@ public:
 
 	map_mode::mode active_map_mode = map_mode::mode::terrain;
 	int16_t selected_province = 0;
+	int16_t highlighted_province = 0; // the province currently lit in the province_highlight texture
 
 	void render(sys::state& state, uint32_t screen_x, uint32_t screen_y);
-	void set_province_color(std::vector<uint32_t> const& prov_color, map_mode::mode map_mode);
+	// uploads prov_color to the province color texture; if the map mode stays the same only the texels that differ
+	// from the last upload are sent, through the stream buffer
+	void set_province_color(sys::state& state, std::vector<uint32_t> const& prov_color, map_mode::mode map_mode);
 	void set_terrain_map_mode();
 
+	// the colors last uploaded by set_province_color, both layers
+	std::vector<uint32_t> province_colors;
+
+	// to be called whenever something a map mode colors a province by (e.g. its owner) changes; safe from any thread
+	void mark_province_dirty(dcon::province_id prov_id);
+	void mark_all_provinces_dirty();
+	// (re)allocates the marks for province_count map ids, all of them set
+	void reset_dirty_provinces(uint32_t province_count);
+	bool tracks_dirty_provinces() const {
+		return dirty_province_words != 0;
+	}
+	// calls f with the map id of each province marked since the last call and clears the marks
+	template<typename F>
+	void consume_dirty_provinces(F&& f) {
+		for(uint32_t w = 0; w < dirty_province_words; ++w) {
+			auto bits = dirty_provinces[w].exchange(0, std::memory_order::acq_rel);
+			while(bits != 0) {
+				f(uint16_t(w * 64 + std::countr_zero(bits)));
+				bits &= bits - 1;
+			}
+		}
+	}
+
 	// Set the position of camera. Position relative from 0-1
 	void set_pos(glm::vec2 pos);
+	// true while the camera is still moving or zooming, i.e. while the next frame will differ from the last one
+	bool is_animating() const;
 
 	// Input methods
 	void on_key_down(sys::virtual_key keycode, sys::key_modifiers mod);
@@ -45,7 +104,16 @@ public:
 	uint32_t size_x;
 	uint32_t size_y;
 
-	std::vector<float> border_vertices;
+	// The meshes are cut into square tiles of tile_size map pixels; the bounds of a tile follow from its position in the
+	// grid. The land and water vbos hold every tile at each of lod_levels levels of detail, where level n is built from
+	// blocks of 2^n by 2^n pixels. render draws only the tiles in view, at the coarsest level that still has at least
+	// one block per screen pixel.
+	static constexpr uint32_t tile_size = 256;
+	static constexpr uint32_t lod_levels = 4;
+
+	std::vector<border_vertex> border_vertices;
+	// the range of border_vertices that makes up the single (degenerate-joined) strip of each map tile
+	std::vector<mesh_tile> border_tiles;
 	std::vector<uint8_t> terrain_id_map;
 	std::vector<uint8_t> median_terrain_type;
 
@@ -61,6 +129,10 @@ private:
 	// interaction
 	bool unhandled_province_selection = false;
 
+	// one bit per province map id
+	std::unique_ptr<std::atomic<uint64_t>[]> dirty_provinces;
+	uint32_t dirty_province_words = 0;
+
 	// Meshes
 	GLuint water_vbo = 0;
 	GLuint land_vbo = 0;
@@ -71,6 +143,15 @@ private:
 	uint32_t land_indicies = 0;
 	uint32_t border_indicies = 0;
 
+	uint32_t tiles_x = 0;
+	uint32_t tiles_y = 0;
+	std::vector<mesh_tile> land_tiles;  // [lod * tiles_x * tiles_y + tile]
+	std::vector<mesh_tile> water_tiles; // [lod * tiles_x * tiles_y + tile]
+	// scratch space for render
+	std::vector<uint32_t> visible_tiles;
+	std::vector<GLint> draw_firsts;
+	std::vector<GLsizei> draw_counts;
+
 	// Textures
 	GLuint provinces_texture_handle = 0;
 	GLuint terrain_texture_handle = 0;
@@ -119,6 +200,8 @@ private:
 
 	void load_shaders(simple_fs::directory& root);
 	void create_meshes();
+	void find_visible_tiles(uint32_t screen_x, uint32_t screen_y);
+	void draw_tiles(GLenum mode, std::vector<mesh_tile> const& tiles, uint32_t first_tile);
 	void gen_prov_color_texture(GLuint texture_handle, std::vector<uint32_t> const& prov_color, uint8_t layers = 1);
 };
 }
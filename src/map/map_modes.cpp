@@ -9,28 +9,52 @@
 
 namespace map_mode {
 
-void set_political(sys::state& state) {
+uint32_t political_color(sys::state& state, dcon::province_id prov_id) {
+	auto owner = state.world.province_get_nation_from_province_ownership(prov_id);
+	if(bool(owner))
+		return state.world.nation_get_color(owner);
+	else // If no owner use default color
+		return 255 << 16 | 255 << 8 | 255;
+}
+
+void political_colors(sys::state& state, std::vector<uint32_t> const* previous, std::vector<uint32_t>& prov_color) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 
-	std::vector<uint32_t> prov_color(texture_size * 2);
+	if(previous && previous->size() == texture_size * 2 && state.map_display.tracks_dirty_provinces()) {
+		state.map_display.consume_dirty_provinces([&](uint16_t i) {
+			auto prov_id = province::from_map_id(i);
+			if(!bool(prov_id) || prov_id.index() >= int32_t(province_size))
+				return;
+			if(prov_color.empty())
+				prov_color = *previous;
+			auto color = political_color(state, prov_id);
+			prov_color[i] = color;
+			prov_color[i + texture_size] = color;
+		});
+		return;
+	}
+
+	prov_color.assign(texture_size * 2, 0);
 
+	state.map_display.consume_dirty_provinces([](uint16_t) { });
 	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto fat_id = dcon::fatten(state.world, prov_id);
-		auto id = fat_id.get_nation_from_province_ownership();
-		uint32_t color;
-		if(bool(id))
-			color = id.get_color();
-		else // If no owner use default color
-			color = 255 << 16 | 255 << 8 | 255;
+		auto color = political_color(state, prov_id);
 		auto i = province::to_map_id(prov_id);
 
 		prov_color[i] = color;
 		prov_color[i + texture_size] = color;
 
 	});
+}
 
-	state.map_display.set_province_color(prov_color, mode::political);
+void set_political(sys::state& state) {
+	// while the political mode stays open only provinces marked dirty (e.g. by a change of owner) are recolored
+	bool stays_open = state.map_display.active_map_mode == mode::political;
+	std::vector<uint32_t> prov_color;
+	political_colors(state, stays_open ? &state.map_display.province_colors : nullptr, prov_color);
+	if(!prov_color.empty())
+		state.map_display.set_province_color(state, prov_color, mode::political);
 }
 
 // borrowed from http://www.burtleburtle.net/bob/hash/doobs.html
@@ -64,7 +88,7 @@ void set_region(sys::state& state) {
 		prov_color[i + texture_size] = color;
 	});
 
-	state.map_display.set_province_color(prov_color, mode::region);
+	state.map_display.set_province_color(state, prov_color, mode::region);
 }
 
 uint32_t color_gradient(float percent, uint32_t top_color, uint32_t bot_color) {
@@ -155,7 +179,7 @@ void set_population(sys::state& state) {
 		prov_color = get_global_population_color(state);
 	}
 
-	state.map_display.set_province_color(prov_color, mode::population);
+	state.map_display.set_province_color(state, prov_color, mode::population);
 }
 
 std::vector<uint32_t> get_nationality_global_color(sys::state& state) {
@@ -165,26 +189,9 @@ std::vector<uint32_t> get_nationality_global_color(sys::state& state) {
 	std::vector<uint32_t> prov_color(texture_size * 2);
 	state.world.for_each_province([&](dcon::province_id prov_id) {
 		auto id = province::to_map_id(prov_id);
-		float total_pops = state.world.province_get_demographics(prov_id, demographics::total);
-
-		dcon::culture_id primary_culture, secondary_culture;
-		float primary_culture_percent = 0.f, secondary_culture_percent = 0.f;
-
-		state.world.for_each_culture([&](dcon::culture_id culture_id) {
-			auto demo_key = demographics::to_key(state, culture_id);
-			auto volume = state.world.province_get_demographics(prov_id, demo_key);
-			float percent = volume / total_pops;
-
-			if(percent > primary_culture_percent) {
-				secondary_culture = primary_culture;
-				secondary_culture_percent = primary_culture_percent;
-				primary_culture = culture_id;
-				primary_culture_percent = percent;
-			} else if(percent > secondary_culture_percent) {
-				secondary_culture = culture_id;
-				secondary_culture_percent = percent;
-			}
-		});
+		auto primary_culture = state.world.province_get_dominant_culture(prov_id);
+		auto secondary_culture = state.world.province_get_second_culture(prov_id);
+		float secondary_culture_percent = state.world.province_get_second_culture_share(prov_id);
 
 		dcon::culture_fat_id fat_primary_culture = dcon::fatten(state.world, primary_culture);
 
@@ -252,7 +259,7 @@ void set_nationality(sys::state& state) {
 		prov_color = get_nationality_global_color(state);
 	}
 
-	state.map_display.set_province_color(prov_color, mode::nationality);
+	state.map_display.set_province_color(state, prov_color, mode::nationality);
 }
 
 std::vector<uint32_t> get_global_sphere_color(sys::state& state) {
@@ -440,7 +447,7 @@ void set_sphere(sys::state& state) {
 		prov_color = get_global_sphere_color(state);
 	}
 
-	state.map_display.set_province_color(prov_color, mode::sphere);
+	state.map_display.set_province_color(state, prov_color, mode::sphere);
 }
 
 std::vector<uint32_t> get_selected_diplomatic_color(sys::state& state) {
@@ -579,7 +586,7 @@ void set_diplomatic(sys::state& state) {
 		prov_color = get_selected_diplomatic_color(state);
 	}
 
-	state.map_display.set_province_color(prov_color, mode::diplomatic);
+	state.map_display.set_province_color(state, prov_color, mode::diplomatic);
 }
 
 void set_map_mode(sys::state& state, mode mode) {
@@ -1,6 +1,7 @@
 #pragma once
 
 // #include "../gamestate/system_state.hpp"
+#include <vector>
 
 namespace map_mode {
 
@@ -33,4 +34,7 @@ const uint8_t PROV_COLOR_LAYERS = 2;
 
 void set_map_mode(sys::state& state, mode mode);
 void update_map_mode(sys::state& state);
+// fills prov_color with both layers of the political map mode; given the colors of the previous political upload, only the
+// provinces marked dirty since are recolored, and prov_color is left empty when none were
+void political_colors(sys::state& state, std::vector<uint32_t> const* previous, std::vector<uint32_t>& prov_color);
 }
@@ -1,6 +1,7 @@
 #include "nations.hpp"
 #include "system_state.hpp"
 #include "ve_scalar_extensions.hpp"
+#include <algorithm>
 
 namespace nations {
 
@@ -56,13 +57,199 @@ auto occupied_provinces_fraction(sys::state const& state, T ids) {
 	return ve::select(cpc != 0.0f, occ_count / cpc, decltype(cpc)());
 }
 
-void update_national_rankings(sys::state& state) {
-	if(!state.national_rankings_out_of_date)
+namespace {
+
+constexpr inline float industrial_score_scale = 0.1f;
+// when more neighbouring pairs than this have swapped places since the last update, the order is sorted again from scratch
+// instead of being repaired by insertion
+constexpr inline uint32_t incremental_rank_limit = 32;
+
+template<typename F>
+void update_ranking(sys::state& state, std::vector<dcon::nation_id>& order, bool rebuild, F&& before) {
+	if(rebuild) {
+		order.clear();
+		state.world.for_each_nation([&](dcon::nation_id n) {
+			order.push_back(n);
+		});
+		std::sort(order.begin(), order.end(), before);
 		return;
+	}
+
+	uint32_t out_of_place = 0;
+	for(size_t i = 1; i < order.size(); ++i) {
+		if(before(order[i], order[i - 1]))
+			++out_of_place;
+	}
+	if(out_of_place == 0) {
+		return;
+	} else if(out_of_place > incremental_rank_limit) {
+		std::sort(order.begin(), order.end(), before);
+		return;
+	}
+
+	// scores move only a little from day to day, so the old order is almost sorted and each nation that overtook
+	// its neighbour only has a short way to move up
+	for(size_t i = 1; i < order.size(); ++i) {
+		if(before(order[i], order[i - 1])) {
+			auto pos = std::upper_bound(order.begin(), order.begin() + i, order[i], before);
+			std::rotate(pos, order.begin() + i, order.begin() + i + 1);
+		}
+	}
+}
+
+void update_national_scores(sys::state& state) {
+	ve::vectorizable_buffer<float, dcon::nation_id> military_strength = state.world.nation_make_vectorizable_float_buffer();
+
+	// counting provinces and units has to follow relationships, so this part goes nation by nation
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t index) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(index) };
+		military_strength.set(n, 0.0f);
+		if(!state.world.nation_is_valid(n))
+			return;
+
+		uint32_t province_count = 0;
+		for(auto o : state.world.nation_get_province_ownership(n)) {
+			(void)o;
+			++province_count;
+		}
+		state.world.nation_set_owned_province_count(n, uint16_t(province_count));
+
+		float strength = 0.0f;
+		for(auto ac : state.world.nation_get_army_control(n)) {
+			for(auto m : ac.get_army().get_army_membership()) {
+				strength += m.get_regiment().get_strength();
+			}
+		}
+		for(auto nc : state.world.nation_get_navy_control(n)) {
+			for(auto m : nc.get_navy().get_navy_membership()) {
+				strength += m.get_ship().get_strength();
+			}
+		}
+		military_strength.set(n, strength);
+	});
 
+	state.world.execute_serial_over_nation([&](auto ids) {
+		ve::fp_vector output_value;
+		state.world.for_each_commodity([&](dcon::commodity_id c) {
+			output_value = ve::multiply_and_add(state.world.commodity_get_current_price(c), state.world.nation_get_last_production(ids, c), output_value);
+		});
+		state.world.nation_set_industrial_score(ids, ve::to_int(ve::min(output_value * industrial_score_scale, 65535.0f)));
+		state.world.nation_set_military_score(ids, ve::to_int(ve::min(military_strength.get(ids), 65535.0f)));
+	});
+}
+
+}
+
+void update_national_rankings(sys::state& state) {
+	bool rebuild = state.national_rankings_out_of_date;
 	state.national_rankings_out_of_date = false;
 
-	// do something to update the rankings
+	update_national_scores(state);
+
+	// nations that own no provinces always go last, ordered among themselves by id
+	auto exists = [&](dcon::nation_id n) {
+		return state.world.nation_get_owned_province_count(n) != 0;
+	};
+	auto total_score = [&](dcon::nation_id n) {
+		return float(state.world.nation_get_industrial_score(n)) + float(state.world.nation_get_military_score(n)) + state.world.nation_get_prestige(n);
+	};
+
+	concurrency::parallel_for(0, 4, [&](int32_t index) {
+		switch(index) {
+			case 0:
+				update_ranking(state, state.nations_by_rank, rebuild, [&](dcon::nation_id a, dcon::nation_id b) {
+					if(exists(a) != exists(b))
+						return exists(a);
+					// uncivilized nations are ranked below every civilized one
+					if(state.world.nation_get_is_civilized(a) != state.world.nation_get_is_civilized(b))
+						return bool(state.world.nation_get_is_civilized(a));
+					auto a_score = total_score(a);
+					auto b_score = total_score(b);
+					if(a_score != b_score)
+						return a_score > b_score;
+					return a.index() < b.index();
+				});
+				for(size_t i = 0; i < state.nations_by_rank.size(); ++i)
+					state.world.nation_set_rank(state.nations_by_rank[i], uint16_t(i + 1));
+				break;
+			case 1:
+				update_ranking(state, state.nations_by_industrial_score, rebuild, [&](dcon::nation_id a, dcon::nation_id b) {
+					if(exists(a) != exists(b))
+						return exists(a);
+					auto a_score = state.world.nation_get_industrial_score(a);
+					auto b_score = state.world.nation_get_industrial_score(b);
+					if(a_score != b_score)
+						return a_score > b_score;
+					return a.index() < b.index();
+				});
+				for(size_t i = 0; i < state.nations_by_industrial_score.size(); ++i)
+					state.world.nation_set_industrial_rank(state.nations_by_industrial_score[i], uint16_t(i + 1));
+				break;
+			case 2:
+				update_ranking(state, state.nations_by_military_score, rebuild, [&](dcon::nation_id a, dcon::nation_id b) {
+					if(exists(a) != exists(b))
+						return exists(a);
+					auto a_score = state.world.nation_get_military_score(a);
+					auto b_score = state.world.nation_get_military_score(b);
+					if(a_score != b_score)
+						return a_score > b_score;
+					return a.index() < b.index();
+				});
+				for(size_t i = 0; i < state.nations_by_military_score.size(); ++i)
+					state.world.nation_set_military_rank(state.nations_by_military_score[i], uint16_t(i + 1));
+				break;
+			case 3:
+				update_ranking(state, state.nations_by_prestige_score, rebuild, [&](dcon::nation_id a, dcon::nation_id b) {
+					if(exists(a) != exists(b))
+						return exists(a);
+					auto a_score = state.world.nation_get_prestige(a);
+					auto b_score = state.world.nation_get_prestige(b);
+					if(a_score != b_score)
+						return a_score > b_score;
+					return a.index() < b.index();
+				});
+				for(size_t i = 0; i < state.nations_by_prestige_score.size(); ++i)
+					state.world.nation_set_prestige_rank(state.nations_by_prestige_score[i], uint16_t(i + 1));
+				break;
+		}
+	});
+
+	// the scores are recomputed for every nation
+	state.mark_changed(ui::update_domain::nation);
+}
+
+dcon::nation_id create_nation_for_identity(sys::state& state, dcon::national_identity_id ident) {
+	if(auto holder = state.world.national_identity_get_nation_from_identity_holder(ident); holder)
+		return holder;
+
+	auto holder = state.world.create_nation();
+	state.world.force_create_identity_holder(holder, ident);
+	state.national_rankings_out_of_date = true;
+	state.mark_changed(ui::update_domain::nation);
+	return holder;
+}
+
+void destroy_nation(sys::state& state, dcon::nation_id n) {
+	// the provinces still held are given up one by one so that the map and the ui see them change
+	std::vector<dcon::province_id> held;
+	for(auto o : state.world.nation_get_province_ownership(n))
+		held.push_back(o.get_province());
+	for(auto p : held)
+		province::set_province_owner(state, p, dcon::nation_id{});
+	held.clear();
+	for(auto c : state.world.nation_get_province_control(n))
+		held.push_back(c.get_province());
+	for(auto p : held)
+		province::set_province_controller(state, p, dcon::nation_id{});
+
+	state.world.delete_nation(n);
+	state.national_rankings_out_of_date = true;
+	state.mark_changed(ui::update_domain::nation);
+}
+
+bool is_great_power(sys::state const& state, dcon::nation_id n) {
+	auto rank = state.world.nation_get_rank(n);
+	return rank != 0 && rank <= uint16_t(state.defines.great_nations_count) && state.world.nation_get_owned_province_count(n) != 0;
 }
 
 void restore_unsaved_values(sys::state& state) {
@@ -209,7 +209,15 @@ bool can_release_as_vassal(sys::state const& state, dcon::nation_id n, dcon::nat
 bool identity_has_holder(sys::state const& state, dcon::national_identity_id ident);
 dcon::nation_id get_relationship_partner(sys::state const& state, dcon::diplomatic_relation_id rel_id, dcon::nation_id query);
 
+// every nation that comes into being (by release, civil war or from the history files) or disappears (by annexation) has
+// to go through these, so that the rankings are rebuilt
+dcon::nation_id create_nation_for_identity(sys::state& state, dcon::national_identity_id ident); // returns the existing holder if there is one
+void destroy_nation(sys::state& state, dcon::nation_id n);
+
+// recomputes the industrial and military scores and brings the rank arrays in sys::state and the rank properties of each nation up to date
 void update_national_rankings(sys::state& state);
+// reads the rank computed by the last ranking update; no sorting is done here
+bool is_great_power(sys::state const& state, dcon::nation_id n);
 void restore_unsaved_values(sys::state& state);
 void generate_initial_state_instances(sys::state& state);
 
@@ -19,6 +19,7 @@ void initialize_opengl(sys::state& state) {
 	glEnable(GL_LINE_SMOOTH);
 
 	load_shaders(state); // create shaders
+	create_stream_buffer(state);
 	load_global_squares(state); // create various squares to drive the shaders with
 
 	state.flag_type_map.resize(culture::flag_count, 0);
@@ -223,6 +224,72 @@ void load_global_squares(sys::state& state) {
 
 		glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 16, global_sub_square_data, GL_STATIC_DRAW);
 	}
+
+	glGenVertexArrays(1, &state.open_gl.ui_batch_vao);
+	glBindVertexArray(state.open_gl.ui_batch_vao);
+	glEnableVertexAttribArray(0); //position
+	glEnableVertexAttribArray(1); //texture coordinates
+	glBindVertexBuffer(0, state.open_gl.stream.handle, 0, sizeof(batch_vertex));
+	glVertexAttribFormat(0, 2, GL_FLOAT, GL_FALSE, 0); //position
+	glVertexAttribFormat(1, 2, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 2); //texture coordinates
+	glVertexAttribBinding(0, 0);
+	glVertexAttribBinding(1, 0);
+
+	state.open_gl.ui_batch.vertices.reserve(quad_batch_capacity);
+}
+
+void create_stream_buffer(sys::state& state) {
+	auto& stream = state.open_gl.stream;
+	GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	glGenBuffers(1, &stream.handle);
+	glBindBuffer(GL_ARRAY_BUFFER, stream.handle);
+	glBufferStorage(GL_ARRAY_BUFFER, stream_buffer_size, nullptr, flags);
+	stream.mapped = static_cast<uint8_t*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, stream_buffer_size, flags));
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if(!stream.mapped) {
+		notify_user_of_fatal_opengl_error("Unable to map the streaming buffer");
+	}
+}
+
+// places a fence behind the commands issued so far on each region in [first, last) that is not fenced yet
+void fence_stream_regions(stream_buffer& stream, uint32_t first, uint32_t last) {
+	for(uint32_t r = first; r < last; ++r) {
+		if(!stream.fences[r])
+			stream.fences[r] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+}
+
+// waits until the gpu is done with the commands fenced on each region in [first, last)
+void wait_for_stream_regions(stream_buffer& stream, uint32_t first, uint32_t last) {
+	for(uint32_t r = first; r < last; ++r) {
+		if(auto fence = stream.fences[r]; fence) {
+			while(glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {
+			}
+			glDeleteSync(fence);
+			stream.fences[r] = nullptr;
+		}
+	}
+}
+
+stream_allocation allocate_stream(sys::state const& state, uint32_t size, uint32_t alignment) {
+	constexpr uint32_t region_size = stream_buffer_size / stream_buffer_regions;
+	assert(size > 0 && size <= stream_buffer_size);
+
+	auto& stream = state.open_gl.stream;
+	uint32_t start = (stream.head + alignment - 1) / alignment * alignment;
+	// the regions behind the start were last read by commands issued before this call, so they can be fenced now
+	if(start + size > stream_buffer_size) {
+		fence_stream_regions(stream, 0, stream_buffer_regions);
+		start = 0;
+	} else {
+		fence_stream_regions(stream, 0, start / region_size);
+	}
+	wait_for_stream_regions(stream, start / region_size, (start + size - 1) / region_size + 1);
+	stream.head = start + size;
+
+	return stream_allocation{ stream.mapped + start, stream.handle, GLintptr(start) };
 }
 
 
@@ -263,43 +330,83 @@ void bind_vertices_by_rotation(sys::state const& state, ui::rotation r, bool fli
 	}
 }
 
-void render_textured_rect(sys::state const& state, color_modification enabled, float x, float y, float width, float height, GLuint texture_handle, ui::rotation r, bool flipped) {
-	glBindVertexArray(state.open_gl.global_square_vao);
+GLfloat const* square_data_by_rotation(ui::rotation r, bool flipped) {
+	switch(r) {
+		default:
+		case ui::rotation::upright:
+			return flipped ? global_square_flipped_data : global_square_data;
+		case ui::rotation::r90_left:
+			return flipped ? global_square_left_flipped_data : global_square_left_data;
+		case ui::rotation::r90_right:
+			return flipped ? global_square_right_flipped_data : global_square_right_data;
+	}
+}
 
-	bind_vertices_by_rotation(state, r, flipped);
+void flush_ui_batch(sys::state const& state) {
+	auto& batch = state.open_gl.ui_batch;
+	if(batch.vertices.empty())
+		return;
 
-	glUniform4f(parameters::drawing_rectangle, x, y, width, height);
-	//glUniform4f(parameters::drawing_rectangle, 0, 0, width, height);
+	auto count = uint32_t(batch.vertices.size());
+	auto space = allocate_stream(state, uint32_t(sizeof(batch_vertex) * count), sizeof(batch_vertex));
+	memcpy(space.data, batch.vertices.data(), sizeof(batch_vertex) * count);
 
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, texture_handle);
+	glBindVertexArray(state.open_gl.ui_batch_vao);
+	glBindVertexBuffer(0, space.buffer, space.offset, sizeof(batch_vertex));
 
-	GLuint subroutines[2] = { map_color_modification_to_index(enabled), parameters::no_filter };
-	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines); // must set all subroutines in one call
+	glUniform4f(parameters::drawing_rectangle, 0.0f, 0.0f, 1.0f, 1.0f);
+	glUniform3f(parameters::inner_color, batch.color.r, batch.color.g, batch.color.b);
+	glUniform1f(parameters::border_size, batch.border_size);
 
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-}
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, batch.texture);
 
-void render_textured_rect_direct(sys::state const& state, float x, float y, float width, float height, uint32_t handle) {
-	glBindVertexArray(state.open_gl.global_square_vao);
+	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, batch.subroutines); // must set all subroutines in one call
 
-	glBindVertexBuffer(0, state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
+	glDrawArrays(GL_TRIANGLES, 0, GLsizei(count));
 
-	glUniform4f(parameters::drawing_rectangle, x, y, width, height);
+	batch.vertices.clear();
+}
 
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, handle);
+// flushes the pending quads first if they were collected under a different texture or shader state
+void set_batch_state(sys::state const& state, GLuint texture_handle, GLuint color_function, GLuint font_function, color3f const& c, float border_size) {
+	auto& batch = state.open_gl.ui_batch;
+	bool same_state = batch.texture == texture_handle && batch.subroutines[0] == color_function && batch.subroutines[1] == font_function
+		&& batch.color.r == c.r && batch.color.g == c.g && batch.color.b == c.b && batch.border_size == border_size;
+	if(same_state && batch.vertices.size() + 6 <= quad_batch_capacity)
+		return;
+
+	flush_ui_batch(state);
+	batch.texture = texture_handle;
+	batch.subroutines[0] = color_function;
+	batch.subroutines[1] = font_function;
+	batch.color = c;
+	batch.border_size = border_size;
+}
 
-	GLuint subroutines[2] = { parameters::enabled, parameters::no_filter };
-	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines); // must set all subroutines in one call
+// square is laid out like the global square data: four corners of (position, texture coordinates) in triangle fan order
+void push_batch_quad(sys::state const& state, float x, float y, float width, float height, GLfloat const* square) {
+	auto& batch = state.open_gl.ui_batch;
+	for(uint32_t i : { 0, 1, 2, 0, 2, 3 }) {
+		batch.vertices.push_back(batch_vertex{ x + square[i * 4] * width, y + square[i * 4 + 1] * height, square[i * 4 + 2], square[i * 4 + 3] });
+	}
+}
 
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+void render_textured_rect(sys::state const& state, color_modification enabled, float x, float y, float width, float height, GLuint texture_handle, ui::rotation r, bool flipped) {
+	set_batch_state(state, texture_handle, map_color_modification_to_index(enabled), parameters::no_filter, color3f{}, 0.0f);
+	push_batch_quad(state, x, y, width, height, square_data_by_rotation(r, flipped));
+}
+
+void render_textured_rect_direct(sys::state const& state, float x, float y, float width, float height, uint32_t handle) {
+	set_batch_state(state, handle, parameters::enabled, parameters::no_filter, color3f{}, 0.0f);
+	push_batch_quad(state, x, y, width, height, global_square_data);
 }
 
 void render_linegraph(sys::state const& state, color_modification enabled, float x, float y, float width, float height, lines& l) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
-	l.bind_buffer();
+	l.bind_buffer(state);
 
 	glUniform4f(parameters::drawing_rectangle, x, y, width, height);
 	glLineWidth(2.0f);
@@ -311,6 +418,7 @@ void render_linegraph(sys::state const& state, color_modification enabled, float
 }
 
 void render_barchart(sys::state const& state, color_modification enabled, float x, float y, float width, float height, data_texture& t, ui::rotation r, bool flipped) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped);
@@ -319,7 +427,7 @@ void render_barchart(sys::state const& state, color_modification enabled, float
 	glUniform4f(parameters::drawing_rectangle, x, y, width, height);
 
 	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, t.handle());
+	glBindTexture(GL_TEXTURE_2D, t.handle(state));
 
 	GLuint subroutines[2] = { map_color_modification_to_index(enabled), parameters::barchart };
 	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines); // must set all subroutines in one call
@@ -328,6 +436,7 @@ void render_barchart(sys::state const& state, color_modification enabled, float
 }
 
 void render_piechart(sys::state const& state, color_modification enabled, float x, float y, float size, data_texture& t) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	glBindVertexBuffer(0, state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
@@ -335,7 +444,7 @@ void render_piechart(sys::state const& state, color_modification enabled, float
 	glUniform4f(parameters::drawing_rectangle, x, y, size, size);
 
 	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, t.handle());
+	glBindTexture(GL_TEXTURE_2D, t.handle(state));
 
 	GLuint subroutines[2] = { map_color_modification_to_index(enabled), parameters::piechart };
 	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines); // must set all subroutines in one call
@@ -344,6 +453,7 @@ void render_piechart(sys::state const& state, color_modification enabled, float
 }
 
 void render_bordered_rect(sys::state const& state, color_modification enabled, float border_size, float x, float y, float width, float height, GLuint texture_handle, ui::rotation r, bool flipped) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped);
@@ -362,6 +472,7 @@ void render_bordered_rect(sys::state const& state, color_modification enabled, f
 }
 
 void render_masked_rect(sys::state const& state, color_modification enabled, float x, float y, float width, float height, GLuint texture_handle, GLuint mask_texture_handle, ui::rotation r, bool flipped) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped);
@@ -381,6 +492,7 @@ void render_masked_rect(sys::state const& state, color_modification enabled, flo
 }
 
 void render_progress_bar(sys::state const& state, color_modification enabled, float progress, float x, float y, float width, float height, GLuint left_texture_handle, GLuint right_texture_handle, ui::rotation r, bool flipped) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped);
@@ -401,6 +513,7 @@ void render_progress_bar(sys::state const& state, color_modification enabled, fl
 }
 
 void render_tinted_textured_rect(sys::state const& state, float x, float y, float width, float height, float r, float g, float b, GLuint texture_handle, ui::rotation rot, bool flipped) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, rot, flipped);
@@ -418,6 +531,7 @@ void render_tinted_textured_rect(sys::state const& state, float x, float y, floa
 }
 
 void render_subsprite(sys::state const& state, color_modification enabled, int frame, int total_frames, float x, float y, float width, float height, GLuint texture_handle, ui::rotation r, bool flipped) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped);
@@ -437,6 +551,7 @@ void render_subsprite(sys::state const& state, color_modification enabled, int f
 
 
 void render_character(sys::state const& state, char codepoint, color_modification enabled, float x, float y, float size, text::font& f) {
+	flush_ui_batch(state);
 	if(text::win1250toUTF16(codepoint) != ' ') {
 		//f.make_glyph(codepoint);
 
@@ -455,32 +570,30 @@ void render_character(sys::state const& state, char codepoint, color_modificatio
 	}
 }
 
-void internal_text_render(sys::state const& state, char const* codepoints, uint32_t count, float x, float baseline_y, float size, text::font& f) {
+void internal_text_render(sys::state const& state, char const* codepoints, uint32_t count, GLuint color_function, float x, float baseline_y, float size, const color3f& c, text::font& f) {
+	const float border_size = 0.08f * 16.0f / size;
+	auto const& layout = f.get_layout(codepoints, count, int32_t(size));
 	for(uint32_t i = 0; i < count; ++i) {
 		if(text::win1250toUTF16(codepoints[i]) != ' ') {
-			//f.make_glyph(codepoints[i]);
-
-			glBindVertexBuffer(0, state.open_gl.sub_square_buffers[uint8_t(codepoints[i]) & 63], 0, sizeof(GLfloat) * 4);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, f.textures[uint8_t(codepoints[i]) >> 6]);
-
-			glUniform4f(parameters::drawing_rectangle, x + f.glyph_positions[uint8_t(codepoints[i])].x * size / 64.0f, baseline_y + f.glyph_positions[uint8_t(codepoints[i])].y * size / 64.0f, size, size);
-
-			glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+			auto glyph = uint8_t(codepoints[i]);
+			const float cell_x = static_cast<float>(glyph & 7) / 8.0f;
+			const float cell_y = static_cast<float>((glyph >> 3) & 7) / 8.0f;
+			GLfloat const glyph_square[] = {
+				0.0f, 0.0f, cell_x, cell_y,
+				0.0f, 1.0f, cell_x, cell_y + 1.0f / 8.0f,
+				1.0f, 1.0f, cell_x + 1.0f / 8.0f, cell_y + 1.0f / 8.0f,
+				1.0f, 0.0f, cell_x + 1.0f / 8.0f, cell_y
+			};
+
+			set_batch_state(state, f.textures[glyph >> 6], color_function, parameters::filter, c, border_size);
+			push_batch_quad(state, x + layout.glyph_x[i] + f.glyph_positions[glyph].x * size / 64.0f, baseline_y + f.glyph_positions[glyph].y * size / 64.0f, size, size, glyph_square);
 		}
-		x += f.glyph_advances[uint8_t(codepoints[i])] * size / 64.0f + ((i != count - 1) ? f.kerning(codepoints[i], codepoints[i + 1]) * size / 64.0f : 0.0f);
 	}
 }
 
 
 void render_text(sys::state const& state, char const* codepoints, uint32_t count, color_modification enabled, float x, float y, float size, const color3f& c, text::font& f) {
-	GLuint subroutines[2] = { map_color_modification_to_index(enabled), parameters::filter };
-	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines);
-
-	glUniform3f(parameters::inner_color, c.r, c.g, c.b);
-	glUniform1f(parameters::border_size, 0.08f * 16.0f / size);
-
-	internal_text_render(state, codepoints, count, x, y + size, size, f);
+	internal_text_render(state, codepoints, count, map_color_modification_to_index(enabled), x, y + size, size, c, f);
 }
 
 
@@ -492,7 +605,6 @@ void lines::set_y(float* v) {
 		buffer[i * 4 + 2] = 0.5f;
 		buffer[i * 4 + 3] = v[i];
 	}
-	pending_data_update = true;
 }
 
 void lines::set_default_y() {
@@ -502,23 +614,13 @@ void lines::set_default_y() {
 		buffer[i * 4 + 2] = 0.5f;
 		buffer[i * 4 + 3] = 0.5f;
 	}
-	pending_data_update = true;
 }
 
-void lines::bind_buffer() {
-	if(buffer_handle == 0) {
-		glGenBuffers(1, &buffer_handle);
-
-		glBindBuffer(GL_ARRAY_BUFFER, buffer_handle);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * count * 4, nullptr, GL_DYNAMIC_DRAW);
-	}
-	if(buffer && pending_data_update) {
-		glBindBuffer(GL_ARRAY_BUFFER, buffer_handle);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(GLfloat) * count * 4, buffer);
-		pending_data_update = false;
-	}
+void lines::bind_buffer(sys::state const& state) {
+	auto space = allocate_stream(state, uint32_t(sizeof(GLfloat) * count * 4));
+	memcpy(space.data, buffer, sizeof(GLfloat) * count * 4);
 
-	glBindVertexBuffer(0, buffer_handle, 0, sizeof(GLfloat) * 4);
+	glBindVertexBuffer(0, space.buffer, space.offset, sizeof(GLfloat) * 4);
 }
 
 }
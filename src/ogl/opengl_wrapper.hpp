@@ -129,6 +129,45 @@ struct color3f {
 	}
 #endif
 
+	struct batch_vertex {
+		float x = 0.0f; // position, in ui units
+		float y = 0.0f;
+		float u = 0.0f;
+		float v = 0.0f;
+	};
+
+	// Textured rectangles and glyphs that share a texture and the same shader state are collected here and drawn
+	// with a single call when that state changes, when some other kind of element is drawn, or at the end of the frame.
+	// Vertices are stored already transformed to their final position, so the ui shader is run with a unit d_rect.
+	struct quad_batch {
+		std::vector<batch_vertex> vertices;
+		GLuint texture = 0;
+		GLuint subroutines[2] = { 0, 0 };
+		color3f color;
+		float border_size = 0.0f;
+	};
+	inline constexpr uint32_t quad_batch_capacity = 6 * 4096; // in vertices
+
+	// Vertices and texels that change from frame to frame are written straight into one persistently mapped buffer that is
+	// used as a ring. The ring is split into regions: once the writer has moved past a region a fence is placed behind the
+	// commands that read it, and that fence is waited on before the writer comes back to it, so nothing is overwritten
+	// while a draw or upload queued earlier may still read it.
+	inline constexpr uint32_t stream_buffer_size = 8 * 1024 * 1024; // in bytes
+	inline constexpr uint32_t stream_buffer_regions = 4;
+
+	struct stream_buffer {
+		GLuint handle = 0;
+		uint8_t* mapped = nullptr;
+		uint32_t head = 0; // in bytes; where the next allocation starts looking
+		GLsync fences[stream_buffer_regions] = { nullptr }; // null while the region is being written to
+	};
+
+	struct stream_allocation {
+		void* data = nullptr; // write the data here before issuing the commands that read it
+		GLuint buffer = 0;
+		GLintptr offset = 0; // in bytes from the start of buffer; bind or upload from here
+	};
+
 	struct data {
 		tagged_vector<texture, dcon::texture_id> asset_textures;
 
@@ -144,6 +183,11 @@ struct color3f {
 		GLuint global_square_left_flipped_buffer = 0;
 
 		GLuint sub_square_buffers[64] = { 0 };
+
+		GLuint ui_batch_vao = 0;
+		mutable quad_batch ui_batch; // rendering functions only get a const state
+
+		mutable stream_buffer stream;
 	};
 
 	void notify_user_of_fatal_opengl_error(std::string message); // this function calls std::abort
@@ -156,12 +200,15 @@ struct color3f {
 	GLuint create_program(std::string_view vertex_shader, std::string_view fragment_shader);
 	void load_shaders(sys::state& state);
 	void load_global_squares(sys::state& state);
+	void create_stream_buffer(sys::state& state);
+
+	// returns size bytes of the stream buffer, starting at a multiple of alignment; the commands that read the space must be
+	// issued before the next call, and the data must be written again for every use
+	stream_allocation allocate_stream(sys::state const& state, uint32_t size, uint32_t alignment = 16);
 
 	class lines {
 	private:
 		float* buffer = nullptr;
-		GLuint buffer_handle = 0;
-		bool pending_data_update = true;
 	public:
 		uint32_t count = 0;
 
@@ -169,14 +216,12 @@ struct color3f {
 			buffer = new float[count * 4];
 			set_default_y();
 		}
-		lines(lines&& o) noexcept : buffer(o.buffer), buffer_handle(o.buffer_handle), pending_data_update(o.pending_data_update), count(o.count) {
+		lines(lines&& o) noexcept : buffer(o.buffer), count(o.count) {
 			o.buffer = nullptr;
 		}
 		lines& operator=(lines&& o) noexcept {
 			count = o.count;
 			buffer = o.buffer;
-			buffer_handle = o.buffer_handle;
-			pending_data_update = o.pending_data_update;
 
 			o.buffer = nullptr;
 			return *this;
@@ -186,9 +231,11 @@ struct color3f {
 		}
 		void set_default_y();
 		void set_y(float* v);
-		void bind_buffer();
+		// copies the points into the stream buffer and binds them as vertex buffer 0
+		void bind_buffer(sys::state const& state);
 	};
 
+	void flush_ui_batch(sys::state const& state); // must be called before anything else is drawn with the ui shader, and at the end of the frame
 	void render_map(sys::state& state, map::display_data const& map_data);
 	void render_textured_rect(sys::state const& state, color_modification enabled, float x, float y, float width, float height, GLuint texture_handle, ui::rotation r, bool flipped);
 	void render_textured_rect_direct(sys::state const& state, float x, float y, float width, float height, uint32_t handle);
@@ -7,7 +7,7 @@ namespace ogl {
 		assert(state.win_ptr && state.win_ptr->window);
 
 		glfwMakeContextCurrent(state.win_ptr->window);
-		glfwSwapInterval(1); // Vsync option
+		glfwSwapInterval(state.user_settings.vsync ? 1 : 0);
 
 		glewExperimental = GL_TRUE;
 		if (glewInit() != GLEW_OK)
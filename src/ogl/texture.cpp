@@ -524,20 +524,26 @@ data_texture::~data_texture() {
 	delete[] data;
 }
 
-uint32_t data_texture::handle() {
+uint32_t data_texture::handle(sys::state const& state) {
 	if(data && data_updated) {
+		auto space = allocate_stream(state, uint32_t(size * channels));
+		memcpy(space.data, data, size * channels);
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, space.buffer);
 		glBindTexture(GL_TEXTURE_2D, texture_handle);
+		auto offset = reinterpret_cast<void const*>(space.offset);
 		if(channels == 3) {
-			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, 1, GL_RGB, GL_UNSIGNED_BYTE, data);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, 1, GL_RGB, GL_UNSIGNED_BYTE, offset);
 		} else if(channels == 4) {
-			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, 1, GL_RGBA, GL_UNSIGNED_BYTE, offset);
 		} else  if(channels == 2) {
-			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, 1, GL_RG, GL_UNSIGNED_BYTE, data);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, 1, GL_RG, GL_UNSIGNED_BYTE, offset);
 		} else {
-			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, 1, GL_RED, GL_UNSIGNED_BYTE, data);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size, 1, GL_RED, GL_UNSIGNED_BYTE, offset);
 		}
 		data_updated = false;
 		glBindTexture(GL_TEXTURE_2D, 0);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 	}
 	return texture_handle;
 }
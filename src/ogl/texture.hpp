@@ -80,7 +80,8 @@ public:
 	data_texture& operator=(data_texture const&) = delete;
 	data_texture& operator=(data_texture&& other) noexcept;
 
-	GLuint handle();
+	// uploads the data through the stream buffer first if it was updated since the last call
+	GLuint handle(sys::state const& state);
 	~data_texture();
 };
 
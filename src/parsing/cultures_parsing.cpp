@@ -9,7 +9,7 @@ void make_religion(std::string_view name, token_generator& gen, error_handler& e
 	auto name_id = text::find_or_add_key(context.state, name);
 	context.state.world.religion_set_name(new_id, name_id);
 
-	context.map_of_religion_names.insert_or_assign(std::string(name), new_id);
+	context.map_of_religion_names.insert_or_assign(context.key_storage.store(name), new_id);
 
 	religion_context new_context{ new_id, context };
 	parse_religion_def(gen, err, new_context);
@@ -22,7 +22,7 @@ void make_culture_group(std::string_view name, token_generator& gen, error_handl
 	context.state.world.culture_group_set_name(new_id, name_id);
 	context.state.world.culture_group_set_is_overseas(new_id, true);
 
-	context.map_of_culture_group_names.insert_or_assign(std::string(name), new_id);
+	context.map_of_culture_group_names.insert_or_assign(context.key_storage.store(name), new_id);
 	culture_group_context new_context{ new_id, context };
 	parse_culture_group(gen, err, new_context);
 }
@@ -33,7 +33,7 @@ void make_culture(std::string_view name, token_generator& gen, error_handler& er
 	context.outer_context.state.world.culture_set_name(new_id, name_id);
 	context.outer_context.state.world.force_create_culture_group_membership(new_id, context.id);
 
-	context.outer_context.map_of_culture_names.insert_or_assign(std::string(name), new_id);
+	context.outer_context.map_of_culture_names.insert_or_assign(context.outer_context.key_storage.store(name), new_id);
 	culture_context new_context{ new_id, context.outer_context };
 	parse_culture(gen, err, new_context);
 }
@@ -53,7 +53,7 @@ void register_ideology(std::string_view name, token_generator& gen, error_handle
 	auto name_id = text::find_or_add_key(context.outer_context.state, name);
 
 	context.outer_context.state.world.ideology_set_name(new_id, name_id);
-	context.outer_context.map_of_ideologies.insert_or_assign(std::string(name), pending_ideology_content{ gen , new_id });
+	context.outer_context.map_of_ideologies.insert_or_assign(context.outer_context.key_storage.store(name), pending_ideology_content{ gen , new_id });
 
 
 	context.outer_context.state.world.force_create_ideology_group_membership(new_id, context.id);
@@ -66,7 +66,7 @@ void make_ideology_group(std::string_view name, token_generator& gen, error_hand
 	auto name_id = text::find_or_add_key(context.state, name);
 
 	context.state.world.ideology_group_set_name(new_id, name_id);
-	context.map_of_ideology_groups.insert_or_assign(std::string(name), new_id);
+	context.map_of_ideology_groups.insert_or_assign(context.key_storage.store(name), new_id);
 
 	ideology_group_context new_context{ context , new_id };
 	parse_ideology_group(gen, err, new_context);
@@ -104,7 +104,7 @@ void make_issue(std::string_view name, token_generator& gen, error_handler& err,
 			auto name_id = text::find_or_add_key(context.outer_context.state, name);
 
 			context.outer_context.state.world.issue_set_name(new_id, name_id);
-			context.outer_context.map_of_iissues.insert_or_assign(std::string(name), new_id);
+			context.outer_context.map_of_iissues.insert_or_assign(context.outer_context.key_storage.store(name), new_id);
 
 			context.outer_context.state.culture_definitions.party_issues.push_back(new_id);
 
@@ -118,7 +118,7 @@ void make_issue(std::string_view name, token_generator& gen, error_handler& err,
 			auto name_id = text::find_or_add_key(context.outer_context.state, name);
 
 			context.outer_context.state.world.reform_set_name(new_id, name_id);
-			context.outer_context.map_of_reforms.insert_or_assign(std::string(name), new_id);
+			context.outer_context.map_of_reforms.insert_or_assign(context.outer_context.key_storage.store(name), new_id);
 
 			context.outer_context.state.culture_definitions.economic_issues.push_back(new_id);
 
@@ -132,7 +132,7 @@ void make_issue(std::string_view name, token_generator& gen, error_handler& err,
 			auto name_id = text::find_or_add_key(context.outer_context.state, name);
 
 			context.outer_context.state.world.issue_set_name(new_id, name_id);
-			context.outer_context.map_of_iissues.insert_or_assign(std::string(name), new_id);
+			context.outer_context.map_of_iissues.insert_or_assign(context.outer_context.key_storage.store(name), new_id);
 
 			context.outer_context.state.culture_definitions.social_issues.push_back(new_id);
 			issue_context new_context{ context.outer_context, new_id };
@@ -145,7 +145,7 @@ void make_issue(std::string_view name, token_generator& gen, error_handler& err,
 			auto name_id = text::find_or_add_key(context.outer_context.state, name);
 
 			context.outer_context.state.world.issue_set_name(new_id, name_id);
-			context.outer_context.map_of_iissues.insert_or_assign(std::string(name), new_id);
+			context.outer_context.map_of_iissues.insert_or_assign(context.outer_context.key_storage.store(name), new_id);
 
 			context.outer_context.state.culture_definitions.political_issues.push_back(new_id);
 			issue_context new_context{ context.outer_context, new_id };
@@ -158,7 +158,7 @@ void make_issue(std::string_view name, token_generator& gen, error_handler& err,
 			auto name_id = text::find_or_add_key(context.outer_context.state, name);
 
 			context.outer_context.state.world.reform_set_name(new_id, name_id);
-			context.outer_context.map_of_reforms.insert_or_assign(std::string(name), new_id);
+			context.outer_context.map_of_reforms.insert_or_assign(context.outer_context.key_storage.store(name), new_id);
 
 			context.outer_context.state.culture_definitions.military_issues.push_back(new_id);
 
@@ -175,7 +175,7 @@ void register_option(std::string_view name, token_generator& gen, error_handler&
 	auto name_id = text::find_or_add_key(context.outer_context.state, name);
 
 	context.outer_context.state.world.issue_option_set_name(new_id, name_id);
-	context.outer_context.map_of_ioptions.insert_or_assign(std::string(name), pending_option_content{ gen, new_id });
+	context.outer_context.map_of_ioptions.insert_or_assign(context.outer_context.key_storage.store(name), pending_option_content{ gen, new_id });
 
 	bool assigned = false;
 	auto& existing_options = context.outer_context.state.world.issue_get_options(context.id);
@@ -197,7 +197,7 @@ void register_option(std::string_view name, token_generator& gen, error_handler&
 	auto name_id = text::find_or_add_key(context.outer_context.state, name);
 
 	context.outer_context.state.world.reform_option_set_name(new_id, name_id);
-	context.outer_context.map_of_roptions.insert_or_assign(std::string(name), pending_roption_content{ gen, new_id });
+	context.outer_context.map_of_roptions.insert_or_assign(context.outer_context.key_storage.store(name), pending_roption_content{ gen, new_id });
 
 	bool assigned = false;
 	auto& existing_options = context.outer_context.state.world.reform_get_options(context.id);
@@ -223,7 +223,7 @@ void make_government(std::string_view name, token_generator& gen, error_handler&
 	auto name_id = text::find_or_add_key(context.state, name);
 
 	context.state.culture_definitions.governments[new_id].name = name_id;
-	context.map_of_governments.insert_or_assign(std::string(name), new_id);
+	context.map_of_governments.insert_or_assign(context.key_storage.store(name), new_id);
 
 	government_type_context new_context{ context , new_id };
 	parse_government_type(gen, err, new_context);
@@ -236,7 +236,7 @@ void register_crime(std::string_view name, token_generator& gen, error_handler&
 	auto name_id = text::find_or_add_key(context.state, name);
 	context.state.culture_definitions.crimes[new_id].name = name_id;
 
-	context.map_of_crimes.insert_or_assign(std::string(name), pending_crime_content{ gen, new_id });
+	context.map_of_crimes.insert_or_assign(context.key_storage.store(name), pending_crime_content{ gen, new_id });
 
 	gen.discard_group();
 }
@@ -252,7 +252,7 @@ void register_rebel_type(std::string_view name, token_generator& gen, error_hand
 	context.state.world.rebel_type_set_description(new_id, desc_id);
 	context.state.world.rebel_type_set_army_name(new_id, army_id);
 
-	context.map_of_rebeltypes.insert_or_assign(std::string(name), pending_rebel_type_content{ gen, new_id });
+	context.map_of_rebeltypes.insert_or_assign(context.key_storage.store(name), pending_rebel_type_content{ gen, new_id });
 
 	gen.discard_group();
 }
@@ -294,7 +294,7 @@ void read_school_modifier(std::string_view name, token_generator& gen, error_han
 	auto name_id = text::find_or_add_key(context.state, name);
 	auto new_modifier = context.state.world.create_modifier();
 
-	context.map_of_modifiers.insert_or_assign(std::string(name), new_modifier);
+	context.map_of_modifiers.insert_or_assign(context.key_storage.store(name), new_modifier);
 	context.state.world.modifier_set_name(new_modifier, name_id);
 
 	auto school = parse_modifier_base(gen, err, context);
@@ -310,7 +310,7 @@ void register_technology(std::string_view name, token_generator& gen, error_hand
 	auto name_id = text::find_or_add_key(context.state, name);
 	context.state.world.technology_set_name(new_id, name_id);
 
-	context.map_of_technologies.insert_or_assign(std::string(name), pending_tech_content{ gen, new_id });
+	context.map_of_technologies.insert_or_assign(context.key_storage.store(name), pending_tech_content{ gen, new_id });
 	gen.discard_group();
 }
 
@@ -321,12 +321,12 @@ void register_invention(std::string_view name, token_generator& gen, error_handl
 	context.outer_context.state.world.invention_set_name(new_id, name_id);
 	context.outer_context.state.world.invention_set_technology_type(new_id, uint8_t(context.category));
 
-	context.outer_context.map_of_inventions.insert_or_assign(std::string(name), pending_invention_content{ gen, new_id });
+	context.outer_context.map_of_inventions.insert_or_assign(context.outer_context.key_storage.store(name), pending_invention_content{ gen, new_id });
 	gen.discard_group();
 }
 
 void read_promotion_target(std::string_view name, token_generator& gen, error_handler& err, poptype_context& context) {
-	if(auto it = context.outer_context.map_of_poptypes.find(std::string(name)); it != context.outer_context.map_of_poptypes.end()) {
+	if(auto it = context.outer_context.map_of_poptypes.find(name); it != context.outer_context.map_of_poptypes.end()) {
 		trigger_building_context t_context{ context.outer_context, trigger::slot_contents::pop, trigger::slot_contents::nation, trigger::slot_contents::empty };
 		auto result = make_value_modifier(gen, err, t_context);
 		context.outer_context.state.world.pop_type_set_promotion(context.id, it->second, result);
@@ -335,7 +335,7 @@ void read_promotion_target(std::string_view name, token_generator& gen, error_ha
 	}
 }
 void read_pop_ideology(std::string_view name, token_generator& gen, error_handler& err, poptype_context& context) {
-	if(auto it = context.outer_context.map_of_ideologies.find(std::string(name)); it != context.outer_context.map_of_ideologies.end()) {
+	if(auto it = context.outer_context.map_of_ideologies.find(name); it != context.outer_context.map_of_ideologies.end()) {
 		trigger_building_context t_context{ context.outer_context, trigger::slot_contents::pop, trigger::slot_contents::nation, trigger::slot_contents::empty };
 		auto result = make_value_modifier(gen, err, t_context);
 		context.outer_context.state.world.pop_type_set_ideology(context.id, it->second.id, result);
@@ -344,7 +344,7 @@ void read_pop_ideology(std::string_view name, token_generator& gen, error_handle
 	}
 }
 void read_pop_issue(std::string_view name, token_generator& gen, error_handler& err, poptype_context& context) {
-	if(auto it = context.outer_context.map_of_ioptions.find(std::string(name)); it != context.outer_context.map_of_ioptions.end()) {
+	if(auto it = context.outer_context.map_of_ioptions.find(name); it != context.outer_context.map_of_ioptions.end()) {
 		trigger_building_context t_context{ context.outer_context, trigger::slot_contents::pop, trigger::slot_contents::nation, trigger::slot_contents::empty };
 		auto result = make_value_modifier(gen, err, t_context);
 		context.outer_context.state.world.pop_type_set_issues(context.id, it->second.id, result);
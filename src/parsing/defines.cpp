@@ -1,16 +1,138 @@
 #include <string>
 #include <string_view>
+#include <vector>
+#include <algorithm>
 #include <stdlib.h>
 #include <ctype.h>
 #include "defines.hpp"
 #include "parsers.hpp"
 #include "system_state.hpp"
 
-void parsing::defines::assign_define(sys::state& state, int32_t line, std::string_view text, float v, parsers::error_handler& err) {
-#define LUA_DEFINES_LIST_ELEMENT(key, const_value) \
-	if(parsers::is_fixed_token_ci(text.data(), text.data() + text.length(), # key )) key = v;
+namespace parsing {
+namespace {
+
+struct define_entry {
+	std::string_view key;
+	float defines::*member = nullptr;
+};
+
+constexpr define_entry define_entries[] = {
+#define LUA_DEFINES_LIST_ELEMENT(key, const_value) define_entry{ # key, &defines::key },
 	LUA_DEFINES_LIST
 #undef LUA_DEFINES_LIST_ELEMENT
+};
+constexpr uint32_t define_count = uint32_t(sizeof(define_entries) / sizeof(define_entries[0]));
+
+// case insensitive FNV-1a; the keys in the list are all lower case
+uint64_t define_hash(std::string_view text) {
+	uint64_t h = 14695981039346656037ull;
+	for(auto c : text) {
+		h ^= uint64_t(uint8_t(tolower(c)));
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+/*
+* A perfect hash over the define keys (hash and displace): the low bits of the hash pick a bucket, and each bucket
+* stores the displacement that sends all of its keys to otherwise unused slots. A lookup is thus one hash, one probe,
+* and one string comparison, whether or not the key is known. The table is built once, the first time it is needed,
+* and is shared by every later (re)load of the defines.
+*/
+struct define_table {
+	uint32_t bucket_mask = 0;
+	uint32_t slot_mask = 0;
+	std::vector<uint32_t> displacements;
+	std::vector<int16_t> slots;
+
+	static uint32_t slot_for(uint64_t h, uint32_t displacement, uint32_t mask) {
+		auto first = uint32_t(h >> 20);
+		auto step = uint32_t(h >> 42) | 1; // odd, so that the displacements visit every slot
+		return (first + displacement * step) & mask;
+	}
+
+	bool try_build(uint32_t bucket_count, uint32_t slot_count) {
+		bucket_mask = bucket_count - 1;
+		slot_mask = slot_count - 1;
+		displacements.assign(bucket_count, 0);
+		slots.assign(slot_count, int16_t(-1));
+
+		std::vector<uint64_t> hashes(define_count);
+		std::vector<std::vector<int16_t>> buckets(bucket_count);
+		for(uint32_t i = 0; i < define_count; ++i) {
+			hashes[i] = define_hash(define_entries[i].key);
+			buckets[hashes[i] & bucket_mask].push_back(int16_t(i));
+		}
+
+		// the fullest buckets are placed first, while there are still many free slots
+		std::vector<uint32_t> order(bucket_count);
+		for(uint32_t i = 0; i < bucket_count; ++i)
+			order[i] = i;
+		std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+		std::vector<uint32_t> placed;
+		for(auto b : order) {
+			if(buckets[b].empty())
+				break;
+			bool found = false;
+			for(uint32_t d = 0; d < slot_count && !found; ++d) {
+				placed.clear();
+				found = true;
+				for(auto i : buckets[b]) {
+					auto slot = slot_for(hashes[i], d, slot_mask);
+					if(slots[slot] != -1 || std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+						found = false;
+						break;
+					}
+					placed.push_back(slot);
+				}
+				if(found) {
+					displacements[b] = d;
+					for(size_t j = 0; j < placed.size(); ++j)
+						slots[placed[j]] = buckets[b][j];
+				}
+			}
+			if(!found)
+				return false;
+		}
+		return true;
+	}
+
+	define_table() {
+		uint32_t slot_count = 1;
+		while(slot_count < define_count + define_count / 2)
+			slot_count <<= 1;
+		while(!try_build(std::max(slot_count / 4, uint32_t(1)), slot_count))
+			slot_count <<= 1;
+	}
+
+	define_entry const* find(std::string_view text) const {
+		auto h = define_hash(text);
+		auto index = slots[slot_for(h, displacements[h & bucket_mask], slot_mask)];
+		if(index == -1)
+			return nullptr;
+		auto const& entry = define_entries[index];
+		if(entry.key.length() != text.length())
+			return nullptr;
+		for(size_t i = 0; i < text.length(); ++i) {
+			if(tolower(text[i]) != entry.key[i])
+				return nullptr;
+		}
+		return &entry;
+	}
+};
+
+define_table const& get_define_table() {
+	static define_table const table;
+	return table;
+}
+
+}
+}
+
+void parsing::defines::assign_define(sys::state& state, int32_t line, std::string_view text, float v, parsers::error_handler& err) {
+	if(auto entry = get_define_table().find(text); entry)
+		this->*(entry->member) = v;
 }
 
 void parsing::defines::parse_line(sys::state& state, int32_t line, std::string_view data, parsers::error_handler& err) {
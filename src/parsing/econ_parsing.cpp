@@ -10,7 +10,7 @@ void make_good(std::string_view name, token_generator& gen, error_handler& err,
 	context.outer_context.state.world.commodity_set_commodity_group(new_id, uint8_t(context.group));
 	context.outer_context.state.world.commodity_set_is_available_from_start(new_id, true);
 
-	context.outer_context.map_of_commodity_names.insert_or_assign(std::string(name), new_id);
+	context.outer_context.map_of_commodity_names.insert_or_assign(context.outer_context.key_storage.store(name), new_id);
 	good_context new_context{ new_id, context.outer_context };
 	parse_good(gen, err, new_context);
 }
@@ -40,7 +40,7 @@ void building_file::result(std::string_view name, building_definition&& res, err
 		case building_type::factory:
 		{
 			auto factory_id = context.state.world.create_factory_type();
-			context.map_of_factory_names.insert_or_assign(std::string(name), factory_id);
+			context.map_of_factory_names.insert_or_assign(context.key_storage.store(name), factory_id);
 			context.state.world.factory_type_set_name(factory_id, text::find_or_add_key(context.state, name));
 			context.state.world.factory_type_set_construction_time(factory_id, int16_t(res.time));
 			context.state.world.factory_type_set_is_available_from_start(factory_id, res.default_enabled);
@@ -49,7 +49,7 @@ void building_file::result(std::string_view name, building_definition&& res, err
 				context.state.world.factory_type_set_construction_costs(factory_id, cid, res.goods_cost.data[cid]);
 			}
 			if(res.production_type.length() > 0) {
-				context.map_of_production_types.insert_or_assign(std::string(res.production_type), factory_id);
+				context.map_of_production_types.insert_or_assign(context.key_storage.store(res.production_type), factory_id);
 			}
 		}
 			break;
@@ -160,7 +160,7 @@ void make_production_type(std::string_view name, token_generator& gen, error_han
 			context.outer_context.state.economy_definitions.craftsmen_fraction = pt.employees.employees[0].amount;
 			context.found_worker_types = true;
 		}
-		context.templates.insert_or_assign(std::string(name), std::move(pt));
+		context.templates.insert_or_assign(context.outer_context.key_storage.store(name), std::move(pt));
 		if(pt.type_ == production_type_enum::rgo && bool(pt.owner.type)) {
 			context.outer_context.state.culture_definitions.aristocrat = pt.owner.type;
 		}
@@ -186,7 +186,7 @@ void make_production_type(std::string_view name, token_generator& gen, error_han
 		context.outer_context.state.world.commodity_set_artisan_inputs(pt.output_goods_, cset);
 		context.outer_context.state.world.commodity_set_artisan_output_amount(pt.output_goods_, pt.value);
 	} else if(pt.type_ == production_type_enum::factory) {
-		if(auto it = context.outer_context.map_of_production_types.find(std::string(name)); it != context.outer_context.map_of_production_types.end()) {
+		if(auto it = context.outer_context.map_of_production_types.find(name); it != context.outer_context.map_of_production_types.end()) {
 			auto factory_handle = fatten(context.outer_context.state.world, it->second);
 
 			economy::commodity_set cset;
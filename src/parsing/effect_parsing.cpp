@@ -1138,10 +1138,12 @@ void ef_province_event::id(association_type t, int32_t value, error_handler& err
 			it->second.main_slot = trigger::slot_contents::province;
 			it->second.this_slot = trigger::slot_contents::nation;
 			it->second.from_slot = context.this_slot;
+			context.outer_context.provincial_event_worklist.push_back(value);
 		}
 	} else {
 		id_ = context.outer_context.state.world.create_provincial_event();
 		context.outer_context.map_of_provincial_events.insert_or_assign(value, pending_prov_event{ id_, trigger::slot_contents::province, trigger::slot_contents::nation, context.this_slot });
+		context.outer_context.provincial_event_worklist.push_back(value);
 	}
 }
 
@@ -1155,10 +1157,12 @@ void ef_country_event::id(association_type t, int32_t value, error_handler& err,
 			it->second.main_slot = trigger::slot_contents::nation;
 			it->second.this_slot = trigger::slot_contents::nation;
 			it->second.from_slot = context.this_slot;
+			context.outer_context.national_event_worklist.push_back(value);
 		}
 	} else {
 		id_ = context.outer_context.state.world.create_national_event();
 		context.outer_context.map_of_national_events.insert_or_assign(value, pending_nat_event{ id_, trigger::slot_contents::nation, trigger::slot_contents::nation, context.this_slot });
+		context.outer_context.national_event_worklist.push_back(value);
 	}
 }
 
@@ -1185,11 +1189,13 @@ void effect_body::country_event(association_type t, int32_t value, error_handler
 				it->second.main_slot = trigger::slot_contents::nation;
 				it->second.this_slot = trigger::slot_contents::nation;
 				it->second.from_slot = context.this_slot;
+				context.outer_context.national_event_worklist.push_back(value);
 				context.compiled_effect.push_back(trigger::payload(ev_id).value);
 			}
 		} else {
 			auto ev_id = context.outer_context.state.world.create_national_event();
 			context.outer_context.map_of_national_events.insert_or_assign(value, pending_nat_event{ ev_id, trigger::slot_contents::nation, trigger::slot_contents::nation, context.this_slot });
+			context.outer_context.national_event_worklist.push_back(value);
 			context.compiled_effect.push_back(trigger::payload(ev_id).value);
 		}
 	} else if(context.main_slot == trigger::slot_contents::province) {
@@ -1214,11 +1220,13 @@ void effect_body::country_event(association_type t, int32_t value, error_handler
 				it->second.main_slot = trigger::slot_contents::nation;
 				it->second.this_slot = trigger::slot_contents::nation;
 				it->second.from_slot = context.this_slot;
+				context.outer_context.national_event_worklist.push_back(value);
 				context.compiled_effect.push_back(trigger::payload(ev_id).value);
 			}
 		} else {
 			auto ev_id = context.outer_context.state.world.create_national_event();
 			context.outer_context.map_of_national_events.insert_or_assign(value, pending_nat_event{ ev_id, trigger::slot_contents::nation, trigger::slot_contents::nation, context.this_slot });
+			context.outer_context.national_event_worklist.push_back(value);
 			context.compiled_effect.push_back(trigger::payload(ev_id).value);
 		}
 	} else {
@@ -1250,11 +1258,13 @@ void effect_body::province_event(association_type t, int32_t value, error_handle
 				it->second.main_slot = trigger::slot_contents::province;
 				it->second.this_slot = trigger::slot_contents::nation;
 				it->second.from_slot = context.this_slot;
+				context.outer_context.provincial_event_worklist.push_back(value);
 				context.compiled_effect.push_back(trigger::payload(ev_id).value);
 			}
 		} else {
 			auto ev_id = context.outer_context.state.world.create_provincial_event();
 			context.outer_context.map_of_provincial_events.insert_or_assign(value, pending_prov_event{ ev_id, trigger::slot_contents::province, trigger::slot_contents::nation, context.this_slot });
+			context.outer_context.provincial_event_worklist.push_back(value);
 			context.compiled_effect.push_back(trigger::payload(ev_id).value);
 		}
 	} else {
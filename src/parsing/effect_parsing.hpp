@@ -53,28 +53,28 @@ struct ef_trigger_revolt {
 	dcon::ideology_id ideology_;
 	dcon::rebel_type_id type_;
 	void culture(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_culture_names.find(std::string(value)); it != context.outer_context.map_of_culture_names.end()) {
+		if(auto it = context.outer_context.map_of_culture_names.find(value); it != context.outer_context.map_of_culture_names.end()) {
 			culture_ = it->second;
 		} else {
 			err.accumulated_errors += "Invalid culture " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
 		}
 	}
 	void religion(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_religion_names.find(std::string(value)); it != context.outer_context.map_of_religion_names.end()) {
+		if(auto it = context.outer_context.map_of_religion_names.find(value); it != context.outer_context.map_of_religion_names.end()) {
 			religion_ = it->second;
 		} else {
 			err.accumulated_errors += "Invalid religion " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
 		}
 	}
 	void ideology(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ideologies.find(std::string(value)); it != context.outer_context.map_of_ideologies.end()) {
+		if(auto it = context.outer_context.map_of_ideologies.find(value); it != context.outer_context.map_of_ideologies.end()) {
 			ideology_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid ideology " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
 		}
 	}
 	void type(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_rebeltypes.find(std::string(value)); it != context.outer_context.map_of_rebeltypes.end()) {
+		if(auto it = context.outer_context.map_of_rebeltypes.find(value); it != context.outer_context.map_of_rebeltypes.end()) {
 			type_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid rebel type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -97,7 +97,7 @@ struct ef_add_province_modifier {
 	dcon::modifier_id name_;
 	int32_t duration = 0;
 	void name(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+		if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 			name_ = it->second;
 		} else {
 			err.accumulated_errors += "Invalid modifier " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -109,7 +109,7 @@ struct ef_add_country_modifier {
 	dcon::modifier_id name_;
 	int32_t duration = 0;
 	void name(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+		if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 			name_ = it->second;
 		} else {
 			err.accumulated_errors += "Invalid modifier " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -122,7 +122,7 @@ struct ef_casus_belli {
 	std::string_view target;
 	int32_t months = 0;
 	void type(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_cb_types.find(std::string(value)); it != context.outer_context.map_of_cb_types.end()) {
+		if(auto it = context.outer_context.map_of_cb_types.find(value); it != context.outer_context.map_of_cb_types.end()) {
 			type_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid cb type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -135,7 +135,7 @@ struct ef_add_casus_belli {
 	std::string_view target;
 	int32_t months = 0;
 	void type(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_cb_types.find(std::string(value)); it != context.outer_context.map_of_cb_types.end()) {
+		if(auto it = context.outer_context.map_of_cb_types.find(value); it != context.outer_context.map_of_cb_types.end()) {
 			type_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid cb type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -147,7 +147,7 @@ struct ef_remove_casus_belli {
 	dcon::cb_type_id type_;
 	std::string_view target;
 	void type(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_cb_types.find(std::string(value)); it != context.outer_context.map_of_cb_types.end()) {
+		if(auto it = context.outer_context.map_of_cb_types.find(value); it != context.outer_context.map_of_cb_types.end()) {
 			type_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid cb type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -159,7 +159,7 @@ struct ef_this_remove_casus_belli {
 	dcon::cb_type_id type_;
 	std::string_view target;
 	void type(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_cb_types.find(std::string(value)); it != context.outer_context.map_of_cb_types.end()) {
+		if(auto it = context.outer_context.map_of_cb_types.find(value); it != context.outer_context.map_of_cb_types.end()) {
 			type_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid cb type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -185,7 +185,7 @@ struct ef_wargoal {
 		}
 	}
 	void casus_belli(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_cb_types.find(std::string(value)); it != context.outer_context.map_of_cb_types.end()) {
+		if(auto it = context.outer_context.map_of_cb_types.find(value); it != context.outer_context.map_of_cb_types.end()) {
 			casus_belli_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid cb type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -223,7 +223,7 @@ struct ef_sub_unit {
 	std::string_view value;
 	dcon::unit_type_id type_;
 	void type(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_unit_types.find(std::string(v)); it != context.outer_context.map_of_unit_types.end()) {
+		if(auto it = context.outer_context.map_of_unit_types.find(v); it != context.outer_context.map_of_unit_types.end()) {
 			type_ = it->second;
 		} else {
 			err.accumulated_errors += "Invalid unit type " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -235,7 +235,7 @@ struct ef_set_variable {
 	float value = 0.0f;
 	dcon::national_variable_id which_;
 	void which(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		which_ = context.outer_context.get_national_variable(std::string(v));
+		which_ = context.outer_context.get_national_variable(v);
 	}
 	void finish(effect_building_context&) { }
 };
@@ -243,7 +243,7 @@ struct ef_change_variable {
 	float value = 0.0f;
 	dcon::national_variable_id which_;
 	void which(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		which_ = context.outer_context.get_national_variable(std::string(v));
+		which_ = context.outer_context.get_national_variable(v);
 	}
 	void finish(effect_building_context&) { }
 };
@@ -251,7 +251,7 @@ struct ef_ideology {
 	float factor = 0.0f;
 	dcon::ideology_id value_;
 	void value(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ideologies.find(std::string(v)); it != context.outer_context.map_of_ideologies.end()) {
+		if(auto it = context.outer_context.map_of_ideologies.find(v); it != context.outer_context.map_of_ideologies.end()) {
 			value_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid ideology " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -263,7 +263,7 @@ struct ef_dominant_issue {
 	float factor = 0.0f;
 	dcon::issue_option_id value_;
 	void value(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ioptions.find(std::string(v)); it != context.outer_context.map_of_ioptions.end()) {
+		if(auto it = context.outer_context.map_of_ioptions.find(v); it != context.outer_context.map_of_ioptions.end()) {
 			value_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid issue option " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -275,7 +275,7 @@ struct ef_upper_house {
 	float value = 0.0f;
 	dcon::ideology_id ideology_;
 	void ideology(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ideologies.find(std::string(v)); it != context.outer_context.map_of_ideologies.end()) {
+		if(auto it = context.outer_context.map_of_ideologies.find(v); it != context.outer_context.map_of_ideologies.end()) {
 			ideology_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid ideology " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -289,14 +289,14 @@ struct ef_scaled_militancy {
 	dcon::ideology_id ideology_;
 	dcon::issue_option_id issue_;
 	void ideology(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ideologies.find(std::string(v)); it != context.outer_context.map_of_ideologies.end()) {
+		if(auto it = context.outer_context.map_of_ideologies.find(v); it != context.outer_context.map_of_ideologies.end()) {
 			ideology_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid ideology " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
 		}
 	}
 	void issue(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ioptions.find(std::string(v)); it != context.outer_context.map_of_ioptions.end()) {
+		if(auto it = context.outer_context.map_of_ioptions.find(v); it != context.outer_context.map_of_ioptions.end()) {
 			issue_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid issue option " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -310,14 +310,14 @@ struct ef_scaled_consciousness {
 	dcon::ideology_id ideology_;
 	dcon::issue_option_id issue_;
 	void ideology(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ideologies.find(std::string(v)); it != context.outer_context.map_of_ideologies.end()) {
+		if(auto it = context.outer_context.map_of_ideologies.find(v); it != context.outer_context.map_of_ideologies.end()) {
 			ideology_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid ideology " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
 		}
 	}
 	void issue(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ioptions.find(std::string(v)); it != context.outer_context.map_of_ioptions.end()) {
+		if(auto it = context.outer_context.map_of_ioptions.find(v); it != context.outer_context.map_of_ioptions.end()) {
 			issue_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid issue option " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -330,14 +330,14 @@ struct ef_define_general {
 	dcon::leader_trait_id background_;
 	dcon::leader_trait_id personality_;
 	void background(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_leader_traits.find(std::string(v)); it != context.outer_context.map_of_leader_traits.end()) {
+		if(auto it = context.outer_context.map_of_leader_traits.find(v); it != context.outer_context.map_of_leader_traits.end()) {
 			background_ = it->second;
 		} else {
 			err.accumulated_errors += "Invalid leader trait " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
 		}
 	}
 	void personality(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_leader_traits.find(std::string(v)); it != context.outer_context.map_of_leader_traits.end()) {
+		if(auto it = context.outer_context.map_of_leader_traits.find(v); it != context.outer_context.map_of_leader_traits.end()) {
 			personality_ = it->second;
 		} else {
 			err.accumulated_errors += "Invalid leader trait " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -350,14 +350,14 @@ struct ef_define_admiral {
 	dcon::leader_trait_id background_;
 	dcon::leader_trait_id personality_;
 	void background(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_leader_traits.find(std::string(v)); it != context.outer_context.map_of_leader_traits.end()) {
+		if(auto it = context.outer_context.map_of_leader_traits.find(v); it != context.outer_context.map_of_leader_traits.end()) {
 			background_ = it->second;
 		} else {
 			err.accumulated_errors += "Invalid leader trait " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
 		}
 	}
 	void personality(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_leader_traits.find(std::string(v)); it != context.outer_context.map_of_leader_traits.end()) {
+		if(auto it = context.outer_context.map_of_leader_traits.find(v); it != context.outer_context.map_of_leader_traits.end()) {
 			personality_ = it->second;
 		} else {
 			err.accumulated_errors += "Invalid leader trait " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -368,7 +368,7 @@ struct ef_define_admiral {
 struct ef_add_war_goal {
 	dcon::cb_type_id casus_belli_;
 	void casus_belli(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_cb_types.find(std::string(v)); it != context.outer_context.map_of_cb_types.end()) {
+		if(auto it = context.outer_context.map_of_cb_types.find(v); it != context.outer_context.map_of_cb_types.end()) {
 			casus_belli_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid cb type " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -381,14 +381,14 @@ struct ef_move_issue_percentage {
 	dcon::issue_option_id from_;
 	dcon::issue_option_id to_;
 	void from(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ioptions.find(std::string(v)); it != context.outer_context.map_of_ioptions.end()) {
+		if(auto it = context.outer_context.map_of_ioptions.find(v); it != context.outer_context.map_of_ioptions.end()) {
 			from_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid issue option " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
 		}
 	}
 	void to(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ioptions.find(std::string(v)); it != context.outer_context.map_of_ioptions.end()) {
+		if(auto it = context.outer_context.map_of_ioptions.find(v); it != context.outer_context.map_of_ioptions.end()) {
 			to_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid issue option " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -401,7 +401,7 @@ struct ef_party_loyalty {
 	dcon::province_id province_id_;
 	dcon::ideology_id ideology_;
 	void ideology(association_type t, std::string_view v, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ideologies.find(std::string(v)); it != context.outer_context.map_of_ideologies.end()) {
+		if(auto it = context.outer_context.map_of_ideologies.find(v); it != context.outer_context.map_of_ideologies.end()) {
 			ideology_ = it->second.id;
 		} else {
 			err.accumulated_errors += "Invalid ideology " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -619,7 +619,7 @@ struct effect_body {
 		context.compiled_effect.push_back(trigger::payload(name).value);
 	}
 	void trade_goods(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_commodity_names.find(std::string(value)); it != context.outer_context.map_of_commodity_names.end()) {
+		if(auto it = context.outer_context.map_of_commodity_names.find(value); it != context.outer_context.map_of_commodity_names.end()) {
 			if(context.main_slot == trigger::slot_contents::province) {
 				context.compiled_effect.push_back(uint16_t(effect::trade_goods));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
@@ -636,7 +636,7 @@ struct effect_body {
 		if(context.main_slot == trigger::slot_contents::nation) {
 			if(is_fixed_token_ci(value.data(), value.data() + value.length(), "union")) {
 				context.compiled_effect.push_back(uint16_t(effect::add_accepted_culture_union | effect::no_payload));
-			} else if(auto it = context.outer_context.map_of_culture_names.find(std::string(value)); it != context.outer_context.map_of_culture_names.end()) {
+			} else if(auto it = context.outer_context.map_of_culture_names.find(value); it != context.outer_context.map_of_culture_names.end()) {
 				context.compiled_effect.push_back(uint16_t(effect::add_accepted_culture));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
 			} else {
@@ -671,7 +671,7 @@ struct effect_body {
 					return;
 				}
 			} else {
-				if(auto it = context.outer_context.map_of_culture_names.find(std::string(value)); it != context.outer_context.map_of_culture_names.end()) {
+				if(auto it = context.outer_context.map_of_culture_names.find(value); it != context.outer_context.map_of_culture_names.end()) {
 					context.compiled_effect.push_back(uint16_t(effect::primary_culture));
 					context.compiled_effect.push_back(trigger::payload(it->second).value);
 				} else {
@@ -685,7 +685,7 @@ struct effect_body {
 	}
 	void remove_accepted_culture(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
 		if(context.main_slot == trigger::slot_contents::nation) {
-			if(auto it = context.outer_context.map_of_culture_names.find(std::string(value)); it != context.outer_context.map_of_culture_names.end()) {
+			if(auto it = context.outer_context.map_of_culture_names.find(value); it != context.outer_context.map_of_culture_names.end()) {
 				context.compiled_effect.push_back(uint16_t(effect::remove_accepted_culture));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
 			} else {
@@ -708,7 +708,7 @@ struct effect_body {
 	}
 	void religion(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
 		if(context.main_slot == trigger::slot_contents::nation) {
-			if(auto it = context.outer_context.map_of_religion_names.find(std::string(value)); it != context.outer_context.map_of_religion_names.end()) {
+			if(auto it = context.outer_context.map_of_religion_names.find(value); it != context.outer_context.map_of_religion_names.end()) {
 				context.compiled_effect.push_back(uint16_t(effect::religion));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
 			} else {
@@ -747,7 +747,7 @@ struct effect_body {
 	}
 	void tech_school(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
 		if(context.main_slot == trigger::slot_contents::nation) {
-			if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+			if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 				context.compiled_effect.push_back(uint16_t(effect::tech_school));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
 			} else {
@@ -768,7 +768,7 @@ struct effect_body {
 					err.accumulated_errors += "government = reb effect used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 					return;
 				}
-			} else if(auto it = context.outer_context.map_of_governments.find(std::string(value)); it != context.outer_context.map_of_governments.end()) {
+			} else if(auto it = context.outer_context.map_of_governments.find(value); it != context.outer_context.map_of_governments.end()) {
 				context.compiled_effect.push_back(uint16_t(effect::government));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
 			} else {
@@ -857,10 +857,10 @@ struct effect_body {
 	void set_country_flag(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
 		if(context.main_slot == trigger::slot_contents::nation) {
 			context.compiled_effect.push_back(uint16_t(effect::set_country_flag));
-			context.compiled_effect.push_back(trigger::payload(context.outer_context.get_national_flag(std::string(value))).value);
+			context.compiled_effect.push_back(trigger::payload(context.outer_context.get_national_flag(value)).value);
 		} else if(context.main_slot == trigger::slot_contents::province) {
 			context.compiled_effect.push_back(uint16_t(effect::set_country_flag_province));
-			context.compiled_effect.push_back(trigger::payload(context.outer_context.get_national_flag(std::string(value))).value);
+			context.compiled_effect.push_back(trigger::payload(context.outer_context.get_national_flag(value)).value);
 		} else {
 			err.accumulated_errors += "set_country_flag effect used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 			return;
@@ -869,7 +869,7 @@ struct effect_body {
 	void clr_country_flag(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
 		if(context.main_slot == trigger::slot_contents::nation) {
 			context.compiled_effect.push_back(uint16_t(effect::clr_country_flag));
-			context.compiled_effect.push_back(trigger::payload(context.outer_context.get_national_flag(std::string(value))).value);
+			context.compiled_effect.push_back(trigger::payload(context.outer_context.get_national_flag(value)).value);
 		} else {
 			err.accumulated_errors += "clr_country_flag effect used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 			return;
@@ -1353,7 +1353,7 @@ struct effect_body {
 		}
 	}
 	void enable_ideology(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ideologies.find(std::string(value)); it != context.outer_context.map_of_ideologies.end()) {
+		if(auto it = context.outer_context.map_of_ideologies.find(value); it != context.outer_context.map_of_ideologies.end()) {
 			context.compiled_effect.push_back(uint16_t(effect::enable_ideology));
 			context.compiled_effect.push_back(trigger::payload(it->second.id).value);
 		} else {
@@ -1363,7 +1363,7 @@ struct effect_body {
 	}
 	void ruling_party_ideology(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
 		if(context.main_slot == trigger::slot_contents::nation) {
-			if(auto it = context.outer_context.map_of_ideologies.find(std::string(value)); it != context.outer_context.map_of_ideologies.end()) {
+			if(auto it = context.outer_context.map_of_ideologies.find(value); it != context.outer_context.map_of_ideologies.end()) {
 				context.compiled_effect.push_back(uint16_t(effect::ruling_party_ideology));
 				context.compiled_effect.push_back(trigger::payload(it->second.id).value);
 			} else {
@@ -1386,7 +1386,7 @@ struct effect_body {
 	}
 	void remove_province_modifier(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
 		if(context.main_slot == trigger::slot_contents::province) {
-			if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+			if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 				context.compiled_effect.push_back(uint16_t(effect::remove_province_modifier));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
 			} else {
@@ -1400,7 +1400,7 @@ struct effect_body {
 	}
 	void remove_country_modifier(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
 		if(context.main_slot == trigger::slot_contents::nation) {
-			if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+			if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 				context.compiled_effect.push_back(uint16_t(effect::remove_country_modifier));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
 			} else {
@@ -1518,14 +1518,14 @@ struct effect_body {
 	}
 	void set_global_flag(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
 		context.compiled_effect.push_back(uint16_t(effect::set_global_flag));
-		context.compiled_effect.push_back(trigger::payload(context.outer_context.get_global_flag(std::string(value))).value);
+		context.compiled_effect.push_back(trigger::payload(context.outer_context.get_global_flag(value)).value);
 	}
 	void clr_global_flag(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
 		context.compiled_effect.push_back(uint16_t(effect::clr_global_flag));
-		context.compiled_effect.push_back(trigger::payload(context.outer_context.get_global_flag(std::string(value))).value);
+		context.compiled_effect.push_back(trigger::payload(context.outer_context.get_global_flag(value)).value);
 	}
 	void nationalvalue(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+		if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_effect.push_back(uint16_t(effect::nationalvalue_nation));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
@@ -1561,7 +1561,7 @@ struct effect_body {
 		}
 	}
 	void social_reform(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ioptions.find(std::string(value)); it != context.outer_context.map_of_ioptions.end()) {
+		if(auto it = context.outer_context.map_of_ioptions.find(value); it != context.outer_context.map_of_ioptions.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_effect.push_back(uint16_t(effect::social_reform));
 				context.compiled_effect.push_back(trigger::payload(it->second.id).value);
@@ -1575,7 +1575,7 @@ struct effect_body {
 		}
 	}
 	void political_reform(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_ioptions.find(std::string(value)); it != context.outer_context.map_of_ioptions.end()) {
+		if(auto it = context.outer_context.map_of_ioptions.find(value); it != context.outer_context.map_of_ioptions.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_effect.push_back(uint16_t(effect::political_reform));
 				context.compiled_effect.push_back(trigger::payload(it->second.id).value);
@@ -1629,7 +1629,7 @@ struct effect_body {
 		}
 	}
 	void pop_type(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_poptypes.find(std::string(value)); it != context.outer_context.map_of_poptypes.end()) {
+		if(auto it = context.outer_context.map_of_poptypes.find(value); it != context.outer_context.map_of_poptypes.end()) {
 			if(context.main_slot == trigger::slot_contents::pop) {
 				context.compiled_effect.push_back(uint16_t(effect::pop_type));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
@@ -1664,7 +1664,7 @@ struct effect_body {
 		}
 	}
 	void military_reform(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_roptions.find(std::string(value)); it != context.outer_context.map_of_roptions.end()) {
+		if(auto it = context.outer_context.map_of_roptions.find(value); it != context.outer_context.map_of_roptions.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_effect.push_back(uint16_t(effect::military_reform));
 				context.compiled_effect.push_back(trigger::payload(it->second.id).value);
@@ -1678,7 +1678,7 @@ struct effect_body {
 		}
 	}
 	void economic_reform(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_roptions.find(std::string(value)); it != context.outer_context.map_of_roptions.end()) {
+		if(auto it = context.outer_context.map_of_roptions.find(value); it != context.outer_context.map_of_roptions.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_effect.push_back(uint16_t(effect::economic_reform));
 				context.compiled_effect.push_back(trigger::payload(it->second.id).value);
@@ -1710,7 +1710,7 @@ struct effect_body {
 		}
 	}
 	void add_crime(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_crimes.find(std::string(value)); it != context.outer_context.map_of_crimes.end()) {
+		if(auto it = context.outer_context.map_of_crimes.find(value); it != context.outer_context.map_of_crimes.end()) {
 			if(context.main_slot == trigger::slot_contents::province) {
 				context.compiled_effect.push_back(uint16_t(effect::add_crime));
 				context.compiled_effect.push_back(trigger::payload(it->second.id).value);
@@ -1734,7 +1734,7 @@ struct effect_body {
 		}
 	}
 	void build_factory_in_capital_state(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_factory_names.find(std::string(value)); it != context.outer_context.map_of_factory_names.end()) {
+		if(auto it = context.outer_context.map_of_factory_names.find(value); it != context.outer_context.map_of_factory_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_effect.push_back(uint16_t(effect::build_factory_in_capital_state));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
@@ -1748,7 +1748,7 @@ struct effect_body {
 		}
 	}
 	void activate_technology(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
-		if(auto it = context.outer_context.map_of_technologies.find(std::string(value)); it != context.outer_context.map_of_technologies.end()) {
+		if(auto it = context.outer_context.map_of_technologies.find(value); it != context.outer_context.map_of_technologies.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_effect.push_back(uint16_t(effect::activate_technology));
 				context.compiled_effect.push_back(trigger::payload(it->second.id).value);
@@ -1756,7 +1756,7 @@ struct effect_body {
 				err.accumulated_errors += "activate_technology effect used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 				return;
 			}
-		} else if(auto itb = context.outer_context.map_of_inventions.find(std::string(value)); itb != context.outer_context.map_of_inventions.end()) {
+		} else if(auto itb = context.outer_context.map_of_inventions.find(value); itb != context.outer_context.map_of_inventions.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_effect.push_back(uint16_t(effect::activate_invention));
 				context.compiled_effect.push_back(trigger::payload(itb->second.id).value);
@@ -1852,7 +1852,7 @@ struct effect_body {
 	}
 	void add_province_modifier(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
 		if(context.main_slot == trigger::slot_contents::province) {
-			if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+			if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 				context.compiled_effect.push_back(uint16_t(effect::add_province_modifier_no_duration));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
 			} else {
@@ -1866,7 +1866,7 @@ struct effect_body {
 	}
 	void add_country_modifier(association_type t, std::string_view value, error_handler& err, int32_t line, effect_building_context& context) {
 		if(context.main_slot == trigger::slot_contents::nation) {
-			if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+			if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 				context.compiled_effect.push_back(uint16_t(effect::add_country_modifier_no_duration));
 				context.compiled_effect.push_back(trigger::payload(it->second).value);
 			} else {
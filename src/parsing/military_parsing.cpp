@@ -4,7 +4,7 @@
 namespace parsers {
 
 void register_cb_type(std::string_view name, token_generator& gen, error_handler& err, scenario_building_context& context) {
-	auto existing_it = context.map_of_cb_types.find(std::string(name));
+	auto existing_it = context.map_of_cb_types.find(name);
 
 	auto id = [&]() {
 		if(existing_it != context.map_of_cb_types.end()) {
@@ -12,7 +12,7 @@ void register_cb_type(std::string_view name, token_generator& gen, error_handler
 			return existing_it->second.id;
 		}
 		auto new_id = context.state.world.create_cb_type();
-		context.map_of_cb_types.insert_or_assign(std::string(name), pending_cb_content{ gen, new_id });
+		context.map_of_cb_types.insert_or_assign(context.key_storage.store(name), pending_cb_content{ gen, new_id });
 		return new_id;
 	}();
 
@@ -42,7 +42,7 @@ void make_trait(std::string_view name, token_generator& gen, error_handler& err,
 	auto name_id = text::find_or_add_key(context.state, name);
 
 	context.state.world.leader_trait_set_name(new_id, name_id);
-	context.map_of_leader_traits.insert_or_assign(std::string(name), new_id);
+	context.map_of_leader_traits.insert_or_assign(context.key_storage.store(name), new_id);
 
 	trait_context new_context{ context , new_id };
 	parse_trait(gen, err, new_context);
@@ -64,7 +64,7 @@ void make_base_units(scenario_building_context& context) {
 		context.state.military_definitions.unit_base_definitions.back().name = name_id;
 		context.state.military_definitions.unit_base_definitions.back().is_land = true;
 		context.state.military_definitions.unit_base_definitions.back().active = false;
-		context.map_of_unit_types.insert_or_assign(std::string("army_base"), army_base_id);
+		context.map_of_unit_types.insert_or_assign(std::string_view("army_base"), army_base_id);
 		context.state.military_definitions.base_army_unit = army_base_id;
 	}
 	{
@@ -75,7 +75,7 @@ void make_base_units(scenario_building_context& context) {
 		context.state.military_definitions.unit_base_definitions.back().name = name_id;
 		context.state.military_definitions.unit_base_definitions.back().is_land = false;
 		context.state.military_definitions.unit_base_definitions.back().active = false;
-		context.map_of_unit_types.insert_or_assign(std::string("navy_base"), navy_base_id);
+		context.map_of_unit_types.insert_or_assign(std::string_view("navy_base"), navy_base_id);
 		context.state.military_definitions.base_naval_unit = navy_base_id;
 	}
 }
@@ -89,7 +89,7 @@ void make_unit(std::string_view name, token_generator& gen, error_handler& err,
 
 	context.state.military_definitions.unit_base_definitions.back() = parsers::parse_unit_definition(gen, err, context);
 
-	context.map_of_unit_types.insert_or_assign(std::string(name), new_id);
+	context.map_of_unit_types.insert_or_assign(context.key_storage.store(name), new_id);
 }
 
 dcon::trigger_key cb_allowed_states(token_generator& gen, error_handler& err, individual_cb_context& context) {
@@ -35,7 +35,7 @@ void triggered_modifier::finish(triggered_modifier_context& context) {
 	this->convert_to_national_mod();
 	context.outer_context.state.world.modifier_set_province_values(modifier_id, constructed_definition);
 
-	context.outer_context.map_of_modifiers.insert_or_assign(std::string(context.name), modifier_id);
+	context.outer_context.map_of_modifiers.insert_or_assign(context.outer_context.key_storage.store(context.name), modifier_id);
 
 	context.outer_context.state.national_definitions.triggered_modifiers[context.index].linked_modifier = modifier_id;
 }
@@ -64,7 +64,7 @@ void make_national_value(std::string_view name, token_generator& gen, error_hand
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string(name), new_modifier);
+	context.map_of_modifiers.insert_or_assign(context.key_storage.store(name), new_modifier);
 }
 
 void m_very_easy_player(token_generator& gen, error_handler& err, scenario_building_context& context) {
@@ -79,7 +79,7 @@ void m_very_easy_player(token_generator& gen, error_handler& err, scenario_build
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("very_easy_player"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("very_easy_player"), new_modifier);
 	context.state.national_definitions.very_easy_player = new_modifier;
 }
 
@@ -95,7 +95,7 @@ void m_easy_player(token_generator& gen, error_handler& err, scenario_building_c
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("easy_player"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("easy_player"), new_modifier);
 	context.state.national_definitions.easy_player = new_modifier;
 }
 
@@ -111,7 +111,7 @@ void m_hard_player(token_generator& gen, error_handler& err, scenario_building_c
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("hard_player"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("hard_player"), new_modifier);
 	context.state.national_definitions.hard_player = new_modifier;
 }
 
@@ -127,7 +127,7 @@ void m_very_hard_player(token_generator& gen, error_handler& err, scenario_build
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("very_hard_player"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("very_hard_player"), new_modifier);
 	context.state.national_definitions.very_hard_player = new_modifier;
 }
 
@@ -143,7 +143,7 @@ void m_very_easy_ai(token_generator& gen, error_handler& err, scenario_building_
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("very_easy_ai"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("very_easy_ai"), new_modifier);
 	context.state.national_definitions.very_easy_ai = new_modifier;
 }
 
@@ -159,7 +159,7 @@ void m_easy_ai(token_generator& gen, error_handler& err, scenario_building_conte
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("easy_ai"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("easy_ai"), new_modifier);
 	context.state.national_definitions.easy_ai = new_modifier;
 }
 
@@ -175,7 +175,7 @@ void m_hard_ai(token_generator& gen, error_handler& err, scenario_building_conte
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("hard_ai"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("hard_ai"), new_modifier);
 	context.state.national_definitions.hard_ai = new_modifier;
 }
 
@@ -191,7 +191,7 @@ void m_very_hard_ai(token_generator& gen, error_handler& err, scenario_building_
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("very_hard_ai"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("very_hard_ai"), new_modifier);
 	context.state.national_definitions.very_hard_ai = new_modifier;
 }
 
@@ -207,7 +207,7 @@ void m_overseas(token_generator& gen, error_handler& err, scenario_building_cont
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("overseas"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("overseas"), new_modifier);
 	context.state.national_definitions.overseas = new_modifier;
 }
 
@@ -223,7 +223,7 @@ void m_coastal(token_generator& gen, error_handler& err, scenario_building_conte
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("coastal"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("coastal"), new_modifier);
 	context.state.national_definitions.coastal = new_modifier;
 }
 
@@ -239,7 +239,7 @@ void m_non_coastal(token_generator& gen, error_handler& err, scenario_building_c
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("non_coastal"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("non_coastal"), new_modifier);
 	context.state.national_definitions.non_coastal = new_modifier;
 }
 
@@ -255,7 +255,7 @@ void m_coastal_sea(token_generator& gen, error_handler& err, scenario_building_c
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("coastal_sea"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("coastal_sea"), new_modifier);
 	context.state.national_definitions.coastal_sea = new_modifier;
 }
 
@@ -271,7 +271,7 @@ void m_sea_zone(token_generator& gen, error_handler& err, scenario_building_cont
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("sea_zone"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("sea_zone"), new_modifier);
 	context.state.national_definitions.sea_zone = new_modifier;
 }
 
@@ -287,7 +287,7 @@ void m_land_province(token_generator& gen, error_handler& err, scenario_building
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("land_province"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("land_province"), new_modifier);
 	context.state.national_definitions.land_province = new_modifier;
 }
 
@@ -303,7 +303,7 @@ void m_blockaded(token_generator& gen, error_handler& err, scenario_building_con
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("blockaded"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("blockaded"), new_modifier);
 	context.state.national_definitions.blockaded = new_modifier;
 }
 
@@ -319,7 +319,7 @@ void m_no_adjacent_controlled(token_generator& gen, error_handler& err, scenario
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("no_adjacent_controlled"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("no_adjacent_controlled"), new_modifier);
 	context.state.national_definitions.no_adjacent_controlled = new_modifier;
 }
 
@@ -335,7 +335,7 @@ void m_core(token_generator& gen, error_handler& err, scenario_building_context&
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("core"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("core"), new_modifier);
 	context.state.national_definitions.core = new_modifier;
 }
 
@@ -351,7 +351,7 @@ void m_has_siege(token_generator& gen, error_handler& err, scenario_building_con
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("has_siege"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("has_siege"), new_modifier);
 	context.state.national_definitions.has_siege = new_modifier;
 }
 
@@ -367,7 +367,7 @@ void m_occupied(token_generator& gen, error_handler& err, scenario_building_cont
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("occupied"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("occupied"), new_modifier);
 	context.state.national_definitions.occupied = new_modifier;
 }
 
@@ -383,7 +383,7 @@ void m_nationalism(token_generator& gen, error_handler& err, scenario_building_c
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("nationalism"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("nationalism"), new_modifier);
 	context.state.national_definitions.nationalism = new_modifier;
 }
 
@@ -399,7 +399,7 @@ void m_infrastructure(token_generator& gen, error_handler& err, scenario_buildin
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("infrastructure"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("infrastructure"), new_modifier);
 	context.state.national_definitions.infrastructure = new_modifier;
 }
 
@@ -415,7 +415,7 @@ void m_base_values(token_generator& gen, error_handler& err, scenario_building_c
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("base_values"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("base_values"), new_modifier);
 	context.state.national_definitions.base_values = new_modifier;
 }
 
@@ -431,7 +431,7 @@ void m_war(token_generator& gen, error_handler& err, scenario_building_context&
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("war"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("war"), new_modifier);
 	context.state.national_definitions.war = new_modifier;
 }
 
@@ -447,7 +447,7 @@ void m_peace(token_generator& gen, error_handler& err, scenario_building_context
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("peace"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("peace"), new_modifier);
 	context.state.national_definitions.peace = new_modifier;
 }
 
@@ -463,7 +463,7 @@ void m_disarming(token_generator& gen, error_handler& err, scenario_building_con
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("disarming"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("disarming"), new_modifier);
 	context.state.national_definitions.disarming = new_modifier;
 }
 
@@ -479,7 +479,7 @@ void m_war_exhaustion(token_generator& gen, error_handler& err, scenario_buildin
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("war_exhaustion"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("war_exhaustion"), new_modifier);
 	context.state.national_definitions.war_exhaustion = new_modifier;
 }
 
@@ -495,7 +495,7 @@ void m_badboy(token_generator& gen, error_handler& err, scenario_building_contex
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("badboy"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("badboy"), new_modifier);
 	context.state.national_definitions.badboy = new_modifier;
 }
 
@@ -511,7 +511,7 @@ void m_debt_default_to(token_generator& gen, error_handler& err, scenario_buildi
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("debt_default_to"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("debt_default_to"), new_modifier);
 	context.state.national_definitions.debt_default_to = new_modifier;
 }
 
@@ -527,7 +527,7 @@ void m_bad_debter(token_generator& gen, error_handler& err, scenario_building_co
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("bad_debter"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("bad_debter"), new_modifier);
 	context.state.national_definitions.bad_debter = new_modifier;
 }
 
@@ -543,7 +543,7 @@ void m_great_power(token_generator& gen, error_handler& err, scenario_building_c
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("great_power"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("great_power"), new_modifier);
 	context.state.national_definitions.great_power = new_modifier;
 }
 
@@ -559,7 +559,7 @@ void m_second_power(token_generator& gen, error_handler& err, scenario_building_
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("second_power"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("second_power"), new_modifier);
 	context.state.national_definitions.second_power = new_modifier;
 }
 
@@ -575,7 +575,7 @@ void m_civ_nation(token_generator& gen, error_handler& err, scenario_building_co
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("civ_nation"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("civ_nation"), new_modifier);
 	context.state.national_definitions.civ_nation = new_modifier;
 }
 
@@ -591,7 +591,7 @@ void m_unciv_nation(token_generator& gen, error_handler& err, scenario_building_
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("unciv_nation"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("unciv_nation"), new_modifier);
 	context.state.national_definitions.unciv_nation = new_modifier;
 }
 
@@ -607,7 +607,7 @@ void m_average_literacy(token_generator& gen, error_handler& err, scenario_build
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("average_literacy"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("average_literacy"), new_modifier);
 	context.state.national_definitions.average_literacy = new_modifier;
 }
 
@@ -623,7 +623,7 @@ void m_plurality(token_generator& gen, error_handler& err, scenario_building_con
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("plurality"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("plurality"), new_modifier);
 	context.state.national_definitions.plurality = new_modifier;
 }
 
@@ -639,7 +639,7 @@ void m_generalised_debt_default(token_generator& gen, error_handler& err, scenar
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("generalised_debt_default"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("generalised_debt_default"), new_modifier);
 	context.state.national_definitions.generalised_debt_default = new_modifier;
 }
 
@@ -655,7 +655,7 @@ void m_total_occupation(token_generator& gen, error_handler& err, scenario_build
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("total_occupation"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("total_occupation"), new_modifier);
 	context.state.national_definitions.total_occupation = new_modifier;
 }
 
@@ -671,7 +671,7 @@ void m_total_blockaded(token_generator& gen, error_handler& err, scenario_buildi
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("total_blockaded"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("total_blockaded"), new_modifier);
 	context.state.national_definitions.total_blockaded = new_modifier;
 }
 
@@ -687,7 +687,7 @@ void m_in_bankrupcy(token_generator& gen, error_handler& err, scenario_building_
 	context.state.world.modifier_set_name(new_modifier, name_id);
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string("in_bankrupcy"), new_modifier);
+	context.map_of_modifiers.insert_or_assign(std::string_view("in_bankrupcy"), new_modifier);
 	context.state.national_definitions.in_bankrupcy = new_modifier;
 }
 
@@ -709,7 +709,7 @@ void make_event_modifier(std::string_view name, token_generator& gen, error_hand
 	parsed_modifier.convert_to_national_mod();
 	context.state.world.modifier_set_national_values(new_modifier, parsed_modifier.constructed_definition);
 	
-	context.map_of_modifiers.insert_or_assign(std::string(name), new_modifier);
+	context.map_of_modifiers.insert_or_assign(context.key_storage.store(name), new_modifier);
 }
 
 void make_party(token_generator& gen, error_handler& err, country_file_context& context) {
@@ -726,7 +726,7 @@ void make_party(token_generator& gen, error_handler& err, country_file_context&
 }
 
 void make_unit_names_list(std::string_view name, token_generator& gen, error_handler& err, country_file_context& context) {
-	if(auto it = context.outer_context.map_of_unit_types.find(std::string(name)); it != context.outer_context.map_of_unit_types.end()) {
+	if(auto it = context.outer_context.map_of_unit_types.find(name); it != context.outer_context.map_of_unit_types.end()) {
 		auto found_type = it->second;
 		unit_names_context new_context{ context.outer_context, context.id, found_type };
 		parse_unit_names_list(gen, err, new_context);
@@ -738,35 +738,35 @@ void make_unit_names_list(std::string_view name, token_generator& gen, error_han
 	
 }
 
-dcon::national_variable_id scenario_building_context::get_national_variable(std::string const& name) {
+dcon::national_variable_id scenario_building_context::get_national_variable(std::string_view name) {
 	if(auto it = map_of_national_variables.find(name); it != map_of_national_variables.end()) {
 		return it->second;
 	} else {
 		dcon::national_variable_id new_id = dcon::national_variable_id(dcon::national_variable_id::value_base_t(state.national_definitions.num_allocated_national_variables));
 		++state.national_definitions.num_allocated_national_variables;
-		map_of_national_variables.insert_or_assign(name, new_id);
+		map_of_national_variables.insert_or_assign(key_storage.store(name), new_id);
 		return new_id;
 	}
 }
 
-dcon::national_flag_id scenario_building_context::get_national_flag(std::string const& name) {
+dcon::national_flag_id scenario_building_context::get_national_flag(std::string_view name) {
 	if(auto it = map_of_national_flags.find(name); it != map_of_national_flags.end()) {
 		return it->second;
 	} else {
 		dcon::national_flag_id new_id = dcon::national_flag_id(dcon::national_flag_id::value_base_t(state.national_definitions.num_allocated_national_flags));
 		++state.national_definitions.num_allocated_national_flags;
-		map_of_national_flags.insert_or_assign(name, new_id);
+		map_of_national_flags.insert_or_assign(key_storage.store(name), new_id);
 		return new_id;
 	}
 }
 
-dcon::global_flag_id scenario_building_context::get_global_flag(std::string const& name) {
+dcon::global_flag_id scenario_building_context::get_global_flag(std::string_view name) {
 	if(auto it = map_of_global_flags.find(name); it != map_of_global_flags.end()) {
 		return it->second;
 	} else {
 		dcon::global_flag_id new_id = dcon::global_flag_id(dcon::global_flag_id::value_base_t(state.national_definitions.num_allocated_global_flags));
 		++state.national_definitions.num_allocated_global_flags;
-		map_of_global_flags.insert_or_assign(name, new_id);
+		map_of_global_flags.insert_or_assign(key_storage.store(name), new_id);
 		return new_id;
 	}
 }
@@ -967,58 +967,75 @@ sys::event_option make_event_option(token_generator& gen, error_handler& err, ev
 	
 	return sys::event_option{opt_result.name_, opt_result.ai_chance, effect_id };
 }
+// the event bodies are compiled one at a time: compiling a body does not only produce trigger and effect data, it also
+// allocates the ids of the events it references (and pushes them onto the worklists), registers flags and variables,
+// and adds text keys, value modifiers and errors, all of which live in the shared context and state
 void commit_pending_events(error_handler& err, scenario_building_context& context) {
-	int32_t count = 0;
-	do {
-		count = 0;
-		auto fixed_size = context.map_of_national_events.size();
-		for(auto& e : context.map_of_national_events) {
-			if(!e.second.processed && e.second.text_assigned && e.second.main_slot != trigger::slot_contents::empty) {
-				e.second.processed = true;
-				++count;
-
-				if(!bool(e.second.id))
-					e.second.id = context.state.world.create_national_event();
-
-				event_building_context e_context{ context, e.second.main_slot, e.second.this_slot, e.second.from_slot };
-				auto event_result = parse_generic_event(e.second.generator_state, err, e_context);
-
-				auto fid = fatten(context.state.world, e.second.id);
-				fid.set_description(event_result.desc_);
-				fid.set_name(event_result.title_);
-				fid.set_image_name(event_result.picture_);
-				fid.set_immediate_effect(event_result.immediate_);
-				fid.set_is_major(event_result.major);
-				fid.get_options() = event_result.options;
-
-				if(context.map_of_national_events.size() != fixed_size)
-					break;
-			}
-		}
-
-		fixed_size = context.map_of_provincial_events.size();
-		for(auto& e : context.map_of_provincial_events) {
-			if(!e.second.processed && e.second.text_assigned && e.second.main_slot != trigger::slot_contents::empty) {
-				e.second.processed = true;
-				++count;
+	auto& national_list = context.national_event_worklist;
+	auto& provincial_list = context.provincial_event_worklist;
 
-				if(!bool(e.second.id))
-					e.second.id = context.state.world.create_provincial_event();
-
-				event_building_context e_context{ context, e.second.main_slot, e.second.this_slot, e.second.from_slot };
-				auto event_result = parse_generic_event(e.second.generator_state, err, e_context);
-
-				auto fid = fatten(context.state.world, e.second.id);
-				fid.set_description(event_result.desc_);
-				fid.set_name(event_result.title_);
-				fid.set_image_name(event_result.picture_);
-				fid.get_options() = event_result.options;
+	// every event that is already ready starts the list; parsing an event body pushes the events that it gives a scope to
+	national_list.clear();
+	provincial_list.clear();
+	for(auto& e : context.map_of_national_events) {
+		if(e.second.text_assigned && e.second.main_slot != trigger::slot_contents::empty)
+			national_list.push_back(e.first);
+	}
+	for(auto& e : context.map_of_provincial_events) {
+		if(e.second.text_assigned && e.second.main_slot != trigger::slot_contents::empty)
+			provincial_list.push_back(e.first);
+	}
 
-				if(context.map_of_provincial_events.size() != fixed_size)
-					break;
-			}
+	// parsing an event may insert into the maps, so nothing refers into them across a call to parse_generic_event
+	while(!national_list.empty() || !provincial_list.empty()) {
+		if(!national_list.empty()) {
+			auto key = national_list.back();
+			national_list.pop_back();
+
+			auto it = context.map_of_national_events.find(key);
+			if(it == context.map_of_national_events.end() || it->second.processed || !it->second.text_assigned || it->second.main_slot == trigger::slot_contents::empty)
+				continue;
+
+			it->second.processed = true;
+			if(!bool(it->second.id))
+				it->second.id = context.state.world.create_national_event();
+
+			auto id = it->second.id;
+			auto generator_state = it->second.generator_state;
+			event_building_context e_context{ context, it->second.main_slot, it->second.this_slot, it->second.from_slot };
+			auto event_result = parse_generic_event(generator_state, err, e_context);
+
+			auto fid = fatten(context.state.world, id);
+			fid.set_description(event_result.desc_);
+			fid.set_name(event_result.title_);
+			fid.set_image_name(event_result.picture_);
+			fid.set_immediate_effect(event_result.immediate_);
+			fid.set_is_major(event_result.major);
+			fid.get_options() = event_result.options;
+		} else {
+			auto key = provincial_list.back();
+			provincial_list.pop_back();
+
+			auto it = context.map_of_provincial_events.find(key);
+			if(it == context.map_of_provincial_events.end() || it->second.processed || !it->second.text_assigned || it->second.main_slot == trigger::slot_contents::empty)
+				continue;
+
+			it->second.processed = true;
+			if(!bool(it->second.id))
+				it->second.id = context.state.world.create_provincial_event();
+
+			auto id = it->second.id;
+			auto generator_state = it->second.generator_state;
+			event_building_context e_context{ context, it->second.main_slot, it->second.this_slot, it->second.from_slot };
+			auto event_result = parse_generic_event(generator_state, err, e_context);
+
+			auto fid = fatten(context.state.world, id);
+			fid.set_description(event_result.desc_);
+			fid.set_name(event_result.title_);
+			fid.set_image_name(event_result.picture_);
+			fid.get_options() = event_result.options;
 		}
-	} while(count > 0);
+	}
 
 	for(auto& e : context.map_of_national_events) {
 		if(!e.second.text_assigned) {
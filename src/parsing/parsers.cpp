@@ -1,6 +1,7 @@
 #include "parsers.hpp"
 #include "nations.hpp"
 #include <charconv>
+#include <cstring>
 #include <algorithm>
 
 namespace parsers {
@@ -397,4 +398,23 @@ namespace parsers {
 		}
 		return std::string_view(start, end - start);
 	}
+
+	std::string_view string_arena::store(std::string_view s) {
+		if(s.length() > remaining) {
+			if(s.length() > block_size / 4) { // large strings get a block of their own, so the current block is not abandoned
+				blocks.push_back(std::unique_ptr<char[]>(new char[s.length()]));
+				std::memcpy(blocks.back().get(), s.data(), s.length());
+				return std::string_view(blocks.back().get(), s.length());
+			}
+			blocks.push_back(std::unique_ptr<char[]>(new char[block_size]));
+			current = blocks.back().get();
+			remaining = block_size;
+		}
+		if(s.length() != 0)
+			std::memcpy(current, s.data(), s.length());
+		std::string_view result(current, s.length());
+		current += s.length();
+		remaining -= s.length();
+		return result;
+	}
 }
@@ -3,6 +3,8 @@
 #include <string_view>
 #include <stdint.h>
 #include <string>
+#include <vector>
+#include <memory>
 #include "date_interface.hpp"
 
 /*
@@ -111,6 +113,22 @@ namespace parsers {
 		}
 	};
 
+	// Hands out copies of strings carved from large blocks. The blocks are only freed together, when the arena is destroyed,
+	// so the views it returns can serve as the keys of maps that do not outlive it.
+	class string_arena {
+		static constexpr size_t block_size = 64 * 1024;
+
+		std::vector<std::unique_ptr<char[]>> blocks;
+		char* current = nullptr;
+		size_t remaining = 0;
+	public:
+		string_arena() { }
+		string_arena(string_arena const&) = delete;
+		string_arena& operator=(string_arena const&) = delete;
+
+		std::string_view store(std::string_view s);
+	};
+
 	bool float_from_chars(char const* start, char const* end, float& float_out); // returns true on success
 	bool double_from_chars(char const* start, char const* end, double& dbl_out); // returns true on success
 
@@ -178,7 +178,7 @@ void government_type::flagtype(association_type, std::string_view value, error_h
 
 void government_type::any_value(std::string_view text, association_type, bool value, error_handler& err, int32_t line, government_type_context& context) {
 	if(value) {
-		auto found_ideology = context.outer_context.map_of_ideologies.find(std::string(text));
+		auto found_ideology = context.outer_context.map_of_ideologies.find(text);
 		if(found_ideology != context.outer_context.map_of_ideologies.end()) {
 			context.outer_context.state.culture_definitions.governments[context.id].ideologies_allowed |= ::culture::to_bits(found_ideology->second.id);
 		} else {
@@ -190,7 +190,7 @@ void government_type::any_value(std::string_view text, association_type, bool va
 
 void cb_list::free_value(std::string_view text, error_handler& err, int32_t line, scenario_building_context& context) {
 	dcon::cb_type_id new_id = context.state.world.create_cb_type();
-	context.map_of_cb_types.insert_or_assign(std::string(text), pending_cb_content{ token_generator{ }, new_id });
+	context.map_of_cb_types.insert_or_assign(context.key_storage.store(text), pending_cb_content{ token_generator{ }, new_id });
 }
 
 void trait::organisation(association_type, float value, error_handler& err, int32_t line, trait_context& context) {
@@ -264,11 +264,11 @@ void tech_folder_list::free_value(std::string_view name, error_handler& err, int
 	auto name_id = text::find_or_add_key(context.outer_context.state, name);
 	auto cindex = context.outer_context.state.culture_definitions.tech_folders.size();
 	context.outer_context.state.culture_definitions.tech_folders.push_back(::culture::folder_info{ name_id , context.category });
-	context.outer_context.map_of_tech_folders.insert_or_assign(std::string(name), int32_t(cindex));
+	context.outer_context.map_of_tech_folders.insert_or_assign(context.outer_context.key_storage.store(name), int32_t(cindex));
 }
 
 void commodity_set::any_value(std::string_view name, association_type, float value, error_handler& err, int32_t line, scenario_building_context& context) {
-	auto found_commodity = context.map_of_commodity_names.find(std::string(name));
+	auto found_commodity = context.map_of_commodity_names.find(name);
 	if(found_commodity != context.map_of_commodity_names.end()) {
 		if(num_added < int32_t(economy::commodity_set::set_size)) {
 			commodity_amounts[num_added] = value;
@@ -283,7 +283,7 @@ void commodity_set::any_value(std::string_view name, association_type, float val
 }
 
 void party::ideology(association_type, std::string_view text, error_handler& err, int32_t line, party_context& context) {
-	if(auto it = context.outer_context.map_of_ideologies.find(std::string(text)); it != context.outer_context.map_of_ideologies.end()) {
+	if(auto it = context.outer_context.map_of_ideologies.find(text); it != context.outer_context.map_of_ideologies.end()) {
 		context.outer_context.state.world.political_party_set_ideology(context.id, it->second.id);
 	} else {
 		err.accumulated_errors += std::string(text) + " is not a valid ideology (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -306,9 +306,9 @@ void party::end_date(association_type, sys::year_month_day ymd, error_handler& e
 }
 
 void party::any_value(std::string_view issue, association_type, std::string_view option, error_handler& err, int32_t line, party_context& context) {
-	if(auto it = context.outer_context.map_of_iissues.find(std::string(issue)); it != context.outer_context.map_of_iissues.end()) {
+	if(auto it = context.outer_context.map_of_iissues.find(issue); it != context.outer_context.map_of_iissues.end()) {
 		if(it->second.index() < int32_t(context.outer_context.state.culture_definitions.party_issues.size())) {
-			if(auto oit = context.outer_context.map_of_ioptions.find(std::string(option)); oit != context.outer_context.map_of_ioptions.end()) {
+			if(auto oit = context.outer_context.map_of_ioptions.find(option); oit != context.outer_context.map_of_ioptions.end()) {
 				context.outer_context.state.world.political_party_set_party_issues(context.id, it->second, oit->second.id);
 			} else {
 				err.accumulated_errors += std::string(option) + " is not a valid option name (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -338,7 +338,7 @@ void unit_names_list::free_value(std::string_view text, error_handler& err, int3
 }
 
 void pop_history_definition::culture(association_type, std::string_view value, error_handler& err, int32_t line, pop_history_province_context& context) {
-	if(auto it = context.outer_context.map_of_culture_names.find(std::string(value)); it != context.outer_context.map_of_culture_names.end()) {
+	if(auto it = context.outer_context.map_of_culture_names.find(value); it != context.outer_context.map_of_culture_names.end()) {
 		cul_id = it->second;
 	} else {
 		err.accumulated_errors += "Invalid culture " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -346,7 +346,7 @@ void pop_history_definition::culture(association_type, std::string_view value, e
 }
 
 void pop_history_definition::religion(association_type, std::string_view value, error_handler& err, int32_t line, pop_history_province_context& context) {
-	if(auto it = context.outer_context.map_of_religion_names.find(std::string(value)); it != context.outer_context.map_of_religion_names.end()) {
+	if(auto it = context.outer_context.map_of_religion_names.find(value); it != context.outer_context.map_of_religion_names.end()) {
 		rel_id = it->second;
 	} else {
 		err.accumulated_errors += "Invalid religion " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -354,7 +354,7 @@ void pop_history_definition::religion(association_type, std::string_view value,
 }
 
 void pop_history_definition::rebel_type(association_type, std::string_view value, error_handler& err, int32_t line, pop_history_province_context& context) {
-	if(auto it = context.outer_context.map_of_rebeltypes.find(std::string(value)); it != context.outer_context.map_of_rebeltypes.end()) {
+	if(auto it = context.outer_context.map_of_rebeltypes.find(value); it != context.outer_context.map_of_rebeltypes.end()) {
 		reb_id = it->second.id;
 	} else {
 		err.accumulated_errors += "Invalid rebel type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -363,7 +363,7 @@ void pop_history_definition::rebel_type(association_type, std::string_view value
 
 void pop_province_list::any_group(std::string_view type, pop_history_definition const& def, error_handler& err, int32_t line, pop_history_province_context& context) {
 	dcon::pop_type_id ptype;
-	if(auto it = context.outer_context.map_of_poptypes.find(std::string(type)); it != context.outer_context.map_of_poptypes.end()) {
+	if(auto it = context.outer_context.map_of_poptypes.find(type); it != context.outer_context.map_of_poptypes.end()) {
 		ptype = it->second;
 	} else {
 		err.accumulated_errors += "Invalid pop type " + std::string(type) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -384,6 +384,7 @@ void pop_province_list::any_group(std::string_view type, pop_history_definition
 	new_pop.set_militancy(def.militancy);
 	new_pop.set_rebel_group(def.reb_id);
 	context.outer_context.state.world.force_create_pop_location(new_pop, context.id);
+	context.outer_context.state.pop_ranges_out_of_date = true;
 }
 
 void poptype_file::sprite(association_type, int32_t value, error_handler& err, int32_t line, poptype_context& context) {
@@ -1166,7 +1167,7 @@ void national_focus::flashpoint_tension(association_type, float value, error_han
 }
 
 void national_focus::ideology(association_type, std::string_view value, error_handler& err, int32_t line, national_focus_context& context) {
-	if(auto it = context.outer_context.map_of_ideologies.find(std::string(value)); it != context.outer_context.map_of_ideologies.end()) {
+	if(auto it = context.outer_context.map_of_ideologies.find(value); it != context.outer_context.map_of_ideologies.end()) {
 		context.outer_context.state.world.national_focus_set_ideology(context.id, it->second.id);
 	} else {
 		err.accumulated_errors += "Invalid ideology " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1222,7 +1223,7 @@ void main_pop_type_file::conversion_chance(dcon::value_modifier_key value, error
 }
 
 void tech_rgo_goods_output::any_value(std::string_view label, association_type, float value, error_handler& err, int32_t line, tech_context& context) {
-	if(auto it = context.outer_context.map_of_commodity_names.find(std::string(label)); it != context.outer_context.map_of_commodity_names.end()) {
+	if(auto it = context.outer_context.map_of_commodity_names.find(label); it != context.outer_context.map_of_commodity_names.end()) {
 		context.outer_context.state.world.technology_get_rgo_goods_output(context.id).push_back(sys::commodity_modifier{ value, it->second });
 	} else {
 		err.accumulated_errors += "Invalid commodity " + std::string(label) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1230,7 +1231,7 @@ void tech_rgo_goods_output::any_value(std::string_view label, association_type,
 }
 
 void tech_fac_goods_output::any_value(std::string_view label, association_type, float value, error_handler& err, int32_t line, tech_context& context) {
-	if(auto it = context.outer_context.map_of_commodity_names.find(std::string(label)); it != context.outer_context.map_of_commodity_names.end()) {
+	if(auto it = context.outer_context.map_of_commodity_names.find(label); it != context.outer_context.map_of_commodity_names.end()) {
 		context.outer_context.state.world.technology_get_factory_goods_output(context.id).push_back(sys::commodity_modifier{ value, it->second });
 	} else {
 		err.accumulated_errors += "Invalid commodity " + std::string(label) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1238,7 +1239,7 @@ void tech_fac_goods_output::any_value(std::string_view label, association_type,
 }
 
 void tech_rgo_size::any_value(std::string_view label, association_type, float value, error_handler& err, int32_t line, tech_context& context) {
-	if(auto it = context.outer_context.map_of_commodity_names.find(std::string(label)); it != context.outer_context.map_of_commodity_names.end()) {
+	if(auto it = context.outer_context.map_of_commodity_names.find(label); it != context.outer_context.map_of_commodity_names.end()) {
 		context.outer_context.state.world.technology_get_rgo_size(context.id).push_back(sys::commodity_modifier{ value, it->second });
 	} else {
 		err.accumulated_errors += "Invalid commodity " + std::string(label) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1246,7 +1247,7 @@ void tech_rgo_size::any_value(std::string_view label, association_type, float va
 }
 
 void technology_contents::any_group(std::string_view label, unit_modifier_body const& value, error_handler& err, int32_t line, tech_context& context) {
-	if(auto it = context.outer_context.map_of_unit_types.find(std::string(label)); it != context.outer_context.map_of_unit_types.end()) {
+	if(auto it = context.outer_context.map_of_unit_types.find(label); it != context.outer_context.map_of_unit_types.end()) {
 		sys::unit_modifier temp = value;
 		temp.type = it->second;
 		context.outer_context.state.world.technology_get_modified_units(context.id).push_back(temp);
@@ -1268,7 +1269,7 @@ void technology_contents::cost(association_type, int32_t value, error_handler& e
 }
 
 void technology_contents::area(association_type, std::string_view value, error_handler& err, int32_t line, tech_context& context) {
-	if(auto it = context.outer_context.map_of_tech_folders.find(std::string(value)); it != context.outer_context.map_of_tech_folders.end()) {
+	if(auto it = context.outer_context.map_of_tech_folders.find(value); it != context.outer_context.map_of_tech_folders.end()) {
 		context.outer_context.state.world.technology_set_folder_index(context.id, uint8_t(it->second));
 	} else {
 		err.accumulated_errors += "Invalid technology folder name " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1304,7 +1305,7 @@ void technology_contents::colonial_points(association_type, int32_t value, error
 }
 
 void technology_contents::activate_unit(association_type, std::string_view value, error_handler& err, int32_t line, tech_context& context) {
-	if(auto it = context.outer_context.map_of_unit_types.find(std::string(value)); it != context.outer_context.map_of_unit_types.end()) {
+	if(auto it = context.outer_context.map_of_unit_types.find(value); it != context.outer_context.map_of_unit_types.end()) {
 		context.outer_context.state.world.technology_set_activate_unit(context.id, it->second, true);
 	} else {
 		err.accumulated_errors += "Invalid unit type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1318,7 +1319,7 @@ void technology_contents::activate_building(association_type, std::string_view v
 		context.outer_context.state.world.technology_set_increase_railroad(context.id, true);
 	} else if(is_fixed_token_ci(value.data(), value.data() + value.length(), "naval_base")) {
 		context.outer_context.state.world.technology_set_increase_naval_base(context.id, true);
-	} else if(auto it = context.outer_context.map_of_factory_names.find(std::string(value)); it != context.outer_context.map_of_factory_names.end()) {
+	} else if(auto it = context.outer_context.map_of_factory_names.find(value); it != context.outer_context.map_of_factory_names.end()) {
 		context.outer_context.state.world.technology_set_activate_building(context.id, it->second, true);
 	} else {
 		err.accumulated_errors += "Invalid factory type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1326,7 +1327,7 @@ void technology_contents::activate_building(association_type, std::string_view v
 }
 
 void inv_rgo_goods_output::any_value(std::string_view label, association_type, float value, error_handler& err, int32_t line, invention_context& context) {
-	if(auto it = context.outer_context.map_of_commodity_names.find(std::string(label)); it != context.outer_context.map_of_commodity_names.end()) {
+	if(auto it = context.outer_context.map_of_commodity_names.find(label); it != context.outer_context.map_of_commodity_names.end()) {
 		context.outer_context.state.world.invention_get_rgo_goods_output(context.id).push_back(sys::commodity_modifier{ value, it->second });
 	} else {
 		err.accumulated_errors += "Invalid commodity " + std::string(label) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1334,7 +1335,7 @@ void inv_rgo_goods_output::any_value(std::string_view label, association_type, f
 }
 
 void inv_fac_goods_output::any_value(std::string_view label, association_type, float value, error_handler& err, int32_t line, invention_context& context) {
-	if(auto it = context.outer_context.map_of_commodity_names.find(std::string(label)); it != context.outer_context.map_of_commodity_names.end()) {
+	if(auto it = context.outer_context.map_of_commodity_names.find(label); it != context.outer_context.map_of_commodity_names.end()) {
 		context.outer_context.state.world.invention_get_factory_goods_output(context.id).push_back(sys::commodity_modifier{ value, it->second });
 	} else {
 		err.accumulated_errors += "Invalid commodity " + std::string(label) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1342,7 +1343,7 @@ void inv_fac_goods_output::any_value(std::string_view label, association_type, f
 }
 
 void inv_fac_goods_throughput::any_value(std::string_view label, association_type, float value, error_handler& err, int32_t line, invention_context& context) {
-	if(auto it = context.outer_context.map_of_commodity_names.find(std::string(label)); it != context.outer_context.map_of_commodity_names.end()) {
+	if(auto it = context.outer_context.map_of_commodity_names.find(label); it != context.outer_context.map_of_commodity_names.end()) {
 		context.outer_context.state.world.invention_get_factory_goods_throughput(context.id).push_back(sys::commodity_modifier{ value, it->second });
 	} else {
 		err.accumulated_errors += "Invalid commodity " + std::string(label) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1352,7 +1353,7 @@ void inv_fac_goods_throughput::any_value(std::string_view label, association_typ
 void inv_rebel_org_gain::faction(association_type, std::string_view v, error_handler& err, int32_t line, invention_context& context) {
 	if(is_fixed_token_ci(v.data(), v.data() + v.size(), "all")) {
 		// do nothing
-	} else if(auto it = context.outer_context.map_of_rebeltypes.find(std::string(v)); it != context.outer_context.map_of_rebeltypes.end()) {
+	} else if(auto it = context.outer_context.map_of_rebeltypes.find(v); it != context.outer_context.map_of_rebeltypes.end()) {
 		faction_ = it->second.id;
 	} else {
 		err.accumulated_errors += "Invalid rebel type " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1360,7 +1361,7 @@ void inv_rebel_org_gain::faction(association_type, std::string_view v, error_han
 }
 
 void inv_effect::any_group(std::string_view label, unit_modifier_body const& value, error_handler& err, int32_t line, invention_context& context) {
-	if(auto it = context.outer_context.map_of_unit_types.find(std::string(label)); it != context.outer_context.map_of_unit_types.end()) {
+	if(auto it = context.outer_context.map_of_unit_types.find(label); it != context.outer_context.map_of_unit_types.end()) {
 		sys::unit_modifier temp = value;
 		temp.type = it->second;
 		context.outer_context.state.world.invention_get_modified_units(context.id).push_back(temp);
@@ -1370,7 +1371,7 @@ void inv_effect::any_group(std::string_view label, unit_modifier_body const& val
 }
 
 void inv_effect::activate_unit(association_type, std::string_view value, error_handler& err, int32_t line, invention_context& context) {
-	if(auto it = context.outer_context.map_of_unit_types.find(std::string(value)); it != context.outer_context.map_of_unit_types.end()) {
+	if(auto it = context.outer_context.map_of_unit_types.find(value); it != context.outer_context.map_of_unit_types.end()) {
 		context.outer_context.state.world.invention_set_activate_unit(context.id, it->second, true);
 	} else {
 		err.accumulated_errors += "Invalid unit type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1378,7 +1379,7 @@ void inv_effect::activate_unit(association_type, std::string_view value, error_h
 }
 
 void inv_effect::activate_building(association_type, std::string_view value, error_handler& err, int32_t line, invention_context& context) {
-	if(auto it = context.outer_context.map_of_factory_names.find(std::string(value)); it != context.outer_context.map_of_factory_names.end()) {
+	if(auto it = context.outer_context.map_of_factory_names.find(value); it != context.outer_context.map_of_factory_names.end()) {
 		context.outer_context.state.world.invention_set_activate_building(context.id, it->second, true);
 	} else {
 		err.accumulated_errors += "Invalid factory type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1390,7 +1391,7 @@ void inv_effect::shared_prestige(association_type, float value, error_handler& e
 }
 
 void inv_effect::enable_crime(association_type, std::string_view value, error_handler& err, int32_t line, invention_context& context) {
-	if(auto it = context.outer_context.map_of_crimes.find(std::string(value)); it != context.outer_context.map_of_crimes.end()) {
+	if(auto it = context.outer_context.map_of_crimes.find(value); it != context.outer_context.map_of_crimes.end()) {
 		context.outer_context.state.world.invention_set_activate_crime(context.id, it->second.id, true);
 	} else {
 		err.accumulated_errors += "Invalid crime " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1617,8 +1618,8 @@ void s_on_my_factories_nationalized::any_value(std::string_view chance, associat
 }
 
 void rebel_gov_list::any_value(std::string_view from_gov, association_type, std::string_view to_gov, error_handler& err, int32_t line, rebel_context& context) {
-	if(auto frit = context.outer_context.map_of_governments.find(std::string(from_gov)); frit != context.outer_context.map_of_governments.end()) {
-		if(auto toit = context.outer_context.map_of_governments.find(std::string(to_gov)); toit != context.outer_context.map_of_governments.end()) {
+	if(auto frit = context.outer_context.map_of_governments.find(from_gov); frit != context.outer_context.map_of_governments.end()) {
+		if(auto toit = context.outer_context.map_of_governments.find(to_gov); toit != context.outer_context.map_of_governments.end()) {
 			context.outer_context.state.world.rebel_type_set_government_change(context.id, frit->second, toit->second);
 		} else {
 			err.accumulated_errors += "Invalid government " + std::string(to_gov) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1703,7 +1704,7 @@ void rebel_body::defect_delay(association_type, int32_t value, error_handler& er
 }
 
 void rebel_body::ideology(association_type, std::string_view value, error_handler& err, int32_t line, rebel_context& context) {
-	if(auto it = context.outer_context.map_of_ideologies.find(std::string(value)); it != context.outer_context.map_of_ideologies.end()) {
+	if(auto it = context.outer_context.map_of_ideologies.find(value); it != context.outer_context.map_of_ideologies.end()) {
 		context.outer_context.state.world.rebel_type_set_ideology(context.id, it->second.id);
 	} else {
 		err.accumulated_errors += "Invalid ideology " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1820,7 +1821,7 @@ void oob_ship::name(association_type, std::string_view value, error_handler& err
 }
 
 void oob_ship::type(association_type, std::string_view value, error_handler& err, int32_t line, oob_file_ship_context& context) {
-	if(auto it = context.outer_context.map_of_unit_types.find(std::string(value)); it != context.outer_context.map_of_unit_types.end()) {
+	if(auto it = context.outer_context.map_of_unit_types.find(value); it != context.outer_context.map_of_unit_types.end()) {
 		context.outer_context.state.world.ship_set_type(context.id, it->second);
 	} else {
 		err.accumulated_errors += "Invalid unit type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1832,7 +1833,7 @@ void oob_regiment::name(association_type, std::string_view value, error_handler&
 }
 
 void oob_regiment::type(association_type, std::string_view value, error_handler& err, int32_t line, oob_file_regiment_context& context) {
-	if(auto it = context.outer_context.map_of_unit_types.find(std::string(value)); it != context.outer_context.map_of_unit_types.end()) {
+	if(auto it = context.outer_context.map_of_unit_types.find(value); it != context.outer_context.map_of_unit_types.end()) {
 		context.outer_context.state.world.regiment_set_type(context.id, it->second);
 	} else {
 		err.accumulated_errors += "Invalid unit type " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1919,7 +1920,7 @@ void oob_file::leader(oob_leader const& value, error_handler& err, int32_t line,
 void production_employee::poptype(association_type, std::string_view v, error_handler& err, int32_t line, production_context& context) {
 	if(is_fixed_token_ci(v.data(), v.data() + v.length(), "artisan")) {
 		type = context.outer_context.state.culture_definitions.artisans;
-	} else if(auto it = context.outer_context.map_of_poptypes.find(std::string(v)); it != context.outer_context.map_of_poptypes.end()) {
+	} else if(auto it = context.outer_context.map_of_poptypes.find(v); it != context.outer_context.map_of_poptypes.end()) {
 		type = it->second;
 	} else {
 		err.accumulated_errors += "Invalid pop type " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1980,7 +1981,7 @@ void vassal_description::start_date(association_type, sys::year_month_day ymd, e
 }
 
 void govt_flag_block::flag(association_type, std::string_view value, error_handler& err, int32_t line, country_history_context& context) {
-	if(auto it = context.outer_context.map_of_governments.find(std::string(value)); it != context.outer_context.map_of_governments.end()) {
+	if(auto it = context.outer_context.map_of_governments.find(value); it != context.outer_context.map_of_governments.end()) {
 		flag_ = context.outer_context.state.culture_definitions.governments[it->second].flag;
 	} else {
 		err.accumulated_errors += "invalid government type " + std::string(value) + " encountered  (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1991,7 +1992,7 @@ void upper_house_block::any_value(std::string_view value, association_type, floa
 	if(!context.holder_id)
 		return;
 
-	if(auto it = context.outer_context.map_of_ideologies.find(std::string(value)); it != context.outer_context.map_of_ideologies.end()) {
+	if(auto it = context.outer_context.map_of_ideologies.find(value); it != context.outer_context.map_of_ideologies.end()) {
 		context.outer_context.state.world.nation_set_upper_house(context.holder_id, it->second.id, v);
 	} else {
 		err.accumulated_errors += "invalid ideology " + std::string(value) + " encountered  (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -2016,7 +2017,7 @@ void foreign_investment_block::any_value(std::string_view tag, association_type,
 }
 
 void country_history_file::set_country_flag(association_type, std::string_view value, error_handler& err, int32_t line, country_history_context& context) {
-	if(auto it = context.outer_context.map_of_national_flags.find(std::string(value)); it != context.outer_context.map_of_national_flags.end()) {
+	if(auto it = context.outer_context.map_of_national_flags.find(value); it != context.outer_context.map_of_national_flags.end()) {
 		if(context.holder_id)
 			context.outer_context.state.world.nation_set_flag_variables(context.holder_id, it->second, true);
 	} else {
@@ -2047,13 +2048,13 @@ void country_history_file::any_value(std::string_view label, association_type, s
 		auto v = parse_bool(value, line, err);
 		context.outer_context.state.world.nation_set_active_inventions(context.holder_id, itb->second.id, v);
 	} else if(auto itc = context.outer_context.map_of_iissues.find(str_label); itc != context.outer_context.map_of_iissues.end()) {
-		if(auto itd = context.outer_context.map_of_ioptions.find(std::string(value)); itd != context.outer_context.map_of_ioptions.end()) {
+		if(auto itd = context.outer_context.map_of_ioptions.find(value); itd != context.outer_context.map_of_ioptions.end()) {
 			context.outer_context.state.world.nation_set_issues(context.holder_id, itc->second, itd->second.id);
 		} else {
 			err.accumulated_errors += "invalid issue option name " + std::string(value) + " encountered  (" + err.file_name + " line " + std::to_string(line) + ")\n";
 		}
 	} else if(auto ite = context.outer_context.map_of_reforms.find(str_label); ite != context.outer_context.map_of_reforms.end()) {
-		if(auto itd = context.outer_context.map_of_roptions.find(std::string(value)); itd != context.outer_context.map_of_roptions.end()) {
+		if(auto itd = context.outer_context.map_of_roptions.find(value); itd != context.outer_context.map_of_roptions.end()) {
 			context.outer_context.state.world.nation_set_reforms(context.holder_id, ite->second, itd->second.id);
 		} else {
 			err.accumulated_errors += "invalid reform option name " + std::string(value) + " encountered  (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -2064,7 +2065,7 @@ void country_history_file::any_value(std::string_view label, association_type, s
 }
 
 void country_history_file::primary_culture(association_type, std::string_view value, error_handler& err, int32_t line, country_history_context& context) {
-	if(auto it = context.outer_context.map_of_culture_names.find(std::string(value)); it != context.outer_context.map_of_culture_names.end()) {
+	if(auto it = context.outer_context.map_of_culture_names.find(value); it != context.outer_context.map_of_culture_names.end()) {
 		context.outer_context.state.world.national_identity_set_primary_culture(context.nat_ident, it->second);
 		if(context.holder_id)
 			context.outer_context.state.world.nation_set_primary_culture(context.holder_id, it->second);
@@ -2077,7 +2078,7 @@ void country_history_file::culture(association_type, std::string_view value, err
 	if(!context.holder_id)
 		return;
 
-	if(auto it = context.outer_context.map_of_culture_names.find(std::string(value)); it != context.outer_context.map_of_culture_names.end()) {
+	if(auto it = context.outer_context.map_of_culture_names.find(value); it != context.outer_context.map_of_culture_names.end()) {
 		context.outer_context.state.world.nation_get_accepted_cultures(context.holder_id).push_back(it->second);
 	} else {
 		err.accumulated_errors += "invalid culture " + std::string(value) + " encountered  (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -2085,7 +2086,7 @@ void country_history_file::culture(association_type, std::string_view value, err
 }
 
 void country_history_file::religion(association_type, std::string_view value, error_handler& err, int32_t line, country_history_context& context) {
-	if(auto it = context.outer_context.map_of_religion_names.find(std::string(value)); it != context.outer_context.map_of_religion_names.end()) {
+	if(auto it = context.outer_context.map_of_religion_names.find(value); it != context.outer_context.map_of_religion_names.end()) {
 		context.outer_context.state.world.national_identity_set_religion(context.nat_ident, it->second);
 		if(context.holder_id)
 			context.outer_context.state.world.nation_set_religion(context.holder_id, it->second);
@@ -2098,7 +2099,7 @@ void country_history_file::government(association_type, std::string_view value,
 	if(!context.holder_id)
 		return;
 
-	if(auto it = context.outer_context.map_of_governments.find(std::string(value)); it != context.outer_context.map_of_governments.end()) {
+	if(auto it = context.outer_context.map_of_governments.find(value); it != context.outer_context.map_of_governments.end()) {
 		context.outer_context.state.world.nation_set_government_type(context.holder_id, it->second);
 	} else {
 		err.accumulated_errors += "invalid government type " + std::string(value) + " encountered  (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -2121,7 +2122,7 @@ void country_history_file::nationalvalue(association_type, std::string_view valu
 	if(!context.holder_id)
 		return;
 
-	if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+	if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 		context.outer_context.state.world.nation_set_national_value(context.holder_id, it->second);
 	} else {
 		err.accumulated_errors += "invalid modifier " + std::string(value) + " encountered  (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -2132,7 +2133,7 @@ void country_history_file::schools(association_type, std::string_view value, err
 	if(!context.holder_id)
 		return;
 
-	if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+	if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 		context.outer_context.state.world.nation_set_tech_school(context.holder_id, it->second);
 	} else {
 		err.accumulated_errors += "invalid modifier " + std::string(value) + " encountered  (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -2290,7 +2291,7 @@ void history_war_goal::actor(association_type, std::string_view tag, error_handl
 	}
 }
 void history_war_goal::casus_belli(association_type, std::string_view value, error_handler& err, int32_t line, war_history_context& context) {
-	if(auto it = context.outer_context.map_of_cb_types.find(std::string(value)); it != context.outer_context.map_of_cb_types.end()) {
+	if(auto it = context.outer_context.map_of_cb_types.find(value); it != context.outer_context.map_of_cb_types.end()) {
 		casus_belli_ = it->second.id;
 	} else {
 		err.accumulated_errors += "invalid cb type type " + std::string(value) + " encountered  (" + err.file_name + " line " + std::to_string(line) + ")\n";
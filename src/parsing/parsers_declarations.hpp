@@ -293,40 +293,48 @@ namespace parsers {
 
 		sys::state& state;
 
+		// the keys of the name maps below are copied into here (or are string literals); declared before the maps so that it
+		// outlives them, and freed all at once along with the context when scenario building is done
+		string_arena key_storage;
+
 		ankerl::unordered_dense::map<uint32_t, dcon::national_identity_id> map_of_ident_names;
 		tagged_vector<std::string, dcon::national_identity_id> file_names_for_idents;
 
-		ankerl::unordered_dense::map<std::string, dcon::religion_id> map_of_religion_names;
-		ankerl::unordered_dense::map<std::string, dcon::culture_id> map_of_culture_names;
-		ankerl::unordered_dense::map<std::string, dcon::culture_group_id> map_of_culture_group_names;
-		ankerl::unordered_dense::map<std::string, dcon::commodity_id> map_of_commodity_names;
-		ankerl::unordered_dense::map<std::string, dcon::factory_type_id> map_of_production_types;
-		ankerl::unordered_dense::map<std::string, dcon::factory_type_id> map_of_factory_names;
-		ankerl::unordered_dense::map<std::string, pending_ideology_content> map_of_ideologies;
-		ankerl::unordered_dense::map<std::string, dcon::ideology_group_id> map_of_ideology_groups;
-		ankerl::unordered_dense::map<std::string, pending_option_content> map_of_ioptions;
-		ankerl::unordered_dense::map<std::string, pending_roption_content> map_of_roptions;
-		ankerl::unordered_dense::map<std::string, dcon::issue_id> map_of_iissues;
-		ankerl::unordered_dense::map<std::string, dcon::reform_id> map_of_reforms;
-		ankerl::unordered_dense::map<std::string, dcon::government_type_id> map_of_governments;
-		ankerl::unordered_dense::map<std::string, pending_cb_content> map_of_cb_types;
-		ankerl::unordered_dense::map<std::string, dcon::leader_trait_id> map_of_leader_traits;
-		ankerl::unordered_dense::map<std::string, pending_crime_content> map_of_crimes;
+		ankerl::unordered_dense::map<std::string_view, dcon::religion_id> map_of_religion_names;
+		ankerl::unordered_dense::map<std::string_view, dcon::culture_id> map_of_culture_names;
+		ankerl::unordered_dense::map<std::string_view, dcon::culture_group_id> map_of_culture_group_names;
+		ankerl::unordered_dense::map<std::string_view, dcon::commodity_id> map_of_commodity_names;
+		ankerl::unordered_dense::map<std::string_view, dcon::factory_type_id> map_of_production_types;
+		ankerl::unordered_dense::map<std::string_view, dcon::factory_type_id> map_of_factory_names;
+		ankerl::unordered_dense::map<std::string_view, pending_ideology_content> map_of_ideologies;
+		ankerl::unordered_dense::map<std::string_view, dcon::ideology_group_id> map_of_ideology_groups;
+		ankerl::unordered_dense::map<std::string_view, pending_option_content> map_of_ioptions;
+		ankerl::unordered_dense::map<std::string_view, pending_roption_content> map_of_roptions;
+		ankerl::unordered_dense::map<std::string_view, dcon::issue_id> map_of_iissues;
+		ankerl::unordered_dense::map<std::string_view, dcon::reform_id> map_of_reforms;
+		ankerl::unordered_dense::map<std::string_view, dcon::government_type_id> map_of_governments;
+		ankerl::unordered_dense::map<std::string_view, pending_cb_content> map_of_cb_types;
+		ankerl::unordered_dense::map<std::string_view, dcon::leader_trait_id> map_of_leader_traits;
+		ankerl::unordered_dense::map<std::string_view, pending_crime_content> map_of_crimes;
 		std::vector<pending_triggered_modifier_content> set_of_triggered_modifiers;
-		ankerl::unordered_dense::map<std::string, dcon::modifier_id> map_of_modifiers;
-		ankerl::unordered_dense::map<std::string, dcon::pop_type_id> map_of_poptypes;
-		ankerl::unordered_dense::map<std::string, pending_rebel_type_content> map_of_rebeltypes;
-		ankerl::unordered_dense::map<std::string, terrain_type> map_of_terrain_types;
-		ankerl::unordered_dense::map<std::string, int32_t> map_of_tech_folders;
-		ankerl::unordered_dense::map<std::string, pending_tech_content> map_of_technologies;
-		ankerl::unordered_dense::map<std::string, pending_invention_content> map_of_inventions;
-		ankerl::unordered_dense::map<std::string, dcon::unit_type_id> map_of_unit_types;
-		ankerl::unordered_dense::map<std::string, dcon::national_variable_id> map_of_national_variables;
-		ankerl::unordered_dense::map<std::string, dcon::national_flag_id> map_of_national_flags;
-		ankerl::unordered_dense::map<std::string, dcon::global_flag_id> map_of_global_flags;
-		ankerl::unordered_dense::map<std::string, dcon::state_definition_id> map_of_state_names;
+		ankerl::unordered_dense::map<std::string_view, dcon::modifier_id> map_of_modifiers;
+		ankerl::unordered_dense::map<std::string_view, dcon::pop_type_id> map_of_poptypes;
+		ankerl::unordered_dense::map<std::string_view, pending_rebel_type_content> map_of_rebeltypes;
+		ankerl::unordered_dense::map<std::string_view, terrain_type> map_of_terrain_types;
+		ankerl::unordered_dense::map<std::string_view, int32_t> map_of_tech_folders;
+		ankerl::unordered_dense::map<std::string_view, pending_tech_content> map_of_technologies;
+		ankerl::unordered_dense::map<std::string_view, pending_invention_content> map_of_inventions;
+		ankerl::unordered_dense::map<std::string_view, dcon::unit_type_id> map_of_unit_types;
+		ankerl::unordered_dense::map<std::string_view, dcon::national_variable_id> map_of_national_variables;
+		ankerl::unordered_dense::map<std::string_view, dcon::national_flag_id> map_of_national_flags;
+		ankerl::unordered_dense::map<std::string_view, dcon::global_flag_id> map_of_global_flags;
+		ankerl::unordered_dense::map<std::string_view, dcon::state_definition_id> map_of_state_names;
 		ankerl::unordered_dense::map<int32_t, pending_nat_event> map_of_national_events;
 		ankerl::unordered_dense::map<int32_t, pending_prov_event> map_of_provincial_events;
+		// keys of events that an effect has just given a scope to; commit_pending_events works through these
+		// instead of rescanning the maps above each time an event body references another event
+		std::vector<int32_t> national_event_worklist;
+		std::vector<int32_t> provincial_event_worklist;
 
 		tagged_vector<province_data, dcon::province_id> prov_id_to_original_id_map;
 		std::vector<dcon::province_id> original_id_to_prov_id_map;
@@ -350,9 +358,9 @@ namespace parsers {
 
 		scenario_building_context(sys::state& state);
 
-		dcon::national_variable_id get_national_variable(std::string const& name);
-		dcon::national_flag_id get_national_flag(std::string const& name);
-		dcon::global_flag_id get_global_flag(std::string const& name);
+		dcon::national_variable_id get_national_variable(std::string_view name);
+		dcon::national_flag_id get_national_flag(std::string_view name);
+		dcon::global_flag_id get_global_flag(std::string_view name);
 
 		int32_t number_of_commodities_seen = 0;
 	};
@@ -822,7 +830,7 @@ namespace parsers {
 		tagged_vector<float, dcon::commodity_id> data;
 
 		void any_value(std::string_view name, association_type, float value, error_handler& err, int32_t line, scenario_building_context& context) {
-			auto found_commodity = context.map_of_commodity_names.find(std::string(name));
+			auto found_commodity = context.map_of_commodity_names.find(name);
 			if(found_commodity != context.map_of_commodity_names.end()) {
 				data.safe_get(found_commodity->second) = value;
 			} else {
@@ -1289,7 +1297,7 @@ namespace parsers {
 		int32_t loyalty_value = 0;
 		dcon::ideology_id id;
 		void ideology(association_type, std::string_view text, error_handler& err, int32_t line, province_file_context& context) {
-			if(auto it = context.outer_context.map_of_ideologies.find(std::string(text)); it != context.outer_context.map_of_ideologies.end()) {
+			if(auto it = context.outer_context.map_of_ideologies.find(text); it != context.outer_context.map_of_ideologies.end()) {
 				id = it->second.id;
 			} else {
 				err.accumulated_errors += std::string(text) + " is not a valid ideology name (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1301,7 +1309,7 @@ namespace parsers {
 		int32_t level = 1;
 		dcon::factory_type_id id;
 		void building(association_type, std::string_view text, error_handler& err, int32_t line, province_file_context& context) {
-			if(auto it = context.outer_context.map_of_factory_names.find(std::string(text)); it != context.outer_context.map_of_factory_names.end()) {
+			if(auto it = context.outer_context.map_of_factory_names.find(text); it != context.outer_context.map_of_factory_names.end()) {
 				id = it->second;
 			} else {
 				err.accumulated_errors += std::string(text) + " is not a valid factory name (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -2053,14 +2061,14 @@ namespace parsers {
 				err.accumulated_errors += "Leader of type neither land nor sea (" + err.file_name + " line " + std::to_string(line) + ")\n";
 		}
 		void personality(association_type, std::string_view value, error_handler& err, int32_t line, oob_file_context& context) {
-			if(auto it = context.outer_context.map_of_leader_traits.find(std::string(value)); it != context.outer_context.map_of_leader_traits.end()) {
+			if(auto it = context.outer_context.map_of_leader_traits.find(value); it != context.outer_context.map_of_leader_traits.end()) {
 				personality_ = it->second;
 			} else {
 				err.accumulated_errors += "Invalid leader trait " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
 			}
 		}
 		void background(association_type, std::string_view value, error_handler& err, int32_t line, oob_file_context& context) {
-			if(auto it = context.outer_context.map_of_leader_traits.find(std::string(value)); it != context.outer_context.map_of_leader_traits.end()) {
+			if(auto it = context.outer_context.map_of_leader_traits.find(value); it != context.outer_context.map_of_leader_traits.end()) {
 				background_ = it->second;
 			} else {
 				err.accumulated_errors += "Invalid leader trait " + std::string(value) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -2113,7 +2121,7 @@ namespace parsers {
 
 	struct production_context {
 		scenario_building_context& outer_context;
-		ankerl::unordered_dense::map<std::string, production_type> templates;
+		ankerl::unordered_dense::map<std::string_view, production_type> templates;
 		bool found_worker_types = false;
 
 		production_context(scenario_building_context& outer_context) : outer_context(outer_context) { }
@@ -2164,7 +2172,7 @@ namespace parsers {
 		production_type_enum type_ = production_type_enum::none;
 
 		void output_goods(association_type, std::string_view v, error_handler& err, int32_t line, production_context& context) {
-			if(auto it = context.outer_context.map_of_commodity_names.find(std::string(v)); it != context.outer_context.map_of_commodity_names.end()) {
+			if(auto it = context.outer_context.map_of_commodity_names.find(v); it != context.outer_context.map_of_commodity_names.end()) {
 				output_goods_ = it->second;
 			} else {
 				err.accumulated_errors += "Invalid commodity name " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -2184,7 +2192,7 @@ namespace parsers {
 				err.accumulated_errors += "Invalid production type " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
 		}
 		void as_template(association_type, std::string_view v, error_handler& err, int32_t line, production_context& context) {
-			if(auto it = context.templates.find(std::string(v)); it != context.templates.end()) {
+			if(auto it = context.templates.find(v); it != context.templates.end()) {
 				*this = it->second;
 			} else {
 				err.accumulated_errors += "Invalid production template " + std::string(v) + " (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -2245,7 +2253,7 @@ namespace parsers {
 
 		void flag(association_type, std::string_view value, error_handler& err, int32_t line, country_history_context& context);
 		void government(association_type, std::string_view value, error_handler& err, int32_t line, country_history_context& context) {
-			if(auto it = context.outer_context.map_of_governments.find(std::string(value)); it != context.outer_context.map_of_governments.end()) {
+			if(auto it = context.outer_context.map_of_governments.find(value); it != context.outer_context.map_of_governments.end()) {
 				government_ = it->second;
 			} else {
 				err.accumulated_errors += "invalid government type " + std::string(value) + " encountered  (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -108,7 +108,7 @@ void read_map_adjacency(char const* start, char const* end, error_handler& err,
 
 void palette_definition::finish(scenario_building_context& context) {
 	if(color.free_value == 254) {
-		auto it = context.map_of_terrain_types.find(std::string(type));
+		auto it = context.map_of_terrain_types.find(type);
 		if(it != context.map_of_terrain_types.end()) {
 			context.ocean_terrain = it->second.id;
 		}
@@ -117,7 +117,7 @@ void palette_definition::finish(scenario_building_context& context) {
 	if(color.free_value < 0 || color.free_value >= 64)
 		return;
 
-	auto it = context.map_of_terrain_types.find(std::string(type));
+	auto it = context.map_of_terrain_types.find(type);
 	if(it != context.map_of_terrain_types.end()) {
 		context.color_by_terrain_index[color.free_value] = it->second.color;
 		context.modifier_by_terrain_index[color.free_value] = it->second.id;
@@ -142,15 +142,15 @@ void make_terrain_modifier(std::string_view name, token_generator& gen, error_ha
 	parsed_modifier.convert_to_province_mod();
 	context.state.world.modifier_set_province_values(new_modifier, parsed_modifier.constructed_definition);
 
-	context.map_of_modifiers.insert_or_assign(std::string(name), new_modifier);
-	context.map_of_terrain_types.insert_or_assign(std::string(name), terrain_type{ new_modifier, parsed_modifier.color.value });
+	context.map_of_modifiers.insert_or_assign(context.key_storage.store(name), new_modifier);
+	context.map_of_terrain_types.insert_or_assign(context.key_storage.store(name), terrain_type{ new_modifier, parsed_modifier.color.value });
 }
 
 void make_state_definition(std::string_view name, token_generator& gen, error_handler& err, scenario_building_context& context) {
 	auto name_id = text::find_or_add_key(context.state, name);
 	auto state_id = context.state.world.create_state_definition();
 
-	context.map_of_state_names.insert_or_assign(std::string(name), state_id);
+	context.map_of_state_names.insert_or_assign(context.key_storage.store(name), state_id);
 	context.state.world.state_definition_set_name(state_id, name_id);
 
 	state_def_building_context new_context{ context, state_id };
@@ -162,7 +162,7 @@ void make_continent_definition(std::string_view name, token_generator& gen, erro
 	auto name_id = text::find_or_add_key(context.state, name);
 	auto new_modifier = context.state.world.create_modifier();
 
-	context.map_of_modifiers.insert_or_assign(std::string(name), new_modifier);
+	context.map_of_modifiers.insert_or_assign(context.key_storage.store(name), new_modifier);
 
 	continent_building_context new_context{ context, new_modifier };
 	context.state.world.modifier_set_name(new_modifier, name_id);
@@ -194,11 +194,11 @@ void make_climate_definition(std::string_view name, token_generator& gen, error_
 	auto name_id = text::find_or_add_key(context.state, name);
 
 	auto new_modifier = [&]() {
-		if(auto it = context.map_of_modifiers.find(std::string(name)); it != context.map_of_modifiers.end())
+		if(auto it = context.map_of_modifiers.find(name); it != context.map_of_modifiers.end())
 			return it->second;
 
 		auto new_id = context.state.world.create_modifier();
-		context.map_of_modifiers.insert_or_assign(std::string(name), new_id);
+		context.map_of_modifiers.insert_or_assign(context.key_storage.store(name), new_id);
 		context.state.world.modifier_set_name(new_id, name_id);
 		return new_id;
 	}();
@@ -224,18 +224,6 @@ void enter_dated_block(std::string_view name, token_generator& gen, error_handle
 	}
 }
 
-dcon::nation_id prov_parse_force_tag_owner(dcon::national_identity_id tag, dcon::data_container& world) {
-	auto fat_tag = fatten(world, tag);
-	auto tag_holder = fat_tag.get_nation_from_identity_holder();
-	if(tag_holder)
-		return tag_holder;
-
-	tag_holder = world.create_nation();
-	world.force_create_identity_holder(tag_holder, tag);
-
-	return tag_holder;
-}
-
 void province_history_file::life_rating(association_type, uint32_t value, error_handler& err, int32_t line, province_file_context& context) {
 	context.outer_context.state.world.province_set_life_rating(context.id, uint8_t(value));
 }
@@ -257,7 +245,7 @@ void province_history_file::colony(association_type, uint32_t value, error_handl
 }
 
 void province_history_file::trade_goods(association_type, std::string_view text, error_handler& err, int32_t line, province_file_context& context) {
-	if (auto it = context.outer_context.map_of_commodity_names.find(std::string(text)); it != context.outer_context.map_of_commodity_names.end()) {
+	if (auto it = context.outer_context.map_of_commodity_names.find(text); it != context.outer_context.map_of_commodity_names.end()) {
 		context.outer_context.state.world.province_set_rgo(context.id, it->second);
 	}
 	else {
@@ -267,23 +255,23 @@ void province_history_file::trade_goods(association_type, std::string_view text,
 
 void province_history_file::owner(association_type, uint32_t value, error_handler& err, int32_t line, province_file_context& context) {
 	if(auto it = context.outer_context.map_of_ident_names.find(value); it != context.outer_context.map_of_ident_names.end()) {
-		auto holder = prov_parse_force_tag_owner(it->second, context.outer_context.state.world);
-		context.outer_context.state.world.force_create_province_ownership(context.id, holder);
+		auto holder = nations::create_nation_for_identity(context.outer_context.state, it->second);
+		province::set_province_owner(context.outer_context.state, context.id, holder);
 	} else {
 		err.accumulated_errors += "Invalid tag (" + err.file_name + " line " + std::to_string(line) + ")\n";
 	}
 }
 void province_history_file::controller(association_type, uint32_t value, error_handler& err, int32_t line, province_file_context& context) {
 	if(auto it = context.outer_context.map_of_ident_names.find(value); it != context.outer_context.map_of_ident_names.end()) {
-		auto holder = prov_parse_force_tag_owner(it->second, context.outer_context.state.world);
-		context.outer_context.state.world.force_create_province_control(context.id, holder);
+		auto holder = nations::create_nation_for_identity(context.outer_context.state, it->second);
+		province::set_province_controller(context.outer_context.state, context.id, holder);
 	} else {
 		err.accumulated_errors += "Invalid tag (" + err.file_name + " line " + std::to_string(line) + ")\n";
 	}
 }
 
 void province_history_file::terrain(association_type, std::string_view text, error_handler& err, int32_t line, province_file_context& context) {
-	if (auto it = context.outer_context.map_of_terrain_types.find(std::string(text)); it != context.outer_context.map_of_terrain_types.end()) {
+	if (auto it = context.outer_context.map_of_terrain_types.find(text); it != context.outer_context.map_of_terrain_types.end()) {
 		context.outer_context.state.world.province_set_terrain(context.id, it->second.id);
 	}
 	else {
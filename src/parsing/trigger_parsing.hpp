@@ -221,7 +221,7 @@ struct tr_can_build_railway_in_capital {
 struct tr_work_available {
 	std::vector<dcon::pop_type_id> pop_type_list;
 	void worker(association_type, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_poptypes.find(std::string(value)); it != context.outer_context.map_of_poptypes.end()) {
+		if(auto it = context.outer_context.map_of_poptypes.find(value); it != context.outer_context.map_of_poptypes.end()) {
 			pop_type_list.push_back(it->second);
 		} else {
 			err.accumulated_errors += std::string(value) + " is not a valid pop type name (" + err.file_name + " line " + std::to_string(line) + ")\n";
@@ -1115,7 +1115,7 @@ struct trigger_body {
 	}
 	void invention(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
 		
-		if(auto it = context.outer_context.map_of_technologies.find(std::string(value)); it != context.outer_context.map_of_technologies.end()) {
+		if(auto it = context.outer_context.map_of_technologies.find(value); it != context.outer_context.map_of_technologies.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::technology | association_to_bool_code(a)));
 			} else {
@@ -1125,7 +1125,7 @@ struct trigger_body {
 
 			context.compiled_trigger.push_back(uint16_t(1 + 1)); // data size; if no payload add code | trigger_codes::no_payload
 			context.compiled_trigger.push_back(trigger::payload(it->second.id).value);
-		} else if(auto itb = context.outer_context.map_of_inventions.find(std::string(value)); itb != context.outer_context.map_of_inventions.end()) {
+		} else if(auto itb = context.outer_context.map_of_inventions.find(value); itb != context.outer_context.map_of_inventions.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::invention | association_to_bool_code(a)));
 			} else {
@@ -1139,7 +1139,7 @@ struct trigger_body {
 		}
 	}
 	void big_producer(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_commodity_names.find(std::string(value)); it != context.outer_context.map_of_commodity_names.end()) {
+		if(auto it = context.outer_context.map_of_commodity_names.find(value); it != context.outer_context.map_of_commodity_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::big_producer | association_to_bool_code(a)));
 			} else {
@@ -1272,7 +1272,7 @@ struct trigger_body {
 	}
 
 	void government(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_governments.find(std::string(value)); it != context.outer_context.map_of_governments.end()) {
+		if(auto it = context.outer_context.map_of_governments.find(value); it != context.outer_context.map_of_governments.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::government_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::pop) {
@@ -1289,7 +1289,7 @@ struct trigger_body {
 	}
 
 	void constructing_cb_type(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_cb_types.find(std::string(value)); it != context.outer_context.map_of_cb_types.end()) {
+		if(auto it = context.outer_context.map_of_cb_types.find(value); it != context.outer_context.map_of_cb_types.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::constructing_cb_type | association_to_bool_code(a)));
 			} else {
@@ -1304,7 +1304,7 @@ struct trigger_body {
 	}
 
 	void can_build_factory_in_capital_state(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_factory_names.find(std::string(value)); it != context.outer_context.map_of_factory_names.end()) {
+		if(auto it = context.outer_context.map_of_factory_names.find(value); it != context.outer_context.map_of_factory_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::can_build_factory_in_capital_state | association_to_bool_code(a)));
 			} else {
@@ -1332,7 +1332,7 @@ struct trigger_body {
 		}
 	}
 	void tech_school(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+		if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::tech_school | association_to_bool_code(a)));
 			} else {
@@ -1346,7 +1346,7 @@ struct trigger_body {
 		}
 	}
 	void primary_culture(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_culture_names.find(std::string(value)); it != context.outer_context.map_of_culture_names.end()) {
+		if(auto it = context.outer_context.map_of_culture_names.find(value); it != context.outer_context.map_of_culture_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::primary_culture | association_to_bool_code(a)));
 			} else {
@@ -1360,7 +1360,7 @@ struct trigger_body {
 		}
 	}
 	void has_crime(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_crimes.find(std::string(value)); it != context.outer_context.map_of_crimes.end()) {
+		if(auto it = context.outer_context.map_of_crimes.find(value); it != context.outer_context.map_of_crimes.end()) {
 			if(context.main_slot == trigger::slot_contents::province) {
 				context.compiled_trigger.push_back(uint16_t(trigger::has_crime | association_to_bool_code(a)));
 			} else {
@@ -1374,7 +1374,7 @@ struct trigger_body {
 		}
 	}
 	void accepted_culture(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_culture_names.find(std::string(value)); it != context.outer_context.map_of_culture_names.end()) {
+		if(auto it = context.outer_context.map_of_culture_names.find(value); it != context.outer_context.map_of_culture_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::accepted_culture | association_to_bool_code(a)));
 			} else {
@@ -1388,7 +1388,7 @@ struct trigger_body {
 		}
 	}
 	void pop_majority_religion(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_religion_names.find(std::string(value)); it != context.outer_context.map_of_religion_names.end()) {
+		if(auto it = context.outer_context.map_of_religion_names.find(value); it != context.outer_context.map_of_religion_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::pop_majority_religion_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::state) {
@@ -1405,7 +1405,7 @@ struct trigger_body {
 		}
 	}
 	void pop_majority_culture(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_culture_names.find(std::string(value)); it != context.outer_context.map_of_culture_names.end()) {
+		if(auto it = context.outer_context.map_of_culture_names.find(value); it != context.outer_context.map_of_culture_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::pop_majority_culture_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::state) {
@@ -1422,7 +1422,7 @@ struct trigger_body {
 		}
 	}
 	void pop_majority_issue(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_ioptions.find(std::string(value)); it != context.outer_context.map_of_ioptions.end()) {
+		if(auto it = context.outer_context.map_of_ioptions.find(value); it != context.outer_context.map_of_ioptions.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::pop_majority_issue_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::state) {
@@ -1441,7 +1441,7 @@ struct trigger_body {
 		}
 	}
 	void pop_majority_ideology(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_ideologies.find(std::string(value)); it != context.outer_context.map_of_ideologies.end()) {
+		if(auto it = context.outer_context.map_of_ideologies.find(value); it != context.outer_context.map_of_ideologies.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::pop_majority_ideology_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::state) {
@@ -1460,7 +1460,7 @@ struct trigger_body {
 		}
 	}
 	void trade_goods_in_state(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_commodity_names.find(std::string(value)); it != context.outer_context.map_of_commodity_names.end()) {
+		if(auto it = context.outer_context.map_of_commodity_names.find(value); it != context.outer_context.map_of_commodity_names.end()) {
 			if(context.main_slot == trigger::slot_contents::state) {
 				context.compiled_trigger.push_back(uint16_t(trigger::trade_goods_in_state_state | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::province) {
@@ -1517,7 +1517,7 @@ struct trigger_body {
 				err.accumulated_errors += "culture = reb trigger used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 				return;
 			}
-		} else if(auto it = context.outer_context.map_of_culture_names.find(std::string(value)); it != context.outer_context.map_of_culture_names.end()) {
+		} else if(auto it = context.outer_context.map_of_culture_names.find(value); it != context.outer_context.map_of_culture_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::culture_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::state) {
@@ -1554,7 +1554,7 @@ struct trigger_body {
 				err.accumulated_errors += "has_pop_culture = this trigger used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 				return;
 			}
-		} else if(auto it = context.outer_context.map_of_culture_names.find(std::string(value)); it != context.outer_context.map_of_culture_names.end()) {
+		} else if(auto it = context.outer_context.map_of_culture_names.find(value); it != context.outer_context.map_of_culture_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::has_pop_culture_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::state) {
@@ -1591,7 +1591,7 @@ struct trigger_body {
 				err.accumulated_errors += "has_pop_religion = this trigger used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 				return;
 			}
-		} else if(auto it = context.outer_context.map_of_religion_names.find(std::string(value)); it != context.outer_context.map_of_religion_names.end()) {
+		} else if(auto it = context.outer_context.map_of_religion_names.find(value); it != context.outer_context.map_of_religion_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::has_pop_religion_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::state) {
@@ -1680,7 +1680,7 @@ struct trigger_body {
 				err.accumulated_errors += "culture_group = reb trigger used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 				return;
 			}
-		} else if(auto it = context.outer_context.map_of_culture_group_names.find(std::string(value)); it != context.outer_context.map_of_culture_group_names.end()) {
+		} else if(auto it = context.outer_context.map_of_culture_group_names.find(value); it != context.outer_context.map_of_culture_group_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::culture_group_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::pop) {
@@ -1765,7 +1765,7 @@ struct trigger_body {
 				err.accumulated_errors += "religion = reb trigger used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 				return;
 			}
-		} else if(auto it = context.outer_context.map_of_religion_names.find(std::string(value)); it != context.outer_context.map_of_religion_names.end()) {
+		} else if(auto it = context.outer_context.map_of_religion_names.find(value); it != context.outer_context.map_of_religion_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::religion_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::pop) {
@@ -1780,7 +1780,7 @@ struct trigger_body {
 		}
 	}
 	void terrain(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_terrain_types.find(std::string(value)); it != context.outer_context.map_of_terrain_types.end()) {
+		if(auto it = context.outer_context.map_of_terrain_types.find(value); it != context.outer_context.map_of_terrain_types.end()) {
 			if(context.main_slot == trigger::slot_contents::pop) {
 				context.compiled_trigger.push_back(uint16_t(trigger::terrain_pop | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::province) {
@@ -1795,7 +1795,7 @@ struct trigger_body {
 		}
 	}
 	void trade_goods(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_commodity_names.find(std::string(value)); it != context.outer_context.map_of_commodity_names.end()) {
+		if(auto it = context.outer_context.map_of_commodity_names.find(value); it != context.outer_context.map_of_commodity_names.end()) {
 			if(context.main_slot == trigger::slot_contents::province) {
 				context.compiled_trigger.push_back(uint16_t(trigger::trade_goods | association_to_bool_code(a)));
 			} else {
@@ -1818,7 +1818,7 @@ struct trigger_body {
 		}
 	}
 	void has_faction(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_rebeltypes.find(std::string(value)); it != context.outer_context.map_of_rebeltypes.end()) {
+		if(auto it = context.outer_context.map_of_rebeltypes.find(value); it != context.outer_context.map_of_rebeltypes.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::has_faction_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::pop) {
@@ -2169,11 +2169,11 @@ struct trigger_body {
 			err.accumulated_errors += "has_country_flag trigger used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 			return;
 		}
-		context.compiled_trigger.push_back(trigger::payload(context.outer_context.get_national_flag(std::string(value))).value);
+		context.compiled_trigger.push_back(trigger::payload(context.outer_context.get_national_flag(value)).value);
 	}
 	void has_global_flag(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
 		context.compiled_trigger.push_back(uint16_t(trigger::has_global_flag | association_to_bool_code(a)));
-		context.compiled_trigger.push_back(trigger::payload(context.outer_context.get_global_flag(std::string(value))).value);
+		context.compiled_trigger.push_back(trigger::payload(context.outer_context.get_global_flag(value)).value);
 	}
 
 	void continent(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
@@ -2192,7 +2192,7 @@ struct trigger_body {
 					err.accumulated_errors += "continent = from trigger used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 					return;
 				}
-			} else if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+			} else if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 				context.compiled_trigger.push_back(uint16_t(trigger::continent_nation | association_to_bool_code(a)));
 				context.compiled_trigger.push_back(trigger::payload(it->second).value);
 			} else {
@@ -2214,7 +2214,7 @@ struct trigger_body {
 					err.accumulated_errors += "continent = from trigger used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 					return;
 				}
-			} else if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+			} else if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 				context.compiled_trigger.push_back(uint16_t(trigger::continent_state | association_to_bool_code(a)));
 				context.compiled_trigger.push_back(trigger::payload(it->second).value);
 			} else {
@@ -2236,7 +2236,7 @@ struct trigger_body {
 					err.accumulated_errors += "continent = from trigger used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 					return;
 				}
-			} else if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+			} else if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 				context.compiled_trigger.push_back(uint16_t(trigger::continent_province | association_to_bool_code(a)));
 				context.compiled_trigger.push_back(trigger::payload(it->second).value);
 			} else {
@@ -2258,7 +2258,7 @@ struct trigger_body {
 					err.accumulated_errors += "continent = from trigger used in an incorrect scope type (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 					return;
 				}
-			} else if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+			} else if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 				context.compiled_trigger.push_back(uint16_t(trigger::continent_pop | association_to_bool_code(a)));
 				context.compiled_trigger.push_back(trigger::payload(it->second).value);
 			} else {
@@ -2385,7 +2385,7 @@ struct trigger_body {
 		if(context.main_slot == trigger::slot_contents::state) {
 			if(is_fixed_token_ci(value.data(), value.data() + value.length(), "factory"))
 				context.compiled_trigger.push_back(uint16_t(trigger::has_building_factory | trigger::no_payload | association_to_bool_code(a)));
-			else if(auto it = context.outer_context.map_of_factory_names.find(std::string(value)); it != context.outer_context.map_of_factory_names.end()) {
+			else if(auto it = context.outer_context.map_of_factory_names.find(value); it != context.outer_context.map_of_factory_names.end()) {
 				context.compiled_trigger.push_back(uint16_t(trigger::has_building_state | association_to_bool_code(a)));
 				context.compiled_trigger.push_back(trigger::payload(it->second).value);
 			} else {
@@ -2401,7 +2401,7 @@ struct trigger_body {
 				context.compiled_trigger.push_back(uint16_t(trigger::has_building_naval_base | trigger::no_payload | association_to_bool_code(a)));
 			} else if(is_fixed_token_ci(value.data(), value.data() + value.length(), "factory")) {
 				context.compiled_trigger.push_back(uint16_t(trigger::has_building_factory_from_province | trigger::no_payload | association_to_bool_code(a)));
-			} else if(auto it = context.outer_context.map_of_factory_names.find(std::string(value)); it != context.outer_context.map_of_factory_names.end()) {
+			} else if(auto it = context.outer_context.map_of_factory_names.find(value); it != context.outer_context.map_of_factory_names.end()) {
 				context.compiled_trigger.push_back(uint16_t(trigger::has_building_state_from_province | association_to_bool_code(a)));
 				context.compiled_trigger.push_back(trigger::payload(it->second).value);
 			} else {
@@ -2431,7 +2431,7 @@ struct trigger_body {
 	}
 
 	void has_country_modifier(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+		if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::has_country_modifier | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::province) {
@@ -2446,7 +2446,7 @@ struct trigger_body {
 		}
 	}
 	void has_province_modifier(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+		if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 			if(context.main_slot == trigger::slot_contents::province) {
 				context.compiled_trigger.push_back(uint16_t(trigger::has_province_modifier | association_to_bool_code(a)));
 			} else {
@@ -2459,7 +2459,7 @@ struct trigger_body {
 		}
 	}
 	void nationalvalue(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_modifiers.find(std::string(value)); it != context.outer_context.map_of_modifiers.end()) {
+		if(auto it = context.outer_context.map_of_modifiers.find(value); it != context.outer_context.map_of_modifiers.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::nationalvalue_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::province) {
@@ -2476,7 +2476,7 @@ struct trigger_body {
 		}
 	}
 	void region(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_state_names.find(std::string(value)); it != context.outer_context.map_of_state_names.end()) {
+		if(auto it = context.outer_context.map_of_state_names.find(value); it != context.outer_context.map_of_state_names.end()) {
 			if(context.main_slot == trigger::slot_contents::province) {
 				context.compiled_trigger.push_back(uint16_t(trigger::region | association_to_bool_code(a)));
 			} else {
@@ -2682,7 +2682,7 @@ struct trigger_body {
 		}
 	}
 	void ruling_party_ideology(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_ideologies.find(std::string(value)); it != context.outer_context.map_of_ideologies.end()) {
+		if(auto it = context.outer_context.map_of_ideologies.find(value); it != context.outer_context.map_of_ideologies.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::ruling_party_ideology_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::pop) {
@@ -2699,7 +2699,7 @@ struct trigger_body {
 	void ruling_party(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context);
 	void has_leader(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context);
 	void is_ideology_enabled(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_ideologies.find(std::string(value)); it != context.outer_context.map_of_ideologies.end()) {
+		if(auto it = context.outer_context.map_of_ideologies.find(value); it != context.outer_context.map_of_ideologies.end()) {
 			context.compiled_trigger.push_back(uint16_t(trigger::is_ideology_enabled | association_to_bool_code(a)));
 			context.compiled_trigger.push_back(trigger::payload(it->second.id).value);
 		} else {
@@ -2898,7 +2898,7 @@ struct trigger_body {
 		}
 	}
 	void produces(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_commodity_names.find(std::string(value)); it != context.outer_context.map_of_commodity_names.end()) {
+		if(auto it = context.outer_context.map_of_commodity_names.find(value); it != context.outer_context.map_of_commodity_names.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::produces_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::state) {
@@ -2917,7 +2917,7 @@ struct trigger_body {
 		}
 	}
 	void has_pop_type(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_poptypes.find(std::string(value)); it != context.outer_context.map_of_poptypes.end()) {
+		if(auto it = context.outer_context.map_of_poptypes.find(value); it != context.outer_context.map_of_poptypes.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::has_pop_type_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::state) {
@@ -2977,7 +2977,7 @@ struct trigger_body {
 		context.add_float_to_payload(value);
 	}
 	void is_next_reform(association_type a, std::string_view value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_ioptions.find(std::string(value)); it != context.outer_context.map_of_ioptions.end()) {
+		if(auto it = context.outer_context.map_of_ioptions.find(value); it != context.outer_context.map_of_ioptions.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::is_next_reform_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::pop) {
@@ -2987,7 +2987,7 @@ struct trigger_body {
 				return;
 			}
 			context.compiled_trigger.push_back(trigger::payload(it->second.id).value);
-		} else if(auto it = context.outer_context.map_of_roptions.find(std::string(value)); it != context.outer_context.map_of_roptions.end()) {
+		} else if(auto it = context.outer_context.map_of_roptions.find(value); it != context.outer_context.map_of_roptions.end()) {
 			if(context.main_slot == trigger::slot_contents::nation) {
 				context.compiled_trigger.push_back(uint16_t(trigger::is_next_rreform_nation | association_to_bool_code(a)));
 			} else if(context.main_slot == trigger::slot_contents::pop) {
@@ -3591,7 +3591,7 @@ struct trigger_body {
 				return;
 			}
 			context.add_float_to_payload(value.value_);
-		} else if(auto it = context.outer_context.map_of_poptypes.find(std::string(value.type)); it != context.outer_context.map_of_poptypes.end()) {
+		} else if(auto it = context.outer_context.map_of_poptypes.find(value.type); it != context.outer_context.map_of_poptypes.end()) {
 			if(context.main_slot == trigger::slot_contents::nation)
 				context.compiled_trigger.push_back(uint16_t(trigger::pop_unemployment_nation | association_to_trigger_code(value.a)));
 			else if(context.main_slot == trigger::slot_contents::state)
@@ -3652,10 +3652,10 @@ struct trigger_body {
 	void check_variable(tr_check_variable const& value, error_handler& err, int32_t line, trigger_building_context& context) {
 		context.compiled_trigger.push_back(uint16_t(trigger::check_variable | association_to_trigger_code(value.a)));
 		context.add_float_to_payload(value.value_);
-		context.compiled_trigger.push_back(trigger::payload(context.outer_context.get_national_variable(std::string(value.which))).value);
+		context.compiled_trigger.push_back(trigger::payload(context.outer_context.get_national_variable(value.which)).value);
 	}
 	void upper_house(tr_upper_house const& value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_ideologies.find(std::string(value.ideology)); it != context.outer_context.map_of_ideologies.end()) {
+		if(auto it = context.outer_context.map_of_ideologies.find(value.ideology); it != context.outer_context.map_of_ideologies.end()) {
 			if(context.main_slot != trigger::slot_contents::nation) {
 				err.accumulated_errors += "upper_house trigger used in an invalid context (" + err.file_name + ", line " + std::to_string(line) + ")\n";
 				return;
@@ -3669,7 +3669,7 @@ struct trigger_body {
 		}
 	}
 	void unemployment_by_type(tr_unemployment_by_type const& value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_poptypes.find(std::string(value.type)); it != context.outer_context.map_of_poptypes.end()) {
+		if(auto it = context.outer_context.map_of_poptypes.find(value.type); it != context.outer_context.map_of_poptypes.end()) {
 			if(context.main_slot == trigger::slot_contents::nation)
 				context.compiled_trigger.push_back(uint16_t(trigger::unemployment_by_type_nation | association_to_trigger_code(value.a)));
 			else if(context.main_slot == trigger::slot_contents::state)
@@ -3691,7 +3691,7 @@ struct trigger_body {
 	}
 
 	void party_loyalty(tr_party_loyalty const& value, error_handler& err, int32_t line, trigger_building_context& context) {
-		if(auto it = context.outer_context.map_of_ideologies.find(std::string(value.ideology)); it != context.outer_context.map_of_ideologies.end()) {
+		if(auto it = context.outer_context.map_of_ideologies.find(value.ideology); it != context.outer_context.map_of_ideologies.end()) {
 			if(value.province_id != 0) {
 				if(0 <= value.province_id && size_t(value.province_id) < context.outer_context.original_id_to_prov_id_map.size()) {
 					if(context.main_slot == trigger::slot_contents::nation)
@@ -3905,7 +3905,7 @@ struct trigger_body {
 			context.compiled_trigger.push_back(trigger::payload(itg->second.id).value);
 			context.add_float_to_payload(parse_float(value, line, err) / 100.0f);
 		} else if(auto itf = context.outer_context.map_of_iissues.find(str_label); itf != context.outer_context.map_of_iissues.end()) {
-			if(auto itopt = context.outer_context.map_of_ioptions.find(std::string(value)); itopt != context.outer_context.map_of_ioptions.end()) {
+			if(auto itopt = context.outer_context.map_of_ioptions.find(value); itopt != context.outer_context.map_of_ioptions.end()) {
 				if(context.main_slot == trigger::slot_contents::nation)
 					context.compiled_trigger.push_back(uint16_t(trigger::variable_issue_group_name_nation | association_to_bool_code(a)));
 				else if(context.main_slot == trigger::slot_contents::pop)
@@ -3925,7 +3925,7 @@ struct trigger_body {
 				return;
 			}
 		} else if(auto itf = context.outer_context.map_of_reforms.find(str_label); itf != context.outer_context.map_of_reforms.end()) {
-			if(auto itopt = context.outer_context.map_of_roptions.find(std::string(value)); itopt != context.outer_context.map_of_roptions.end()) {
+			if(auto itopt = context.outer_context.map_of_roptions.find(value); itopt != context.outer_context.map_of_roptions.end()) {
 				if(context.main_slot == trigger::slot_contents::nation)
 					context.compiled_trigger.push_back(uint16_t(trigger::variable_reform_group_name_nation | association_to_bool_code(a)));
 				else if(context.main_slot == trigger::slot_contents::pop)
@@ -1,7 +1,12 @@
 #include "province.hpp"
 #include "dcon_generated.hpp"
 #include "system_state.hpp"
+#include "demographics.hpp"
+#include "pop_columns_generated.hpp"
 #include <vector>
+#include <functional>
+#include <algorithm>
+#include <cmath>
 
 namespace province {
 
@@ -42,6 +47,24 @@ bool nations_are_adjacent(sys::state& state, dcon::nation_id a, dcon::nation_id
 	return bool(it);
 }
 
+void set_province_owner(sys::state& state, dcon::province_id p, dcon::nation_id n) {
+	if(n)
+		state.world.force_create_province_ownership(p, n);
+	else if(auto rel = state.world.province_get_province_ownership_as_province(p); rel)
+		state.world.delete_province_ownership(rel);
+	state.map_display.mark_province_dirty(p);
+	state.mark_changed(p);
+}
+
+void set_province_controller(sys::state& state, dcon::province_id p, dcon::nation_id n) {
+	if(n)
+		state.world.force_create_province_control(p, n);
+	else if(auto rel = state.world.province_get_province_control_as_province(p); rel)
+		state.world.delete_province_control(rel);
+	state.map_display.mark_province_dirty(p);
+	state.mark_changed(p);
+}
+
 void update_connected_regions(sys::state& state) {
 	if(!state.adjacency_data_out_of_date)
 		return;
@@ -92,6 +115,285 @@ void update_connected_regions(sys::state& state) {
 	}
 }
 
+bool path_cache::find(uint64_t k, std::vector<dcon::province_id>& path_out) {
+	std::lock_guard guard(lock);
+	auto it = index.find(k);
+	if(it == index.end())
+		return false;
+	entries.splice(entries.begin(), entries, it->second);
+	path_out = it->second->path;
+	return true;
+}
+
+void path_cache::insert(uint64_t k, std::vector<dcon::province_id> const& path) {
+	std::lock_guard guard(lock);
+	if(auto it = index.find(k); it != index.end()) { // another thread finished the same search first
+		entries.splice(entries.begin(), entries, it->second);
+		return;
+	}
+	if(entries.size() >= capacity) {
+		index.erase(entries.back().k);
+		entries.pop_back();
+	}
+	entries.push_front(entry{ k, path });
+	index.insert_or_assign(k, entries.begin());
+}
+
+void path_cache::clear() {
+	std::lock_guard guard(lock);
+	entries.clear();
+	index.clear();
+}
+
+namespace {
+
+struct path_node {
+	float estimate = 0.0f; // cost so far plus the heuristic
+	float cost = 0.0f;
+	dcon::province_id id;
+};
+
+// search state indexed by province, reused between searches on the same thread; an entry is only meaningful when its
+// generation matches the current search, which saves clearing the arrays every time
+struct path_scratch {
+	std::vector<float> cost;
+	std::vector<dcon::province_id> came_from;
+	std::vector<uint32_t> generation_of;
+	std::vector<path_node> open;
+	uint32_t generation = 0;
+};
+
+float mid_point_distance(sys::state const& state, dcon::province_id a, dcon::province_id b) {
+	auto pa = state.world.province_get_mid_point(a);
+	auto pb = state.world.province_get_mid_point(b);
+	auto dx = std::abs(pa.x - pb.x);
+	// the map wraps around horizontally
+	auto width = float(state.map_display.size_x);
+	if(width > 0.0f)
+		dx = std::min(dx, width - dx);
+	auto dy = pa.y - pb.y;
+	return std::sqrt(dx * dx + dy * dy);
+}
+
+bool can_traverse(sys::state const& state, dcon::province_adjacency_id rel, dcon::province_id to, dcon::province_id end, path_type type) {
+	auto bits = state.world.province_adjacency_get_type(rel);
+	if((bits & border::impassible_bit) != 0)
+		return false;
+	bool to_sea = to.index() >= state.province_definitions.first_sea_province.index();
+	switch(type) {
+		case path_type::land:
+			return !to_sea && (bits & border::coastal_bit) == 0;
+		case path_type::sea:
+			return to_sea || (to == end && (bits & border::coastal_bit) != 0);
+	}
+	return false;
+}
+
+std::vector<dcon::province_id> search_path(sys::state& state, dcon::province_id start, dcon::province_id end, path_type type) {
+	static thread_local path_scratch scratch;
+
+	auto count = state.world.province_size();
+	if(scratch.cost.size() < count) {
+		scratch.cost.resize(count);
+		scratch.came_from.resize(count);
+		scratch.generation_of.resize(count, 0);
+	}
+	++scratch.generation;
+	if(scratch.generation == 0) {
+		std::fill(scratch.generation_of.begin(), scratch.generation_of.end(), 0);
+		scratch.generation = 1;
+	}
+	auto const generation = scratch.generation;
+
+	auto& open = scratch.open;
+	open.clear();
+	auto const heap_order = [](path_node const& a, path_node const& b) { return a.estimate > b.estimate; };
+
+	scratch.cost[start.index()] = 0.0f;
+	scratch.came_from[start.index()] = dcon::province_id();
+	scratch.generation_of[start.index()] = generation;
+	open.push_back(path_node{ mid_point_distance(state, start, end), 0.0f, start });
+
+	while(!open.empty()) {
+		std::pop_heap(open.begin(), open.end(), heap_order);
+		auto node = open.back();
+		open.pop_back();
+
+		if(node.cost > scratch.cost[node.id.index()]) // a shorter way here was found after this node was queued
+			continue;
+
+		if(node.id == end) {
+			std::vector<dcon::province_id> path;
+			for(auto p = end; p != start; p = scratch.came_from[p.index()])
+				path.push_back(p);
+			std::reverse(path.begin(), path.end());
+			return path;
+		}
+
+		for(auto rel : state.world.province_get_province_adjacency(node.id)) {
+			auto a = rel.get_connected_provinces(0).id;
+			auto other = a == node.id ? rel.get_connected_provinces(1).id : a;
+			if(!can_traverse(state, rel.id, other, end, type))
+				continue;
+
+			auto cost = node.cost + mid_point_distance(state, node.id, other);
+			auto i = other.index();
+			if(scratch.generation_of[i] != generation || cost < scratch.cost[i]) {
+				scratch.generation_of[i] = generation;
+				scratch.cost[i] = cost;
+				scratch.came_from[i] = node.id;
+				open.push_back(path_node{ cost + mid_point_distance(state, other, end), cost, other });
+				std::push_heap(open.begin(), open.end(), heap_order);
+			}
+		}
+	}
+
+	return std::vector<dcon::province_id>();
+}
+
+}
+
+std::vector<dcon::province_id> make_path(sys::state& state, dcon::province_id start, dcon::province_id end, path_type type) {
+	if(!start || !end || start == end)
+		return std::vector<dcon::province_id>();
+
+	auto k = path_cache::key(start, end, type);
+	std::vector<dcon::province_id> path;
+	if(state.province_paths.find(k, path))
+		return path;
+
+	path = search_path(state, start, end, type);
+	state.province_paths.insert(k, path);
+	return path;
+}
+
+void make_paths(sys::state& state, std::vector<path_request> const& requests, std::vector<std::vector<dcon::province_id>>& results) {
+	results.resize(requests.size());
+	concurrency::parallel_for(size_t(0), requests.size(), [&](size_t i) {
+		results[i] = make_path(state, requests[i].start, requests[i].end, requests[i].type);
+	});
+}
+
+template<typename F>
+void for_each_pop_in_range(sys::state& state, dcon::province_id p, F const& func) {
+	assert(!state.pop_ranges_out_of_date);
+	auto last = state.world.province_get_pop_range_end(p);
+	for(uint32_t i = state.world.province_get_pop_range_begin(p); i < last; ++i) {
+		func(dcon::pop_id{ dcon::pop_id::value_base_t(i) });
+	}
+}
+
+template<typename G, typename S>
+void permute_pop_column(std::vector<dcon::pop_id> const& source_of, G const& get, S const& set) {
+	using value_type = std::remove_cvref_t<decltype(get(dcon::pop_id{}))>;
+	std::vector<value_type> temp(source_of.size());
+	for(size_t i = 0; i < source_of.size(); ++i) {
+		temp[i] = get(source_of[i]);
+	}
+	for(size_t i = 0; i < source_of.size(); ++i) {
+		set(dcon::pop_id{ dcon::pop_id::value_base_t(i) }, temp[i]);
+	}
+}
+
+void sort_pops_by_location(sys::state& state) {
+	if(!state.pop_ranges_out_of_date)
+		return;
+
+	state.pop_ranges_out_of_date = false;
+
+	auto const pop_count = state.world.pop_size();
+	auto const province_count = state.world.province_size();
+
+	// counting sort: pops without a location (if any) are placed after all provinces
+	static std::vector<uint32_t> next_position;
+	next_position.assign(province_count + 1, 0);
+	state.world.for_each_pop([&](dcon::pop_id p) {
+		auto location = state.world.pop_get_province_from_pop_location(p);
+		++next_position[location ? location.index() : province_count];
+	});
+	uint32_t running_total = 0;
+	for(uint32_t i = 0; i <= province_count; ++i) {
+		auto count = next_position[i];
+		next_position[i] = running_total;
+		running_total += count;
+	}
+	for(uint32_t i = 0; i < province_count; ++i) {
+		dcon::province_id pid{ dcon::province_id::value_base_t(i) };
+		state.world.province_set_pop_range_begin(pid, next_position[i]);
+		state.world.province_set_pop_range_end(pid, next_position[i + 1]);
+	}
+
+	static std::vector<dcon::pop_id> new_id_of;
+	static std::vector<dcon::pop_id> source_of;
+	new_id_of.resize(pop_count);
+	source_of.resize(pop_count);
+
+	bool already_sorted = true;
+	state.world.for_each_pop([&](dcon::pop_id p) {
+		auto location = state.world.pop_get_province_from_pop_location(p);
+		auto destination = next_position[location ? location.index() : province_count]++;
+		new_id_of[p.index()] = dcon::pop_id{ dcon::pop_id::value_base_t(destination) };
+		source_of[destination] = p;
+		already_sorted = already_sorted && destination == uint32_t(p.index());
+	});
+
+	if(already_sorted)
+		return;
+
+	// every column of the pop object, as listed in dcon_generated.txt, is permuted as its own task
+	static std::vector<std::function<void()>> column_tasks;
+	column_tasks.clear();
+#define ALICE_PERMUTE_SCALAR(name) \
+	column_tasks.push_back([&]() { \
+		permute_pop_column(source_of, [&](dcon::pop_id p) { return state.world.pop_get_##name(p); }, \
+				[&](dcon::pop_id p, auto v) { state.world.pop_set_##name(p, v); }); \
+	});
+#define ALICE_PERMUTE_ARRAY(name, key_type) \
+	for(uint32_t i = 0; i < state.world.pop_get_##name##_size(); ++i) { \
+		column_tasks.push_back([&, i]() { \
+			dcon::key_type k{ dcon::key_type::value_base_t(i) }; \
+			permute_pop_column(source_of, [&](dcon::pop_id p) { return state.world.pop_get_##name(p, k); }, \
+					[&](dcon::pop_id p, auto v) { state.world.pop_set_##name(p, k, v); }); \
+		}); \
+	}
+	DCON_POP_PROPERTIES(ALICE_PERMUTE_SCALAR, ALICE_PERMUTE_ARRAY)
+#undef ALICE_PERMUTE_ARRAY
+#undef ALICE_PERMUTE_SCALAR
+
+	// relationships that refer to pops from the many side can be retargeted in place
+#define ALICE_RETARGET_POP(relationship, link) \
+	column_tasks.push_back([&]() { \
+		state.world.for_each_##relationship([&](dcon::relationship##_id r) { \
+			auto p = state.world.relationship##_get_##link(r); \
+			if(p) \
+				state.world.relationship##_set_##link(r, new_id_of[p.index()]); \
+		}); \
+	});
+	DCON_POP_MANY_RELATIONSHIPS(ALICE_RETARGET_POP)
+#undef ALICE_RETARGET_POP
+
+	concurrency::parallel_for(size_t(0), column_tasks.size(), [&](size_t i) { column_tasks[i](); });
+
+	// relationships where the pop is the unique side are rebuilt so that the per-province lists of pops also end up in order
+#define ALICE_REBUILD_POP_RELATIONSHIP(relationship, other) \
+	{ \
+		static std::vector<std::remove_cvref_t<decltype(state.world.pop_get_##other##_from_##relationship(dcon::pop_id{}))>> others; \
+		others.resize(pop_count); \
+		for(uint32_t i = 0; i < pop_count; ++i) { \
+			others[i] = state.world.pop_get_##other##_from_##relationship(source_of[i]); \
+		} \
+		state.world.for_each_pop([&](dcon::pop_id p) { \
+			if(auto rel = state.world.pop_get_##relationship##_as_pop(p); rel) \
+				state.world.delete_##relationship(rel); \
+		}); \
+		for(uint32_t i = 0; i < pop_count; ++i) { \
+			if(others[i]) \
+				state.world.force_create_##relationship(dcon::pop_id{ dcon::pop_id::value_base_t(i) }, others[i]); \
+		} \
+	}
+	DCON_POP_UNIQUE_RELATIONSHIPS(ALICE_REBUILD_POP_RELATIONSHIP)
+#undef ALICE_REBUILD_POP_RELATIONSHIP
+}
 
 void restore_unsaved_values(sys::state& state) {
 	//clear nation values that cache province information
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <list>
+#include <mutex>
 #include "dcon_generated.hpp"
 
 namespace province {
@@ -29,6 +31,48 @@ struct global_provincial_state {
 	dcon::modifier_id oceania;
 };
 
+enum class path_type : uint8_t {
+	land, // never enters the sea or crosses an impassible border
+	sea // stays in sea provinces, except that the destination may be a coastal land province
+};
+
+// a bounded, least recently used cache of finished searches, shared by every thread that asks for paths
+// nothing clears it on its own: call clear() whenever the type of a province_adjacency changes
+class path_cache {
+public:
+	static constexpr size_t capacity = 4096;
+
+	static uint64_t key(dcon::province_id start, dcon::province_id end, path_type type) {
+		return (uint64_t(start.index()) << 33) | (uint64_t(end.index()) << 1) | uint64_t(type);
+	}
+
+	bool find(uint64_t k, std::vector<dcon::province_id>& path_out);
+	void insert(uint64_t k, std::vector<dcon::province_id> const& path);
+	void clear();
+
+private:
+	struct entry {
+		uint64_t k = 0;
+		std::vector<dcon::province_id> path;
+	};
+
+	std::mutex lock;
+	std::list<entry> entries; // most recently used first
+	ankerl::unordered_dense::map<uint64_t, std::list<entry>::iterator> index;
+};
+
+struct path_request {
+	dcon::province_id start;
+	dcon::province_id end;
+	path_type type = path_type::land;
+};
+
+// A* search over province_adjacency, with the distance between province mid points as both the step cost and the heuristic
+// the result lists the provinces to move through in order, excluding start and including end; it is empty when end cannot be reached
+std::vector<dcon::province_id> make_path(sys::state& state, dcon::province_id start, dcon::province_id end, path_type type);
+// answers many requests at once, spread over the worker threads; results[i] is the path for requests[i]
+void make_paths(sys::state& state, std::vector<path_request> const& requests, std::vector<std::vector<dcon::province_id>>& results);
+
 template<typename F>
 void for_each_land_province(sys::state& state, F const& func);
 
@@ -36,7 +80,20 @@ template<typename F>
 void for_each_sea_province(sys::state& state, F const& func);
 
 bool nations_are_adjacent(sys::state& state, dcon::nation_id a, dcon::nation_id b);
+
+// change the owner / controller of a province (an empty nation id removes it) and mark the province as changed for the
+// map and the ui; all ownership and occupation changes should go through these
+void set_province_owner(sys::state& state, dcon::province_id p, dcon::nation_id n);
+void set_province_controller(sys::state& state, dcon::province_id p, dcon::nation_id n);
 void update_connected_regions(sys::state& state);
+
+// permutes the pops so that the pops of each province are stored contiguously and in province order
+// afterwards, and as long as state.pop_ranges_out_of_date is false, the pops located in province p
+// are exactly the ids in [province_get_pop_range_begin(p), province_get_pop_range_end(p))
+void sort_pops_by_location(sys::state& state);
+
+template<typename F>
+void for_each_pop_in_range(sys::state& state, dcon::province_id p, F const& func);
 void restore_unsaved_values(sys::state& state);
 
 template<typename T>
@@ -0,0 +1,559 @@
+#include "effects.hpp"
+#include "triggers.hpp"
+#include "system_state.hpp"
+
+namespace effect {
+
+namespace {
+
+enum class command_type : uint8_t {
+	treasury,
+	prestige,
+	infamy,
+	war_exhaustion,
+	research_points,
+	pop_savings,
+	pop_militancy,
+	pop_consciousness,
+	pop_literacy,
+	set_national_flag,
+	clear_national_flag,
+	set_global_flag,
+	clear_global_flag,
+	relation, // creates the relation between the two nations if they do not have one yet
+	add_core, // target is the province, other the national identity; creates the core unless it already exists
+};
+
+// a deferred write; target and other are the raw indices of whatever the command type refers to
+struct command {
+	command_type type = command_type::treasury;
+	int32_t target = 0;
+	int32_t other = 0;
+	float amount = 0.0f;
+};
+
+// invocations are handed out to the worker threads in chunks of this many, and each chunk records into its own buffer
+constexpr inline size_t invocations_per_chunk = 64;
+
+struct execution_context {
+	sys::state& ws;
+	std::vector<command>& out;
+	uint32_t& unsupported;
+	int32_t this_slot = 0;
+	int32_t from_slot = 0;
+	uint64_t random_state = 0;
+
+	// splitmix64; the stream is seeded from the invocation alone, so the rolls do not depend on the batch the effect ran in
+	uint64_t next_random() {
+		uint64_t z = (random_state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+	// uniform in [0, bound); bound must be positive
+	uint32_t random_below(uint32_t bound) {
+		return uint32_t(next_random() % bound);
+	}
+
+	void record(command_type type, int32_t target, int32_t other, float amount) {
+		if(target >= 0)
+			out.push_back(command{ type, target, other, amount });
+	}
+	// the effect or scope is skipped, and counted so that the caller can report it
+	void skip_unsupported() {
+		++unsupported;
+	}
+};
+
+void execute(uint16_t const* tval, int32_t primary, execution_context& ctx);
+
+bool passes_limit(uint16_t const* tval, int32_t candidate, execution_context& ctx) {
+	if((tval[0] & effect::scope_has_limit) == 0)
+		return true;
+	auto limit = trigger::payload(tval[2]).tr_id;
+	return !limit || trigger::evaluate_trigger_memoized(ctx.ws, limit, candidate, ctx.this_slot, ctx.from_slot);
+}
+
+void execute_members(uint16_t const* tval, int32_t primary, execution_context& ctx) {
+	auto const end = tval + 1 + parsers::get_effect_scope_payload_size(tval);
+	auto sub_units_start = tval + 2 + parsers::effect_scope_data_payload(tval[0]);
+	while(sub_units_start < end) {
+		execute(sub_units_start, primary, ctx);
+		sub_units_start += 1 + parsers::get_generic_effect_payload_size(sub_units_start);
+	}
+}
+
+// the data word of a scope, which follows the limit when there is one
+uint16_t scope_data(uint16_t const* tval) {
+	return tval[2 + ((tval[0] & effect::scope_has_limit) != 0)];
+}
+
+void execute_single(uint16_t const* tval, int32_t target, execution_context& ctx) {
+	if(target >= 0 && passes_limit(tval, target, ctx))
+		execute_members(tval, target, ctx);
+}
+
+// runs the members of a scope over every candidate that passes the limit, or over one of them at random for random_x scopes
+void execute_over(uint16_t const* tval, std::vector<int32_t> const& candidates, execution_context& ctx) {
+	if((tval[0] & effect::is_random_scope) != 0) {
+		std::vector<int32_t> passing;
+		for(auto c : candidates) {
+			if(passes_limit(tval, c, ctx))
+				passing.push_back(c);
+		}
+		if(!passing.empty())
+			execute_members(tval, passing[ctx.random_below(uint32_t(passing.size()))], ctx);
+	} else {
+		for(auto c : candidates) {
+			if(passes_limit(tval, c, ctx))
+				execute_members(tval, c, ctx);
+		}
+	}
+}
+
+void add_pops_of_province(sys::state& ws, dcon::province_id p, dcon::pop_type_id type, std::vector<int32_t>& out) {
+	for(auto i : ws.world.province_get_pop_location(p)) {
+		if(!type || i.get_pop().get_poptype().id == type)
+			out.push_back(trigger::to_generic(i.get_pop().id));
+	}
+}
+void add_owned_provinces_of_state(sys::state& ws, dcon::state_instance_id s, std::vector<int32_t>& out) {
+	auto owner = ws.world.state_instance_get_nation_from_state_ownership(s);
+	for(auto p : ws.world.state_definition_get_abstract_state_membership(ws.world.state_instance_get_definition(s))) {
+		if(p.get_province().get_nation_from_province_ownership() == owner)
+			out.push_back(trigger::to_generic(p.get_province().id));
+	}
+}
+void add_pops_of_nation(sys::state& ws, dcon::nation_id n, dcon::pop_type_id type, std::vector<int32_t>& out) {
+	for(auto p : ws.world.nation_get_province_ownership(n))
+		add_pops_of_province(ws, p.get_province().id, type, out);
+}
+void add_pops_of_state(sys::state& ws, dcon::state_instance_id s, dcon::pop_type_id type, std::vector<int32_t>& out) {
+	std::vector<int32_t> provinces;
+	add_owned_provinces_of_state(ws, s, provinces);
+	for(auto p : provinces)
+		add_pops_of_province(ws, trigger::to_prov(p), type, out);
+}
+
+void execute_scope(uint16_t const* tval, int32_t primary, execution_context& ctx) {
+	auto& ws = ctx.ws;
+	switch(tval[0] & effect::code_mask) {
+		case effect::generic_scope:
+			execute_single(tval, primary, ctx);
+			return;
+		case effect::x_pop_scope_nation:
+		{
+			std::vector<int32_t> candidates;
+			add_pops_of_nation(ws, trigger::to_nation(primary), dcon::pop_type_id(), candidates);
+			execute_over(tval, candidates, ctx);
+			return;
+		}
+		case effect::x_pop_scope_state:
+		{
+			std::vector<int32_t> candidates;
+			add_pops_of_state(ws, trigger::to_state(primary), dcon::pop_type_id(), candidates);
+			execute_over(tval, candidates, ctx);
+			return;
+		}
+		case effect::x_pop_scope_province:
+		{
+			std::vector<int32_t> candidates;
+			add_pops_of_province(ws, trigger::to_prov(primary), dcon::pop_type_id(), candidates);
+			execute_over(tval, candidates, ctx);
+			return;
+		}
+		case effect::pop_type_scope_nation:
+		{
+			std::vector<int32_t> candidates;
+			add_pops_of_nation(ws, trigger::to_nation(primary), trigger::payload(scope_data(tval)).popt_id, candidates);
+			execute_over(tval, candidates, ctx);
+			return;
+		}
+		case effect::pop_type_scope_state:
+		{
+			std::vector<int32_t> candidates;
+			add_pops_of_state(ws, trigger::to_state(primary), trigger::payload(scope_data(tval)).popt_id, candidates);
+			execute_over(tval, candidates, ctx);
+			return;
+		}
+		case effect::pop_type_scope_province:
+		{
+			std::vector<int32_t> candidates;
+			add_pops_of_province(ws, trigger::to_prov(primary), trigger::payload(scope_data(tval)).popt_id, candidates);
+			execute_over(tval, candidates, ctx);
+			return;
+		}
+		case effect::x_owned_scope_nation:
+		{
+			std::vector<int32_t> candidates;
+			for(auto p : ws.world.nation_get_province_ownership(trigger::to_nation(primary)))
+				candidates.push_back(trigger::to_generic(p.get_province().id));
+			execute_over(tval, candidates, ctx);
+			return;
+		}
+		case effect::x_owned_scope_state:
+		{
+			std::vector<int32_t> candidates;
+			add_owned_provinces_of_state(ws, trigger::to_state(primary), candidates);
+			execute_over(tval, candidates, ctx);
+			return;
+		}
+		case effect::random_scope:
+		{
+			auto chance = scope_data(tval);
+			if(ctx.random_below(100) < chance)
+				execute_single(tval, primary, ctx);
+			return;
+		}
+		case effect::random_list_scope:
+		{
+			auto chances_total = tval[2];
+			if(chances_total == 0)
+				return;
+			auto roll = ctx.random_below(chances_total);
+
+			auto const end = tval + 1 + parsers::get_effect_scope_payload_size(tval);
+			auto sub_units_start = tval + 4; // [code] + [payload size] + [chances total] + [first sub effect chance]
+			while(sub_units_start < end) {
+				auto chance = sub_units_start[-1];
+				if(roll < chance) {
+					execute(sub_units_start, primary, ctx);
+					return;
+				}
+				roll -= chance;
+				sub_units_start += 2 + parsers::get_generic_effect_payload_size(sub_units_start); // each member preceded by uint16_t
+			}
+			return;
+		}
+		case effect::owner_scope_state:
+			execute_single(tval, trigger::to_generic(ws.world.state_instance_get_nation_from_state_ownership(trigger::to_state(primary))), ctx);
+			return;
+		case effect::owner_scope_province:
+			execute_single(tval, trigger::to_generic(ws.world.province_get_nation_from_province_ownership(trigger::to_prov(primary))), ctx);
+			return;
+		case effect::controller_scope:
+			execute_single(tval, trigger::to_generic(ws.world.province_get_nation_from_province_control(trigger::to_prov(primary))), ctx);
+			return;
+		case effect::location_scope:
+			execute_single(tval, trigger::to_generic(ws.world.pop_get_province_from_pop_location(trigger::to_pop(primary))), ctx);
+			return;
+		case effect::country_scope_pop:
+		{
+			auto location = ws.world.pop_get_province_from_pop_location(trigger::to_pop(primary));
+			execute_single(tval, trigger::to_generic(ws.world.province_get_nation_from_province_ownership(location)), ctx);
+			return;
+		}
+		case effect::country_scope_state:
+			execute_single(tval, trigger::to_generic(ws.world.state_instance_get_nation_from_state_ownership(trigger::to_state(primary))), ctx);
+			return;
+		case effect::capital_scope:
+			execute_single(tval, trigger::to_generic(ws.world.nation_get_capital(trigger::to_nation(primary))), ctx);
+			return;
+		case effect::state_scope_pop:
+		{
+			auto location = ws.world.pop_get_province_from_pop_location(trigger::to_pop(primary));
+			execute_single(tval, trigger::to_generic(ws.world.province_get_state_membership(location)), ctx);
+			return;
+		}
+		case effect::state_scope_province:
+			execute_single(tval, trigger::to_generic(ws.world.province_get_state_membership(trigger::to_prov(primary))), ctx);
+			return;
+		case effect::this_scope_nation:
+		case effect::this_scope_state:
+		case effect::this_scope_province:
+		case effect::this_scope_pop:
+			execute_single(tval, ctx.this_slot, ctx);
+			return;
+		case effect::from_scope_nation:
+		case effect::from_scope_state:
+		case effect::from_scope_province:
+		case effect::from_scope_pop:
+			execute_single(tval, ctx.from_slot, ctx);
+			return;
+		case effect::tag_scope:
+			execute_single(tval, trigger::to_generic(ws.world.national_identity_get_nation_from_identity_holder(trigger::payload(scope_data(tval)).tag_id)), ctx);
+			return;
+		case effect::integer_scope:
+			execute_single(tval, trigger::to_generic(trigger::payload(scope_data(tval)).prov_id), ctx);
+			return;
+		default:
+			ctx.skip_unsupported();
+			return;
+	}
+}
+
+void record_relation(execution_context& ctx, dcon::nation_id a, dcon::nation_id b, int16_t amount) {
+	if(a && b && a != b)
+		ctx.record(command_type::relation, trigger::to_generic(a), trigger::to_generic(b), float(amount));
+}
+void record_core(execution_context& ctx, dcon::province_id p, dcon::national_identity_id ident) {
+	if(p && ident)
+		ctx.record(command_type::add_core, trigger::to_generic(p), int32_t(ident.index()), 0.0f);
+}
+void record_core(execution_context& ctx, dcon::province_id p, dcon::nation_id n) {
+	record_core(ctx, p, ctx.ws.world.nation_get_identity_from_identity_holder(n));
+}
+dcon::nation_id province_owner(sys::state& ws, int32_t p) {
+	return ws.world.province_get_nation_from_province_ownership(trigger::to_prov(p));
+}
+
+void execute_non_scope(uint16_t const* tval, int32_t primary, execution_context& ctx) {
+	auto& ws = ctx.ws;
+	switch(tval[0] & effect::code_mask) {
+		case effect::treasury:
+			ctx.record(command_type::treasury, primary, 0, trigger::read_float_from_payload(tval + 1));
+			return;
+		case effect::prestige:
+			ctx.record(command_type::prestige, primary, 0, trigger::read_float_from_payload(tval + 1));
+			return;
+		case effect::badboy:
+			ctx.record(command_type::infamy, primary, 0, trigger::read_float_from_payload(tval + 1));
+			return;
+		case effect::war_exhaustion:
+			ctx.record(command_type::war_exhaustion, primary, 0, trigger::read_float_from_payload(tval + 1));
+			return;
+		case effect::research_points:
+			ctx.record(command_type::research_points, primary, 0, float(trigger::payload(tval[1]).signed_value));
+			return;
+		case effect::money:
+			ctx.record(command_type::pop_savings, primary, 0, trigger::read_float_from_payload(tval + 1));
+			return;
+		case effect::militancy:
+			ctx.record(command_type::pop_militancy, primary, 0, trigger::read_float_from_payload(tval + 1));
+			return;
+		case effect::consciousness:
+			ctx.record(command_type::pop_consciousness, primary, 0, trigger::read_float_from_payload(tval + 1));
+			return;
+		case effect::literacy:
+			ctx.record(command_type::pop_literacy, primary, 0, trigger::read_float_from_payload(tval + 1));
+			return;
+		case effect::set_country_flag:
+			ctx.record(command_type::set_national_flag, primary, trigger::payload(tval[1]).natf_id.index(), 0.0f);
+			return;
+		case effect::set_country_flag_province:
+			ctx.record(command_type::set_national_flag, trigger::to_generic(province_owner(ws, primary)), trigger::payload(tval[1]).natf_id.index(), 0.0f);
+			return;
+		case effect::clr_country_flag:
+			ctx.record(command_type::clear_national_flag, primary, trigger::payload(tval[1]).natf_id.index(), 0.0f);
+			return;
+		case effect::set_global_flag:
+			ctx.record(command_type::set_global_flag, trigger::payload(tval[1]).glob_id.index(), 0, 0.0f);
+			return;
+		case effect::clr_global_flag:
+			ctx.record(command_type::clear_global_flag, trigger::payload(tval[1]).glob_id.index(), 0, 0.0f);
+			return;
+		case effect::relation:
+			record_relation(ctx, trigger::to_nation(primary), ws.world.national_identity_get_nation_from_identity_holder(trigger::payload(tval[1]).tag_id), trigger::payload(tval[2]).signed_value);
+			return;
+		case effect::relation_this_nation:
+			record_relation(ctx, trigger::to_nation(primary), trigger::to_nation(ctx.this_slot), trigger::payload(tval[1]).signed_value);
+			return;
+		case effect::relation_this_province:
+			record_relation(ctx, trigger::to_nation(primary), ws.world.province_get_nation_from_province_ownership(trigger::to_prov(ctx.this_slot)), trigger::payload(tval[1]).signed_value);
+			return;
+		case effect::relation_from_nation:
+			record_relation(ctx, trigger::to_nation(primary), trigger::to_nation(ctx.from_slot), trigger::payload(tval[1]).signed_value);
+			return;
+		case effect::relation_from_province:
+			record_relation(ctx, trigger::to_nation(primary), province_owner(ws, ctx.from_slot), trigger::payload(tval[1]).signed_value);
+			return;
+		// in a province scope, the relation is that of the owner of the province
+		case effect::relation_province:
+			record_relation(ctx, province_owner(ws, primary), ws.world.national_identity_get_nation_from_identity_holder(trigger::payload(tval[1]).tag_id), trigger::payload(tval[2]).signed_value);
+			return;
+		case effect::relation_province_this_nation:
+			record_relation(ctx, province_owner(ws, primary), trigger::to_nation(ctx.this_slot), trigger::payload(tval[1]).signed_value);
+			return;
+		case effect::relation_province_this_province:
+			record_relation(ctx, province_owner(ws, primary), province_owner(ws, ctx.this_slot), trigger::payload(tval[1]).signed_value);
+			return;
+		case effect::relation_province_from_nation:
+			record_relation(ctx, province_owner(ws, primary), trigger::to_nation(ctx.from_slot), trigger::payload(tval[1]).signed_value);
+			return;
+		case effect::relation_province_from_province:
+			record_relation(ctx, province_owner(ws, primary), province_owner(ws, ctx.from_slot), trigger::payload(tval[1]).signed_value);
+			return;
+		case effect::add_core_tag:
+			record_core(ctx, trigger::to_prov(primary), trigger::payload(tval[1]).tag_id);
+			return;
+		case effect::add_core_int:
+			record_core(ctx, trigger::payload(tval[1]).prov_id, trigger::to_nation(primary));
+			return;
+		case effect::add_core_this_nation:
+			record_core(ctx, trigger::to_prov(primary), trigger::to_nation(ctx.this_slot));
+			return;
+		case effect::add_core_this_province:
+			record_core(ctx, trigger::to_prov(primary), province_owner(ws, ctx.this_slot));
+			return;
+		case effect::add_core_this_state:
+			record_core(ctx, trigger::to_prov(primary), ws.world.state_instance_get_nation_from_state_ownership(trigger::to_state(ctx.this_slot)));
+			return;
+		case effect::add_core_this_pop:
+			record_core(ctx, trigger::to_prov(primary), province_owner(ws, trigger::to_generic(ws.world.pop_get_province_from_pop_location(trigger::to_pop(ctx.this_slot)))));
+			return;
+		case effect::add_core_from_nation:
+			record_core(ctx, trigger::to_prov(primary), trigger::to_nation(ctx.from_slot));
+			return;
+		case effect::add_core_from_province:
+			record_core(ctx, trigger::to_prov(primary), province_owner(ws, ctx.from_slot));
+			return;
+		default:
+			ctx.skip_unsupported();
+			return;
+	}
+}
+
+void execute(uint16_t const* tval, int32_t primary, execution_context& ctx) {
+	if((tval[0] & effect::is_scope) != 0)
+		execute_scope(tval, primary, ctx);
+	else
+		execute_non_scope(tval, primary, ctx);
+}
+
+uint64_t invocation_seed(sys::state const& state, effect_invocation const& inv) {
+	uint64_t h = uint64_t(uint32_t(state.current_date.to_raw_value())) * 0x9E3779B97F4A7C15ull;
+	h = (h ^ uint16_t(inv.effect.index())) * 0xBF58476D1CE4E5B9ull;
+	h = (h ^ uint32_t(inv.primary_slot)) * 0x94D049BB133111EBull;
+	h = (h ^ uint32_t(inv.this_slot)) * 0xBF58476D1CE4E5B9ull;
+	h = (h ^ uint32_t(inv.from_slot)) * 0x94D049BB133111EBull;
+	return h;
+}
+
+void apply_command(sys::state& state, command const& c) {
+	switch(c.type) {
+		case command_type::treasury:
+		{
+			auto n = trigger::to_nation(c.target);
+			state.world.nation_set_stockpiles(n, economy::money, state.world.nation_get_stockpiles(n, economy::money) + c.amount);
+			state.mark_changed(n);
+			return;
+		}
+		case command_type::prestige:
+		{
+			auto n = trigger::to_nation(c.target);
+			state.world.nation_set_prestige(n, state.world.nation_get_prestige(n) + c.amount);
+			state.mark_changed(n);
+			return;
+		}
+		case command_type::infamy:
+		{
+			auto n = trigger::to_nation(c.target);
+			state.world.nation_set_infamy(n, std::max(0.0f, state.world.nation_get_infamy(n) + c.amount));
+			state.mark_changed(n);
+			return;
+		}
+		case command_type::war_exhaustion:
+		{
+			auto n = trigger::to_nation(c.target);
+			state.world.nation_set_war_exhaustion(n, std::max(0.0f, state.world.nation_get_war_exhaustion(n) + c.amount));
+			state.mark_changed(n);
+			return;
+		}
+		case command_type::research_points:
+		{
+			auto n = trigger::to_nation(c.target);
+			state.world.nation_set_research_points(n, state.world.nation_get_research_points(n) + c.amount);
+			state.mark_changed(n);
+			return;
+		}
+		case command_type::pop_savings:
+		{
+			auto p = trigger::to_pop(c.target);
+			state.world.pop_set_savings(p, std::max(0.0f, state.world.pop_get_savings(p) + c.amount));
+			state.mark_changed(state.world.pop_get_province_from_pop_location(p));
+			return;
+		}
+		case command_type::pop_militancy:
+		{
+			auto p = trigger::to_pop(c.target);
+			state.world.pop_set_militancy(p, std::clamp(state.world.pop_get_militancy(p) + c.amount, 0.0f, 10.0f));
+			state.mark_changed(state.world.pop_get_province_from_pop_location(p));
+			return;
+		}
+		case command_type::pop_consciousness:
+		{
+			auto p = trigger::to_pop(c.target);
+			state.world.pop_set_consciousness(p, std::clamp(state.world.pop_get_consciousness(p) + c.amount, 0.0f, 10.0f));
+			state.mark_changed(state.world.pop_get_province_from_pop_location(p));
+			return;
+		}
+		case command_type::pop_literacy:
+		{
+			auto p = trigger::to_pop(c.target);
+			state.world.pop_set_literacy(p, std::clamp(state.world.pop_get_literacy(p) + c.amount, 0.0f, 1.0f));
+			state.mark_changed(state.world.pop_get_province_from_pop_location(p));
+			return;
+		}
+		case command_type::set_national_flag:
+		case command_type::clear_national_flag:
+			if(c.other >= 0) {
+				state.world.nation_set_flag_variables(trigger::to_nation(c.target), dcon::national_flag_id(dcon::national_flag_id::value_base_t(c.other)), c.type == command_type::set_national_flag);
+				state.mark_changed(trigger::to_nation(c.target));
+			}
+			return;
+		case command_type::set_global_flag:
+		case command_type::clear_global_flag:
+			state.national_definitions.set_global_flag_variable(dcon::global_flag_id(dcon::global_flag_id::value_base_t(c.target)), c.type == command_type::set_global_flag);
+			return;
+		case command_type::relation:
+		{
+			auto a = trigger::to_nation(c.target);
+			auto b = trigger::to_nation(c.other);
+			auto rel = state.world.get_diplomatic_relation_by_diplomatic_pair(a, b);
+			if(!rel)
+				rel = state.world.force_create_diplomatic_relation(a, b);
+			state.world.diplomatic_relation_set_value(rel, std::clamp(state.world.diplomatic_relation_get_value(rel) + int32_t(c.amount), -200, 200));
+			state.mark_changed(a);
+			state.mark_changed(b);
+			return;
+		}
+		case command_type::add_core:
+		{
+			auto p = trigger::to_prov(c.target);
+			state.world.try_create_core(p, dcon::national_identity_id(dcon::national_identity_id::value_base_t(c.other)));
+			state.mark_changed(p);
+			return;
+		}
+	}
+}
+
+}
+
+uint32_t execute_effects(sys::state& state, std::vector<effect_invocation> const& invocations) {
+	auto const chunk_count = (invocations.size() + invocations_per_chunk - 1) / invocations_per_chunk;
+	std::vector<std::vector<command>> buffers(chunk_count);
+	std::vector<uint32_t> unsupported(chunk_count, 0);
+
+	concurrency::parallel_for(size_t(0), chunk_count, [&](size_t chunk) {
+		auto& out = buffers[chunk];
+		auto const last = std::min(invocations.size(), (chunk + 1) * invocations_per_chunk);
+		for(size_t i = chunk * invocations_per_chunk; i < last; ++i) {
+			auto const& inv = invocations[i];
+			if(!inv.effect)
+				continue;
+			execution_context ctx{ state, out, unsupported[chunk], inv.this_slot, inv.from_slot, invocation_seed(state, inv) };
+			execute(state.effect_data.data() + inv.effect.index(), inv.primary_slot, ctx);
+		}
+	});
+
+	// the sync point: chunks cover consecutive invocations, so applying them in chunk order applies the writes in invocation order
+	bool any_written = false;
+	for(auto const& buffer : buffers) {
+		for(auto const& c : buffer)
+			apply_command(state, c);
+		any_written = any_written || !buffer.empty();
+	}
+	if(any_written)
+		state.trigger_memo.clear();
+
+	uint32_t total_unsupported = 0;
+	for(auto count : unsupported)
+		total_unsupported += count;
+	return total_unsupported;
+}
+
+uint32_t execute_effect(sys::state& state, dcon::effect_key key, int32_t primary, int32_t this_slot, int32_t from_slot) {
+	return execute_effects(state, std::vector<effect_invocation>{ effect_invocation{ key, primary, this_slot, from_slot } });
+}
+
+}
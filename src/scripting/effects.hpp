@@ -0,0 +1,26 @@
+#pragma once
+
+#include "script_constants.hpp"
+#include "dcon_generated.hpp"
+#include "container_types.hpp"
+
+namespace effect {
+
+struct effect_invocation {
+	dcon::effect_key effect;
+	int32_t primary_slot = 0;
+	int32_t this_slot = 0;
+	int32_t from_slot = 0;
+};
+
+// Runs a batch of effects in parallel. While the batch runs, the game state is only read: limits, random choices, and the
+// scopes an effect fans out over are all resolved against the state as it was before the batch. What the effects would write
+// is recorded into a command buffer per chunk of invocations, and the buffers are applied once every invocation has run, in
+// the order the invocations were given. The outcome is therefore the same however the chunks were scheduled. Not every effect
+// is handled by the executor yet: an unhandled effect or scope is skipped (the rest of its invocation still runs), and the
+// number of those skipped is returned, so a result other than zero means the batch was not carried out in full.
+uint32_t execute_effects(sys::state& state, std::vector<effect_invocation> const& invocations);
+// a batch of one
+uint32_t execute_effect(sys::state& state, dcon::effect_key key, int32_t primary, int32_t this_slot, int32_t from_slot);
+
+}
@@ -3007,7 +3007,7 @@ TRIGGER_FUNCTION(tf_agree_with_ruling_party) {
 	auto ruling_ideology = ws.world.political_party_get_ideology(ws.world.nation_get_ruling_party(owner));
 	auto population_size = ws.world.pop_get_size(to_pop(primary_slot));
 	auto ruling_support = ve::apply([&](dcon::pop_id p, dcon::ideology_id i) {
-		return ws.world.pop_get_demographics(p, pop_demographics::to_key(ws, i));
+		return pop_demographics::get_demo(ws, p, pop_demographics::to_key(ws, i));
 	}, to_pop(primary_slot), ruling_ideology);
 	return compare_values(tval[0], ve::select(population_size > 0.0f, ruling_support / population_size, 0.0f), read_float_from_payload(tval + 1));
 }
@@ -4542,7 +4542,7 @@ TRIGGER_FUNCTION(tf_variable_ideology_name_province) {
 TRIGGER_FUNCTION(tf_variable_ideology_name_pop) {
 	auto id = payload(tval[1]).ideo_id;
 	auto total_pop = ws.world.pop_get_size(to_pop(primary_slot));
-	auto support_pop = ws.world.pop_get_demographics(to_pop(primary_slot), pop_demographics::to_key(ws, id));
+	auto support_pop = pop_demographics::get_demo(ws, to_pop(primary_slot), pop_demographics::to_key(ws, id));
 	return compare_values(tval[0], ve::select(total_pop > 0.0f, support_pop / total_pop, 0.0f), read_float_from_payload(tval + 2));
 }
 TRIGGER_FUNCTION(tf_variable_issue_name_nation) {
@@ -4566,7 +4566,7 @@ TRIGGER_FUNCTION(tf_variable_issue_name_province) {
 TRIGGER_FUNCTION(tf_variable_issue_name_pop) {
 	auto id = payload(tval[1]).opt_id;
 	auto total_pop = ws.world.pop_get_size(to_pop(primary_slot));
-	auto support_pop = ws.world.pop_get_demographics(to_pop(primary_slot), pop_demographics::to_key(ws, id));
+	auto support_pop = pop_demographics::get_demo(ws, to_pop(primary_slot), pop_demographics::to_key(ws, id));
 	return compare_values(tval[0], ve::select(total_pop > 0.0f, support_pop / total_pop, 0.0f), read_float_from_payload(tval + 2));
 }
 TRIGGER_FUNCTION(tf_variable_issue_group_name_nation) {
@@ -5386,13 +5386,247 @@ return_type CALLTYPE test_trigger_generic(uint16_t const* tval, sys::state& ws,
 #undef CALLTYPE
 #undef TRIGGER_FUNCTION
 
+namespace {
+
+std::atomic<uint32_t> memo_state_count = 0;
+
+// The triggers whose results may be remembered for the rest of a tick: those reading only definitions, or values that change
+// through effects (which clear the tables) but that no pass of the daily update writes. Anything not listed here, for example
+// money, needs, demographics, ranks and scores, the date, or the nation adjacencies rebuilt with the connected regions, is
+// always evaluated.
+bool is_stable_within_tick(uint16_t code) {
+	auto c = uint16_t(code & trigger::code_mask);
+	if(c >= trigger::first_scope_code) { // scopes only follow relationships, except those picking great powers by rank or neighbours by adjacency
+		return c < trigger::first_invalid_code && c != trigger::x_greater_power_scope && c != trigger::x_neighbor_country_scope_nation
+			&& c != trigger::x_neighbor_country_scope_pop;
+	}
+	switch(c) {
+		case trigger::always:
+		case trigger::tag_tag:
+		case trigger::tag_this_nation:
+		case trigger::tag_this_province:
+		case trigger::tag_from_nation:
+		case trigger::tag_from_province:
+		case trigger::tag_pop:
+		case trigger::primary_culture:
+		case trigger::accepted_culture:
+		case trigger::culture_pop:
+		case trigger::culture_state:
+		case trigger::culture_province:
+		case trigger::culture_nation:
+		case trigger::culture_this_nation:
+		case trigger::culture_this_state:
+		case trigger::culture_this_pop:
+		case trigger::culture_this_province:
+		case trigger::culture_from_nation:
+		case trigger::culture_group_nation:
+		case trigger::culture_group_pop:
+		case trigger::religion:
+		case trigger::religion_this_nation:
+		case trigger::religion_this_state:
+		case trigger::religion_this_province:
+		case trigger::religion_this_pop:
+		case trigger::religion_from_nation:
+		case trigger::religion_nation:
+		case trigger::is_primary_culture_pop:
+		case trigger::is_primary_culture_province:
+		case trigger::is_primary_culture_state:
+		case trigger::is_accepted_culture_pop:
+		case trigger::is_accepted_culture_province:
+		case trigger::is_accepted_culture_state:
+		case trigger::is_state_religion_pop:
+		case trigger::is_state_religion_province:
+		case trigger::is_state_religion_state:
+		case trigger::government_nation:
+		case trigger::government_pop:
+		case trigger::capital:
+		case trigger::tech_school:
+		case trigger::technology:
+		case trigger::invention:
+		case trigger::continent_nation:
+		case trigger::continent_state:
+		case trigger::continent_province:
+		case trigger::continent_pop:
+		case trigger::region:
+		case trigger::is_coastal:
+		case trigger::port:
+		case trigger::terrain_province:
+		case trigger::terrain_pop:
+		case trigger::trade_goods:
+		case trigger::province_id:
+		case trigger::state_id_province:
+		case trigger::state_id_state:
+		case trigger::life_rating_province:
+		case trigger::life_rating_state:
+		case trigger::owns:
+		case trigger::controls:
+		case trigger::owned_by_tag:
+		case trigger::owned_by_from_nation:
+		case trigger::owned_by_this_nation:
+		case trigger::owned_by_this_province:
+		case trigger::owned_by_this_state:
+		case trigger::owned_by_this_pop:
+		case trigger::controlled_by_tag:
+		case trigger::controlled_by_from:
+		case trigger::controlled_by_this_nation:
+		case trigger::controlled_by_this_province:
+		case trigger::controlled_by_this_state:
+		case trigger::controlled_by_this_pop:
+		case trigger::controlled_by_owner:
+		case trigger::is_core_integer:
+		case trigger::is_core_this_nation:
+		case trigger::is_core_this_state:
+		case trigger::is_core_this_province:
+		case trigger::is_core_this_pop:
+		case trigger::is_core_from_nation:
+		case trigger::is_core_tag:
+		case trigger::is_capital:
+		case trigger::is_state_capital:
+		case trigger::is_colonial_state:
+		case trigger::is_colonial_province:
+		case trigger::has_building_fort:
+		case trigger::has_building_railroad:
+		case trigger::has_building_naval_base:
+		case trigger::has_country_flag:
+		case trigger::has_global_flag:
+		case trigger::has_country_modifier:
+		case trigger::has_province_modifier:
+		case trigger::civilized_nation:
+		case trigger::civilized_pop:
+		case trigger::civilized_province:
+		case trigger::is_vassal:
+		case trigger::is_independant:
+		case trigger::vassal_of_tag:
+		case trigger::vassal_of_from:
+		case trigger::vassal_of_this_nation:
+		case trigger::alliance_with_tag:
+		case trigger::alliance_with_from:
+		case trigger::alliance_with_this_nation:
+		case trigger::war_with_tag:
+		case trigger::war_with_from:
+		case trigger::war_with_this_nation:
+		case trigger::in_sphere_tag:
+		case trigger::in_sphere_from:
+		case trigger::in_sphere_this_nation:
+		case trigger::is_ideology_enabled:
+		case trigger::ruling_party:
+		case trigger::ruling_party_ideology_nation:
+		case trigger::ruling_party_ideology_pop:
+		case trigger::ai:
+		case trigger::is_canal_enabled:
+		case trigger::great_wars_enabled:
+		case trigger::world_wars_enabled:
+		case trigger::nationalvalue_nation:
+		case trigger::nationalvalue_pop:
+		case trigger::nationalvalue_province:
+		case trigger::has_culture_core:
+		case trigger::check_variable:
+			return true;
+		default:
+			return false;
+	}
+}
+
+struct memo_entry {
+	uint32_t generation = 0; // the entry is empty unless this is the current generation
+	uint16_t key = 0;
+	bool result = false;
+	int32_t primary = 0;
+	int32_t this_slot = 0;
+	int32_t from_slot = 0;
+};
+
+struct memo_table {
+	static constexpr uint32_t size = 4096; // must be a power of two
+	static constexpr uint32_t max_probes = 8;
+
+	uint32_t owner = 0; // the id of the memo_state the table is filled for
+	uint32_t generation = 0; // the generation memoizable was filled in
+	uint32_t counter_slot = 0; // this thread's slot in the counts of the owner
+	ankerl::unordered_dense::map<uint16_t, bool> memoizable;
+	std::vector<memo_entry> entries = std::vector<memo_entry>(size);
+};
+
+uint32_t memo_hash(uint16_t key, int32_t primary, int32_t this_slot, int32_t from_slot) {
+	uint64_t h = uint64_t(key) * 0x9E3779B97F4A7C15ull;
+	h = (h ^ uint32_t(primary)) * 0xBF58476D1CE4E5B9ull;
+	h = (h ^ uint32_t(this_slot)) * 0x94D049BB133111EBull;
+	h = (h ^ uint32_t(from_slot)) * 0x9E3779B97F4A7C15ull;
+	return uint32_t(h >> 32);
+}
+
+}
+
+memo_state::memo_state() : id(memo_state_count.fetch_add(1, std::memory_order::relaxed) + 1) { }
+
+bool is_memoizable(sys::state const& state, dcon::trigger_key key) {
+	bool result = true;
+	recurse_over_triggers(const_cast<uint16_t*>(state.trigger_data.data() + key.index()), [&result](uint16_t* tval) {
+		if(!is_stable_within_tick(tval[0]))
+			result = false;
+	});
+	return result;
+}
+
+bool evaluate_trigger(sys::state& state, dcon::trigger_key key, int32_t primary, int32_t this_slot, int32_t from_slot) {
+	return test_trigger_generic<bool>(state.trigger_data.data() + key.index(), state, primary, this_slot, from_slot);
+}
+
+bool evaluate_trigger_memoized(sys::state& state, dcon::trigger_key key, int32_t primary, int32_t this_slot, int32_t from_slot) {
+	static thread_local memo_table table;
+
+	auto& shared = state.trigger_memo;
+	if(!shared.active.load(std::memory_order::acquire))
+		return evaluate_trigger(state, key, primary, this_slot, from_slot);
+	if(table.owner != shared.id) {
+		table.owner = shared.id;
+		table.counter_slot = shared.take_slot();
+		table.generation = 0;
+		std::fill(table.entries.begin(), table.entries.end(), memo_entry{});
+	}
+	// entries from older generations are treated as empty; the analysis is redone as well, in case the triggers were replaced
+	auto generation = shared.generation.load(std::memory_order::acquire);
+	if(table.generation != generation) {
+		table.generation = generation;
+		table.memoizable.clear();
+	}
+
+	auto k = uint16_t(key.index());
+	auto analysis = table.memoizable.find(k);
+	if(analysis == table.memoizable.end())
+		analysis = table.memoizable.insert_or_assign(k, is_memoizable(state, key)).first;
+	if(!analysis->second)
+		return evaluate_trigger(state, key, primary, this_slot, from_slot);
+
+	auto& counts = shared.slots[table.counter_slot];
+	auto home = memo_hash(k, primary, this_slot, from_slot) & (memo_table::size - 1);
+	auto slot = home;
+	for(uint32_t i = 0; i < memo_table::max_probes; ++i) {
+		auto& e = table.entries[(home + i) & (memo_table::size - 1)];
+		if(e.generation != generation) {
+			slot = (home + i) & (memo_table::size - 1);
+			break;
+		}
+		if(e.key == k && e.primary == primary && e.this_slot == this_slot && e.from_slot == from_slot) {
+			counts.hits.fetch_add(1, std::memory_order::relaxed);
+			return e.result;
+		}
+	}
+
+	// not found: take the first empty slot of the probe sequence, or evict the entry in the home slot
+	counts.misses.fetch_add(1, std::memory_order::relaxed);
+	auto result = evaluate_trigger(state, key, primary, this_slot, from_slot);
+	table.entries[slot] = memo_entry{ generation, k, result, primary, this_slot, from_slot };
+	return result;
+}
+
 float evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, int32_t primary, int32_t this_slot, int32_t from_slot) {
 	auto base = state.value_modifiers[modifier];
 	float product = base.base_factor;
 	for(uint32_t i = 0; i < base.segments_count && product != 0; ++i) {
 		auto seg = state.value_modifier_segments[base.first_segment_offset + i];
 		if(seg.condition) {
-			if(test_trigger_generic<bool>(state.trigger_data.data() + seg.condition.index(), state, primary, this_slot, from_slot)) {
+			if(evaluate_trigger_memoized(state, seg.condition, primary, this_slot, from_slot)) {
 				product *= seg.factor;
 			}
 		}
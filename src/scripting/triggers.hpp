@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include "script_constants.hpp"
 #include "dcon_generated.hpp"
 #include "container_types.hpp"
@@ -82,6 +84,55 @@ inline ve::partial_contiguous_tags<int32_t> to_generic(ve::partial_contiguous_ta
 	return ve::partial_contiguous_tags<int32_t>(v.value, v.subcount);
 }
 
+// Trigger results can be remembered for the rest of a tick. Each thread keeps its own open addressed table of results keyed on
+// (trigger, primary slot, this slot, from slot); clear() moves every table on to a new generation at once and must be called
+// whenever something a remembered trigger reads may have changed, and whenever the trigger data is replaced. The tables are
+// only used between begin_tick() and end_tick(); outside of a tick every trigger is evaluated. Only triggers that read nothing
+// the daily update rewrites partway through a tick are remembered. Each thread counts its hits and misses in a slot of its
+// own; end_tick() adds the slots up into hits and misses, so after it they are exact for everything done during the tick.
+class memo_state {
+public:
+	static constexpr uint32_t counter_slots = 64; // threads beyond this share slots, which stays exact but contends
+
+	struct alignas(64) counter_slot {
+		std::atomic<uint64_t> hits = 0;
+		std::atomic<uint64_t> misses = 0;
+	};
+
+	uint32_t const id; // distinguishes the tables of different states living at the same address over time
+	std::atomic<uint32_t> generation = 1;
+	std::atomic<bool> active = false;
+	std::atomic<uint64_t> hits = 0; // the totals, as of the last end_tick()
+	std::atomic<uint64_t> misses = 0;
+	std::atomic<uint32_t> slots_taken = 0;
+	std::array<counter_slot, counter_slots> slots;
+
+	memo_state();
+	uint32_t take_slot() {
+		return slots_taken.fetch_add(1, std::memory_order::relaxed) % counter_slots;
+	}
+	void clear() {
+		generation.fetch_add(1, std::memory_order::acq_rel);
+	}
+	void begin_tick() {
+		clear();
+		active.store(true, std::memory_order::release);
+	}
+	void end_tick() {
+		active.store(false, std::memory_order::release);
+		for(auto& s : slots) {
+			hits.fetch_add(s.hits.exchange(0, std::memory_order::relaxed), std::memory_order::relaxed);
+			misses.fetch_add(s.misses.exchange(0, std::memory_order::relaxed), std::memory_order::relaxed);
+		}
+	}
+};
+
+// true if neither the trigger nor any trigger nested in it reads a value that may change between two evaluations in the same tick
+bool is_memoizable(sys::state const& state, dcon::trigger_key key);
+bool evaluate_trigger(sys::state& state, dcon::trigger_key key, int32_t primary, int32_t this_slot, int32_t from_slot);
+// as evaluate_trigger, but answered from the calling thread's table when the trigger is memoizable and a tick is running
+bool evaluate_trigger_memoized(sys::state& state, dcon::trigger_key key, int32_t primary, int32_t this_slot, int32_t from_slot);
+
 float evaluate_multiplicative_modifier(sys::state& state, dcon::value_modifier_key modifier, int32_t primary, int32_t this_slot, int32_t from_slot);
 	
 }
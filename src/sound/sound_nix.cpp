@@ -6,13 +6,18 @@
 
 namespace sound {
 
+// effects and interface sounds are decoded into memory the first time they are needed, and every later play is a copy
+// of that decoded sound that shares its buffer. Music is never decoded up front; it is streamed by the resource manager's
+// job thread, so that neither a click nor a change of track has to wait for a decoder.
 class audio_instance {
 public:
 	native_string filename;
+	std::unique_ptr<ma_sound> source; // the decoded data; never played directly, only copied into voices
 
 	audio_instance() = default;
 
 	audio_instance& operator=(audio_instance const& o) {
+		release();
 		filename = o.filename;
 		return *this;
 	}
@@ -21,18 +26,95 @@ public:
 		filename = simple_fs::get_full_name(file);
 	}
 
+	audio_instance(audio_instance&& o) noexcept = default;
+
 	~audio_instance() {
+		release();
+	}
+
+	bool decode(ma_engine& engine) {
+		if(source)
+			return true;
+		auto s = std::make_unique<ma_sound>();
+		if(ma_sound_init_from_file(&engine, filename.c_str(), MA_SOUND_FLAG_DECODE | MA_SOUND_FLAG_NO_SPATIALIZATION, NULL, NULL, s.get()) != MA_SUCCESS)
+			return false;
+		source = std::move(s);
+		return true;
+	}
 
+	void release() {
+		if(source) {
+			ma_sound_uninit(source.get());
+			source.reset();
+		}
 	}
 };
 
+// a handful of voices that decoded sounds are copied into; starting a sound takes a voice that has finished playing,
+// or the one that was started longest ago
+class voice_pool {
+public:
+	static constexpr uint32_t voice_count = 4;
+
+	~voice_pool() {
+		stop_all();
+	}
+
+	void play(ma_engine& engine, audio_instance& s, float volume) {
+		if(!s.decode(engine))
+			return;
+
+		uint32_t chosen = next;
+		for(uint32_t i = 0; i < voice_count; ++i) {
+			auto v = (next + i) % voice_count;
+			if(!in_use[v] || !ma_sound_is_playing(&voices[v])) {
+				chosen = v;
+				break;
+			}
+		}
+		next = (chosen + 1) % voice_count;
+
+		if(in_use[chosen]) {
+			ma_sound_uninit(&voices[chosen]);
+			in_use[chosen] = false;
+		}
+		if(ma_sound_init_copy(&engine, s.source.get(), MA_SOUND_FLAG_NO_SPATIALIZATION, NULL, &voices[chosen]) == MA_SUCCESS) {
+			in_use[chosen] = true;
+			ma_sound_set_volume(&voices[chosen], volume);
+			ma_sound_start(&voices[chosen]);
+		}
+	}
+
+	void set_volume(float volume) {
+		for(uint32_t i = 0; i < voice_count; ++i) {
+			if(in_use[i])
+				ma_sound_set_volume(&voices[i], volume);
+		}
+	}
+
+	void stop_all() {
+		for(uint32_t i = 0; i < voice_count; ++i) {
+			if(in_use[i]) {
+				ma_sound_uninit(&voices[i]);
+				in_use[i] = false;
+			}
+		}
+	}
+
+private:
+	ma_sound voices[voice_count];
+	bool in_use[voice_count] = { false };
+	uint32_t next = 0;
+};
+
 class sound_impl {
 public:
-	std::optional<ma_sound> effect_sound;
-	std::optional<ma_sound> interface_sound;
+	ma_engine engine;
+
+	voice_pool effect_voices;
+	voice_pool interface_voices;
 	std::optional<ma_sound> music;
 
-	ma_engine engine;
 	audio_instance click_sound;
 	std::vector<audio_instance> music_list;
 	int32_t last_music = -1;
@@ -46,41 +128,41 @@ public:
 	}
 
 	~sound_impl() {
+		stop_current_music();
+		effect_voices.stop_all();
+		interface_voices.stop_all();
+		click_sound.release();
 		ma_engine_uninit(&engine);
 	}
 
-	void set_volume(std::optional<ma_sound>& sound, float volume) {
-		if(sound.has_value()) {
-			ma_sound_set_volume(&*sound, volume);
-		}
-	}
-
-	void override_sound(std::optional<ma_sound>& sound, audio_instance& s, float volume) {
-		if(sound.has_value()) {
-			ma_sound_uninit(&*sound);
-		}
-
-		sound.reset();
-		sound.emplace();
-		ma_result result = ma_sound_init_from_file(&engine, s.filename.c_str(), 0, NULL, NULL, &*sound);
-		if(result == MA_SUCCESS) {
-			set_volume(sound, volume);
-			ma_sound_start(&*sound);
+	void stop_current_music() {
+		if(music.has_value()) {
+			ma_sound_uninit(&*music);
+			music.reset();
 		}
 	}
 
 	void play_music(int32_t track, float volume) {
 		current_music = track;
+		last_music = track;
 
-		audio_instance audio{};
-		audio.filename = music_list[track].filename.c_str();
-		override_sound(music, audio, volume);
+		stop_current_music();
+		music.emplace();
+		// the stream is opened and decoded in the background; the sound simply starts once the first pages are ready
+		ma_result result = ma_sound_init_from_file(&engine, music_list[track].filename.c_str(),
+			MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_ASYNC | MA_SOUND_FLAG_NO_SPATIALIZATION, NULL, NULL, &*music);
+		if(result == MA_SUCCESS) {
+			ma_sound_set_volume(&*music, volume);
+			ma_sound_start(&*music);
+		} else {
+			music.reset();
+		}
 	}
 
 	void play_new_track(sys::state& s, float v) {
 		if(music_list.size() > 0) {
 			int32_t result = int32_t(rand() % music_list.size()); // well aware that using rand is terrible, thanks
-			while(result == last_music)
+			while(result == last_music && music_list.size() > 1)
 				result = int32_t(rand() % music_list.size());
 			play_music(result, v);
 		}
@@ -88,7 +170,7 @@ public:
 
 	bool music_finished() {
 		if(music.has_value())
-			return music->atEnd;
+			return ma_sound_at_end(&*music);
 		return true;
 	}
 };
@@ -114,22 +196,25 @@ void initialize_sound_system(sys::state& state) {
 		std::abort();
 	}
 	state.sound_ptr->click_sound = audio_instance(*click_peek);
+	state.sound_ptr->click_sound.decode(state.sound_ptr->engine);
 }
 void change_effect_volume(sys::state& state, float v) {
-	state.sound_ptr->set_volume(state.sound_ptr->effect_sound, v);
+	state.sound_ptr->effect_voices.set_volume(v);
 }
 void change_interface_volume(sys::state& state, float v) {
-	state.sound_ptr->set_volume(state.sound_ptr->interface_sound, v);
+	state.sound_ptr->interface_voices.set_volume(v);
 }
 void change_music_volume(sys::state& state, float v) {
-	state.sound_ptr->set_volume(state.sound_ptr->music, v);
+	if(state.sound_ptr->music.has_value()) {
+		ma_sound_set_volume(&*state.sound_ptr->music, v);
+	}
 }
 
 void play_effect(sys::state& state, audio_instance& s, float volume) {
-	state.sound_ptr->override_sound(state.sound_ptr->effect_sound, s, volume);
+	state.sound_ptr->effect_voices.play(state.sound_ptr->engine, s, volume);
 }
 void play_interface_sound(sys::state& state, audio_instance& s, float volume) {
-	state.sound_ptr->override_sound(state.sound_ptr->interface_sound, s, volume);
+	state.sound_ptr->interface_voices.play(state.sound_ptr->engine, s, volume);
 }
 
 void stop_music(sys::state& state) {
@@ -1,7 +1,10 @@
 #include <cmath>
 
+#include "dcon_generated.hpp"
 #include "fonts.hpp"
 #include "parsers.hpp"
+#include "simple_fs.hpp"
+#include "xxhash.h"
 
 namespace text {
 
@@ -125,7 +128,7 @@ constexpr int magnification_factor = 4;
 constexpr int dr_size = 64 * magnification_factor;
 constexpr float rt_2 = 1.41421356237309504f;
 
-void init_in_map(bool in_map[dr_size * dr_size], uint8_t* bmp_data, int32_t btmap_x_off, int32_t btmap_y_off, uint32_t width, uint32_t height, uint32_t pitch) {
+void init_in_map(bool in_map[dr_size * dr_size], uint8_t const* bmp_data, int32_t btmap_x_off, int32_t btmap_y_off, uint32_t width, uint32_t height, uint32_t pitch) {
 	for(int32_t j = 0; j < dr_size; ++j) {
 		for(int32_t i = 0; i < dr_size; ++i) {
 			const auto boff = transform_offset_b(i, j, btmap_x_off, btmap_y_off, width, height, pitch);
@@ -233,6 +236,7 @@ void dead_reckoning(float distance_map[dr_size * dr_size], const bool in_map[dr_
 void font_manager::load_font(font& fnt, char const* file_data, uint32_t file_size) {
 	fnt.file_data = std::unique_ptr<FT_Byte[]>(new FT_Byte[file_size]);
 	memcpy(fnt.file_data.get(), file_data, file_size);
+	fnt.file_hash = ZSTD_XXH64(file_data, file_size, 0);
 	FT_New_Memory_Face(ft_library, fnt.file_data.get(), file_size, 0, &fnt.font_face);
 	FT_Select_Charmap(fnt.font_face, FT_ENCODING_UNICODE);
 	FT_Set_Pixel_Sizes(fnt.font_face, 0, 64 * magnification_factor);
@@ -287,73 +291,105 @@ float font::top_adjustment(int32_t size) const {
 }
 
 
-void font::make_glyph(char ch_in) {
-	if(glyph_loaded[uint8_t(ch_in)])
-		return;
-	glyph_loaded[uint8_t(ch_in)] = true;
-
-	auto codepoint = win1250toUTF16(ch_in);
-	if(codepoint == ' ')
-		return;
+struct rasterized_glyph {
+	std::vector<uint8_t> bitmap;
+	int32_t x_offset = 0;
+	int32_t y_offset = 0;
+	uint32_t width = 0;
+	uint32_t rows = 0;
+	bool present = false;
+};
 
-	const auto index_in_this_font = FT_Get_Char_Index(font_face, codepoint);
-	if(index_in_this_font) {
-		FT_Load_Glyph(font_face, index_in_this_font, FT_LOAD_TARGET_NORMAL | FT_LOAD_RENDER);
+// a FreeType face may only be used by one thread at a time, so this part is done serially
+bool rasterize_glyph(FT_Face face, char ch_in, rasterized_glyph& out, glyph_sub_offset& position) {
+	const auto index_in_this_font = FT_Get_Char_Index(face, win1250toUTF16(ch_in));
+	if(!index_in_this_font)
+		return false;
 
-		FT_Glyph g_result;
-		FT_Get_Glyph(font_face->glyph, &g_result);
+	FT_Load_Glyph(face, index_in_this_font, FT_LOAD_TARGET_NORMAL | FT_LOAD_RENDER);
 
-		auto texture_number = uint8_t(ch_in) >> 6;
+	FT_Glyph g_result;
+	FT_Get_Glyph(face->glyph, &g_result);
 
-		if(textures[texture_number] == 0) {
-			glGenTextures(1, &textures[texture_number]);
-			glBindTexture(GL_TEXTURE_2D, textures[texture_number]);
-			glTexStorage2D(GL_TEXTURE_2D, 1, GL_R8, 64 * 8, 64 * 8);
+	FT_Bitmap& bitmap = ((FT_BitmapGlyphRec*)g_result)->bitmap;
 
-			//glClearTexImage(textures[texture_number], 0, GL_RED, GL_FLOAT, nullptr);
+	const float hb_x = static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
+	const float hb_y = static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
 
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		} else {
-			glBindTexture(GL_TEXTURE_2D, textures[texture_number]);
-		}
+	out.width = bitmap.width;
+	out.rows = bitmap.rows;
+	out.x_offset = 32 * magnification_factor - int32_t(bitmap.width / 2);
+	out.y_offset = 32 * magnification_factor - int32_t(bitmap.rows / 2);
 
-		FT_Bitmap& bitmap = ((FT_BitmapGlyphRec*)g_result)->bitmap;
+	position.x = (hb_x - static_cast<float>(out.x_offset)) * 1.0f / static_cast<float>(magnification_factor);
+	position.y = (-hb_y - static_cast<float>(out.y_offset)) * 1.0f / static_cast<float>(magnification_factor);
 
-		const float hb_x = static_cast<float>(font_face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
-		const float hb_y = static_cast<float>(font_face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
+	out.bitmap.resize(size_t(bitmap.width) * bitmap.rows);
+	for(uint32_t r = 0; r < bitmap.rows; ++r) {
+		memcpy(out.bitmap.data() + size_t(r) * bitmap.width, bitmap.buffer + int32_t(r) * bitmap.pitch, bitmap.width);
+	}
+	out.present = true;
 
-		auto sub_index = (uint8_t(ch_in) & 63);
+	FT_Done_Glyph(g_result);
+	return true;
+}
 
-		uint8_t pixel_buffer[64 * 64];
+// writes the 64x64 distance field of the glyph to out; touches no shared state, so any number of these may run at once
+void render_distance_field(rasterized_glyph const& g, uint8_t* out, uint32_t out_stride) {
+	// too large for the stack of a worker thread
+	std::unique_ptr<bool[]> in_map(new bool[dr_size * dr_size]);
+	std::unique_ptr<float[]> distance_map(new float[dr_size * dr_size]);
+
+	init_in_map(in_map.get(), g.bitmap.data(), g.x_offset, g.y_offset, g.width, g.rows, g.width);
+	dead_reckoning(distance_map.get(), in_map.get());
+
+	for(int y = 0; y < 64; ++y) {
+		for(int x = 0; x < 64; ++x) {
+			const float distance_value = distance_map[
+				(x * magnification_factor + magnification_factor / 2) +
+					(y * magnification_factor + magnification_factor / 2) * dr_size]
+				/ static_cast<float>(magnification_factor * 64);
+				const int int_value = static_cast<int>(distance_value * -255.0f + 128.0f);
+				const uint8_t small_value = static_cast<uint8_t>(std::min(255, std::max(0, int_value)));
+
+				out[x + y * out_stride] = small_value;
+		}
+	}
+}
 
-		const int btmap_x_off = 32 * magnification_factor - bitmap.width / 2;
-		const int btmap_y_off = 32 * magnification_factor - bitmap.rows / 2;
+void bind_glyph_page(uint32_t& texture) {
+	if(texture == 0) {
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexStorage2D(GL_TEXTURE_2D, 1, GL_R8, glyph_page_width, glyph_page_width);
 
-		glyph_positions[uint8_t(ch_in)].x = (hb_x - static_cast<float>(btmap_x_off)) * 1.0f / static_cast<float>(magnification_factor);
-		glyph_positions[uint8_t(ch_in)].y = (-hb_y - static_cast<float>(btmap_y_off)) * 1.0f / static_cast<float>(magnification_factor);
+		//glClearTexImage(texture, 0, GL_RED, GL_FLOAT, nullptr);
 
-		bool in_map[dr_size * dr_size] = { false };
-		float distance_map[dr_size * dr_size];
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	} else {
+		glBindTexture(GL_TEXTURE_2D, texture);
+	}
+}
 
-		init_in_map(in_map, bitmap.buffer, btmap_x_off, btmap_y_off, bitmap.width, bitmap.rows, (uint32_t)bitmap.pitch);
-		dead_reckoning(distance_map, in_map);
+void font::make_glyph(char ch_in) {
+	if(glyph_loaded[uint8_t(ch_in)])
+		return;
+	glyph_loaded[uint8_t(ch_in)] = true;
 
+	auto codepoint = win1250toUTF16(ch_in);
+	if(codepoint == ' ')
+		return;
 
-		for(int y = 0; y < 64; ++y) {
-			for(int x = 0; x < 64; ++x) {
+	rasterized_glyph g;
+	if(rasterize_glyph(font_face, ch_in, g, glyph_positions[uint8_t(ch_in)])) {
+		auto texture_number = uint8_t(ch_in) >> 6;
+		bind_glyph_page(textures[texture_number]);
 
-				const size_t index = static_cast<size_t>(x + y * 64);
-				const float distance_value = distance_map[
-					(x * magnification_factor + magnification_factor / 2) +
-						(y * magnification_factor + magnification_factor / 2) * dr_size]
-					/ static_cast<float>(magnification_factor * 64);
-					const int int_value = static_cast<int>(distance_value * -255.0f + 128.0f);
-					const uint8_t small_value = static_cast<uint8_t>(std::min(255, std::max(0, int_value)));
+		auto sub_index = (uint8_t(ch_in) & 63);
 
-					pixel_buffer[index] = small_value;
-			}
-		}
+		uint8_t pixel_buffer[64 * 64];
+		render_distance_field(g, pixel_buffer, 64);
 
 		glTexSubImage2D(GL_TEXTURE_2D, 0,
 			(sub_index & 7) * 64,
@@ -361,8 +397,32 @@ void font::make_glyph(char ch_in) {
 			64,
 			64,
 			GL_RED, GL_UNSIGNED_BYTE, pixel_buffer);
+	}
+}
 
-		FT_Done_Glyph(g_result);
+void font::make_all_glyphs(uint8_t* pages) {
+	std::vector<rasterized_glyph> rasterized(256);
+	for(uint32_t i = 0; i < 256; ++i) {
+		glyph_loaded[i] = true;
+		if(win1250toUTF16(char(i)) != ' ')
+			rasterize_glyph(font_face, char(i), rasterized[i], glyph_positions[i]);
+	}
+
+	concurrency::parallel_for(uint32_t(0), uint32_t(256), [&](uint32_t i) {
+		if(!rasterized[i].present)
+			return;
+		auto sub_index = i & 63;
+		auto destination = pages + (i >> 6) * glyph_page_bytes
+			+ ((sub_index >> 3) & 7) * 64 * glyph_page_width
+			+ (sub_index & 7) * 64;
+		render_distance_field(rasterized[i], destination, glyph_page_width);
+	});
+}
+
+void font::upload_glyph_pages(uint8_t const* pages) {
+	for(uint32_t i = 0; i < glyph_page_count; ++i) {
+		bind_glyph_page(textures[i]);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, glyph_page_width, glyph_page_width, GL_RED, GL_UNSIGNED_BYTE, pages + i * glyph_page_bytes);
 	}
 }
 
@@ -377,6 +437,28 @@ float font::text_extent(const char* codepoints, uint32_t count, int32_t size) co
 	return total;
 }
 
+text_layout const& font::get_layout(const char* codepoints, uint32_t count, int32_t size) const {
+	std::string_view text(codepoints, count);
+	auto key = ankerl::unordered_dense::detail::wyhash::hash(text.data(), text.size()) ^ ankerl::unordered_dense::hash<int32_t>()(size);
+
+	if(auto it = layout_cache.find(key); it != layout_cache.end() && it->second.size == size && it->second.text == text)
+		return it->second.layout;
+
+	if(layout_cache.size() >= max_cached_layouts)
+		layout_cache.clear();
+
+	auto& entry = layout_cache[key]; // on a hash collision this simply replaces the other string's layout
+	entry.text = text;
+	entry.size = size;
+	entry.layout.glyph_x.resize(count);
+	float x = 0.0f;
+	for(uint32_t i = 0; i < count; ++i) {
+		entry.layout.glyph_x[i] = x;
+		x += glyph_advances[uint8_t(codepoints[i])] * size / 64.0f + ((i != count - 1) ? kerning(codepoints[i], codepoints[i + 1]) * size / 64.0f : 0.0f);
+	}
+	entry.layout.extent = x;
+	return entry.layout;
+}
 
 void load_standard_fonts(sys::state& state) {
 	auto root = get_root(state.common_fs);
@@ -392,10 +474,71 @@ void load_standard_fonts(sys::state& state) {
 	}
 }
 
+// cache file: glyph_cache_version, the hash of the font file, glyph_positions, then the raw pages
+constexpr size_t glyph_cache_size = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(font::glyph_positions) + glyph_page_count * glyph_page_bytes;
+
+native_string glyph_cache_file_name(font const& fnt) {
+	native_string result = NATIVE("glyphs_");
+	for(int32_t i = 60; i >= 0; i -= 4) {
+		result += native_char("0123456789abcdef"[(fnt.file_hash >> i) & 0xF]);
+	}
+	result += NATIVE(".bin");
+	return result;
+}
+
+bool read_glyph_cache(font& fnt, simple_fs::directory const& dir, uint8_t* pages) {
+	auto cache_file = simple_fs::open_file(dir, glyph_cache_file_name(fnt));
+	if(!cache_file)
+		return false;
+	auto contents = simple_fs::view_contents(*cache_file);
+	if(contents.file_size != glyph_cache_size)
+		return false;
+
+	auto ptr = contents.data;
+	uint32_t version = 0;
+	uint64_t hash = 0;
+	memcpy(&version, ptr, sizeof(uint32_t));
+	ptr += sizeof(uint32_t);
+	memcpy(&hash, ptr, sizeof(uint64_t));
+	ptr += sizeof(uint64_t);
+	if(version != glyph_cache_version || hash != fnt.file_hash)
+		return false;
+
+	memcpy(fnt.glyph_positions, ptr, sizeof(fnt.glyph_positions));
+	ptr += sizeof(fnt.glyph_positions);
+	memcpy(pages, ptr, glyph_page_count * glyph_page_bytes);
+	return true;
+}
+
+void write_glyph_cache(font const& fnt, simple_fs::directory const& dir, uint8_t const* pages) {
+	std::unique_ptr<char[]> buffer(new char[glyph_cache_size]);
+	auto ptr = buffer.get();
+	memcpy(ptr, &glyph_cache_version, sizeof(uint32_t));
+	ptr += sizeof(uint32_t);
+	memcpy(ptr, &fnt.file_hash, sizeof(uint64_t));
+	ptr += sizeof(uint64_t);
+	memcpy(ptr, fnt.glyph_positions, sizeof(fnt.glyph_positions));
+	ptr += sizeof(fnt.glyph_positions);
+	memcpy(ptr, pages, glyph_page_count * glyph_page_bytes);
+	simple_fs::write_file(dir, glyph_cache_file_name(fnt), buffer.get(), uint32_t(glyph_cache_size));
+}
+
 void font_manager::load_all_glyphs() {
+	auto cache_dir = simple_fs::get_or_create_cache_directory();
+	std::vector<uint8_t> pages(glyph_page_count * glyph_page_bytes);
+
 	for(uint32_t j = 0; j < 2; ++j) {
-		for(uint32_t i = 0; i < 256; ++i)
-			fonts[j].make_glyph(char(i));
+		if(!fonts[j].loaded)
+			continue;
+		if(!read_glyph_cache(fonts[j], cache_dir, pages.data())) {
+			std::fill(pages.begin(), pages.end(), uint8_t(0));
+			fonts[j].make_all_glyphs(pages.data());
+			write_glyph_cache(fonts[j], cache_dir, pages.data());
+		}
+		for(auto& l : fonts[j].glyph_loaded)
+			l = true;
+		// only the upload has to happen on the thread that owns the GL context
+		fonts[j].upload_glyph_pages(pages.data());
 	}
 }
 
@@ -17,6 +17,27 @@ struct glyph_sub_offset {
 	float y = 0.0f;
 };
 
+// where each glyph of a string starts, relative to the start of the string, and the width of the whole string
+struct text_layout {
+	std::vector<float> glyph_x;
+	float extent = 0.0f;
+};
+
+struct cached_layout {
+	std::string text;
+	int32_t size = 0;
+	text_layout layout;
+};
+
+inline constexpr size_t max_cached_layouts = 8192;
+
+// glyph distance fields are kept in four 512x512 single channel pages of 64 glyphs each
+inline constexpr uint32_t glyph_page_count = 4;
+inline constexpr uint32_t glyph_page_width = 64 * 8;
+inline constexpr size_t glyph_page_bytes = size_t(glyph_page_width) * glyph_page_width;
+// bump whenever the distance field generation or the layout of the cache file changes
+inline constexpr uint32_t glyph_cache_version = 1;
+
 class font_manager;
 
 class font {
@@ -43,16 +64,25 @@ public:
 	glyph_sub_offset glyph_positions[256] = {};
 
 	std::unique_ptr<FT_Byte[]> file_data;
+	uint64_t file_hash = 0; // identifies the glyph cache file for this font
+
+	// keyed by a hash of the size and the text; ui thread only
+	mutable ankerl::unordered_dense::map<uint64_t, cached_layout> layout_cache;
 
 	~font();
 
 	void make_glyph(char ch_in);
+	// builds all 256 distance fields (in parallel) into pages, which must hold glyph_page_count * glyph_page_bytes
+	void make_all_glyphs(uint8_t* pages);
+	void upload_glyph_pages(uint8_t const* pages);
 	float line_height(int32_t size) const;
 	float ascender(int32_t size) const;
 	float descender(int32_t size) const;
 	float top_adjustment(int32_t size) const;
 	float kerning(char codepoint_first, char codepoint_second) const;
 	float text_extent(const char* codepoints, uint32_t count, int32_t size) const;
+	// as text_extent, but remembered across calls. The reference is only valid until the next call to get_layout
+	text_layout const& get_layout(const char* codepoints, uint32_t count, int32_t size) const;
 
 	friend class font_manager;
 };
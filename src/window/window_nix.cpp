@@ -3,6 +3,8 @@
 
 #include <GLFW/glfw3.h>
 #include <unordered_map>
+#include <chrono>
+#include <thread>
 
 namespace window {
 class window_data_impl {
@@ -16,8 +18,43 @@ public:
 
 	bool in_fullscreen = false;
 	bool left_mouse_down = false;
+
+	// set by every input / window event; cleared once a frame has been drawn
+	bool redraw_requested = true;
+	std::chrono::time_point<std::chrono::steady_clock> last_frame_time{};
 };
 
+// how long to block waiting for input while idle; also bounds how late a game state update or music change is noticed
+constexpr inline double idle_wait_seconds = 0.1;
+// sleep_for routinely overshoots by up to a scheduler tick, so the last stretch before a frame deadline is spun instead
+constexpr inline auto sleep_margin = std::chrono::microseconds(2000);
+
+static void request_redraw(GLFWwindow* window) {
+	sys::state* state = (sys::state*)glfwGetWindowUserPointer(window);
+	state->win_ptr->redraw_requested = true;
+}
+
+static bool frame_is_needed(sys::state& game_state) {
+	if(!game_state.user_settings.render_on_demand)
+		return true;
+	return game_state.win_ptr->redraw_requested
+		|| game_state.has_finished_day()
+		|| game_state.map_display.is_animating();
+}
+
+static void wait_for_frame_deadline(sys::state& game_state) {
+	if(game_state.user_settings.frame_rate_cap <= 0)
+		return;
+	auto frame_duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration<double>(1.0 / double(game_state.user_settings.frame_rate_cap)));
+	auto deadline = game_state.win_ptr->last_frame_time + frame_duration;
+	auto now = std::chrono::steady_clock::now();
+	if(deadline - now > sleep_margin)
+		std::this_thread::sleep_for(deadline - now - sleep_margin);
+	while(std::chrono::steady_clock::now() < deadline)
+		std::this_thread::yield();
+}
+
 static const std::unordered_map<int, sys::virtual_key> glfw_key_to_virtual_key = {
 { GLFW_KEY_UNKNOWN, sys::virtual_key::NONE },
 { GLFW_KEY_SPACE, sys::virtual_key::SPACE },
@@ -196,6 +233,7 @@ static void glfw_error_callback(int error, const char* description) {
 }
 
 static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+	request_redraw(window);
 	sys::state* state = (sys::state*)glfwGetWindowUserPointer(window);
 
 	sys::virtual_key virtual_key = glfw_key_to_virtual_key.at(key);
@@ -210,6 +248,7 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
 }
 
 static void cursor_position_callback(GLFWwindow* window, double xpos, double ypos) {
+	request_redraw(window);
 	sys::state* state = (sys::state*)glfwGetWindowUserPointer(window);
 
 	int32_t x = (xpos > 0? (int32_t)std::round(xpos) : 0);
@@ -224,6 +263,7 @@ static void cursor_position_callback(GLFWwindow* window, double xpos, double ypo
 }
 
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
+	request_redraw(window);
 	sys::state* state = (sys::state*)glfwGetWindowUserPointer(window);
 
 	double xpos, ypos;
@@ -260,6 +300,7 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
 }
 
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
+	request_redraw(window);
 	sys::state* state = (sys::state*)glfwGetWindowUserPointer(window);
 
 	double xpos, ypos;
@@ -273,6 +314,7 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
 }
 
 void character_callback(GLFWwindow* window, unsigned int codepoint) {
+	request_redraw(window);
 	sys::state* state = (sys::state*)glfwGetWindowUserPointer(window);
 	if(state->in_edit_control) {
 		// TODO change UTF32 to (win1250??)
@@ -281,6 +323,7 @@ void character_callback(GLFWwindow* window, unsigned int codepoint) {
 }
 
 void on_window_change(GLFWwindow* window) {
+	request_redraw(window);
 	sys::state* state = (sys::state*)glfwGetWindowUserPointer(window);
 
 	sys::window_state t = sys::window_state::normal;
@@ -361,13 +404,24 @@ void create_window(sys::state& game_state, creation_parameters const& params) {
 	game_state.on_create();
 
 	while(!glfwWindowShouldClose(window)) {
-		glfwPollEvents();
-		// Run game code
+		bool minimized = glfwGetWindowAttrib(window, GLFW_ICONIFIED) != 0;
+		if(!minimized && frame_is_needed(game_state))
+			glfwPollEvents();
+		else
+			glfwWaitEventsTimeout(idle_wait_seconds);
+
+		sound::update_music_track(game_state);
+
+		if(glfwGetWindowAttrib(window, GLFW_ICONIFIED) != 0 || !frame_is_needed(game_state))
+			continue;
 
+		wait_for_frame_deadline(game_state);
+		game_state.win_ptr->last_frame_time = std::chrono::steady_clock::now();
+		game_state.win_ptr->redraw_requested = false;
+
+		// Run game code
 		game_state.render();
 		glfwSwapBuffers(window);
-
-		sound::update_music_track(game_state);
 	}
 
 	glfwDestroyWindow(window);
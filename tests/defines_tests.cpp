@@ -36,3 +36,15 @@ TEST_CASE("defines tests", "[defines_tests]") {
 	}
 #endif
 }
+
+TEST_CASE("defines lookup", "[defines_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+	parsers::error_handler err("");
+	parsing::defines d{};
+
+	d.parse_file(*state, "\tGREATNESS_DAYS = 12, -- comment\n\tBadboy_Limit = 40\n\tnot_a_define = 7\n", err);
+	REQUIRE(d.greatness_days == 12.0f);
+	REQUIRE(d.badboy_limit == 40.0f);
+	REQUIRE(d.great_nations_count == 8.0f);
+	REQUIRE(err.accumulated_errors.length() == size_t(0));
+}
@@ -0,0 +1,133 @@
+#include "catch.hpp"
+#include "parsers_declarations.hpp"
+#include "effects.hpp"
+
+TEST_CASE("batched effect execution", "[effect_tests]") {
+	const char effect_text[] = "prestige = 5 set_country_flag = flag_a set_global_flag = flag_b";
+
+	parsers::error_handler err("no file");
+	parsers::token_generator gen(effect_text, effect_text + strlen(effect_text));
+
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+	parsers::scenario_building_context context(*state);
+	parsers::effect_building_context tc(context, trigger::slot_contents::nation, trigger::slot_contents::nation, trigger::slot_contents::empty);
+
+	auto key = parsers::make_effect(gen, err, tc);
+	REQUIRE(err.accumulated_errors.length() == size_t(0));
+
+	state->world.nation_resize_flag_variables(uint32_t(state->national_definitions.num_allocated_national_flags));
+	state->national_definitions.global_flag_variables.resize((state->national_definitions.num_allocated_global_flags + 7) / 8, dcon::bitfield_type{ 0 });
+
+	auto a = state->world.create_nation();
+	auto b = state->world.create_nation();
+
+	std::vector<effect::effect_invocation> batch;
+	for(int32_t i = 0; i < 200; ++i) {
+		batch.push_back(effect::effect_invocation{ key, trigger::to_generic(i % 2 == 0 ? a : b), trigger::to_generic(a), -1 });
+	}
+	effect::execute_effects(*state, batch);
+
+	REQUIRE(state->world.nation_get_prestige(a) == 500.0f);
+	REQUIRE(state->world.nation_get_prestige(b) == 500.0f);
+	REQUIRE(state->world.nation_get_flag_variables(a, context.get_national_flag("flag_a")));
+	REQUIRE(state->world.nation_get_flag_variables(b, context.get_national_flag("flag_a")));
+	REQUIRE(state->national_definitions.is_global_flag_variable_set(context.get_global_flag("flag_b")));
+}
+
+TEST_CASE("batched effect write order", "[effect_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+	parsers::scenario_building_context context(*state);
+	parsers::error_handler err("no file");
+
+	auto make = [&](char const* text) {
+		parsers::token_generator gen(text, text + strlen(text));
+		parsers::effect_building_context tc(context, trigger::slot_contents::nation, trigger::slot_contents::nation, trigger::slot_contents::empty);
+		return parsers::make_effect(gen, err, tc);
+	};
+	auto set_then_clear = make("set_country_flag = flag_a clr_country_flag = flag_a");
+	auto clear_then_set = make("clr_country_flag = flag_a set_country_flag = flag_a");
+	auto unsupported = make("plurality = 5 prestige = 1");
+	REQUIRE(err.accumulated_errors.length() == size_t(0));
+
+	state->world.nation_resize_flag_variables(uint32_t(state->national_definitions.num_allocated_national_flags));
+	auto n = state->world.create_nation();
+	auto flag = context.get_national_flag("flag_a");
+
+	// within an invocation the writes keep the order of the effect, and across invocations the order of the batch,
+	// however the chunks happened to be scheduled
+	for(int32_t repeat = 0; repeat < 4; ++repeat) {
+		std::vector<effect::effect_invocation> batch;
+		for(int32_t i = 0; i < 300; ++i)
+			batch.push_back(effect::effect_invocation{ i % 2 == 0 ? set_then_clear : clear_then_set, trigger::to_generic(n), trigger::to_generic(n), -1 });
+		REQUIRE(effect::execute_effects(*state, batch) == 0);
+		REQUIRE(state->world.nation_get_flag_variables(n, flag) == true);
+
+		batch.push_back(effect::effect_invocation{ set_then_clear, trigger::to_generic(n), trigger::to_generic(n), -1 });
+		REQUIRE(effect::execute_effects(*state, batch) == 0);
+		REQUIRE(state->world.nation_get_flag_variables(n, flag) == false);
+	}
+
+	// an effect the executor cannot run is reported, and the rest of the invocation still runs
+	REQUIRE(effect::execute_effect(*state, unsupported, trigger::to_generic(n), trigger::to_generic(n), -1) == 1);
+	REQUIRE(state->world.nation_get_prestige(n) == 1.0f);
+}
+
+TEST_CASE("batched core creation", "[effect_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+	parsers::scenario_building_context context(*state);
+	parsers::error_handler err("no file");
+
+	const char effect_text[] = "add_core = THIS";
+	parsers::token_generator gen(effect_text, effect_text + strlen(effect_text));
+	parsers::effect_building_context tc(context, trigger::slot_contents::province, trigger::slot_contents::nation, trigger::slot_contents::empty);
+	auto key = parsers::make_effect(gen, err, tc);
+	REQUIRE(err.accumulated_errors.length() == size_t(0));
+
+	state->world.province_resize(2);
+	auto p = dcon::province_id(dcon::province_id::value_base_t(1));
+	auto ident = state->world.create_national_identity();
+	auto n = nations::create_nation_for_identity(*state, ident);
+	REQUIRE(!state->world.get_core_by_prov_tag_key(p, ident));
+
+	// several invocations create the same core, which is created once
+	std::vector<effect::effect_invocation> batch(3, effect::effect_invocation{ key, trigger::to_generic(p), trigger::to_generic(n), -1 });
+	REQUIRE(effect::execute_effects(*state, batch) == 0);
+	auto core = state->world.get_core_by_prov_tag_key(p, ident);
+	REQUIRE(bool(core));
+	REQUIRE(state->world.core_get_province(core) == p);
+	int32_t core_count = 0;
+	for(auto c : state->world.province_get_core(p)) {
+		(void)c;
+		++core_count;
+	}
+	REQUIRE(core_count == 1);
+}
+
+TEST_CASE("chained events are committed", "[effect_tests]") {
+	// 1 fires on its own and gives 2 a scope; 2 gives 3 a scope, whose text comes first; 4 is never fired
+	const char event_text[] =
+		"country_event = { id = 3 is_triggered_only = yes title = c desc = c option = { name = c prestige = 1 } } "
+		"country_event = { id = 1 title = a desc = a option = { name = a country_event = 2 } } "
+		"country_event = { id = 2 is_triggered_only = yes title = b desc = b option = { name = b country_event = { id = 3 days = 1 } } } "
+		"country_event = { id = 4 is_triggered_only = yes title = d desc = d option = { name = d prestige = 1 } }";
+
+	parsers::error_handler err("no file");
+	parsers::token_generator gen(event_text, event_text + strlen(event_text));
+
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+	parsers::scenario_building_context context(*state);
+	parsers::parse_event_file(gen, err, context);
+	parsers::commit_pending_events(err, context);
+	REQUIRE(err.accumulated_errors.length() == size_t(0));
+
+	for(int32_t id : { 2, 3 }) {
+		auto& pending = context.map_of_national_events[id];
+		REQUIRE(pending.processed);
+		REQUIRE(bool(pending.id));
+		REQUIRE(pending.main_slot == trigger::slot_contents::nation);
+		REQUIRE(bool(state->world.national_event_get_options(pending.id)[0].effect));
+	}
+	REQUIRE(context.map_of_national_events[4].processed == false);
+	REQUIRE(err.accumulated_warnings.find("Event id: 4 defined but never triggered") != std::string::npos);
+	REQUIRE(err.accumulated_warnings.find("Event id: 3 ") == std::string::npos);
+}
@@ -1,6 +1,7 @@
 #include "catch2/catch.hpp"
 #include "simple_fs.hpp"
 #include <algorithm>
+#include <filesystem>
 
 
 
@@ -47,6 +48,25 @@ TEST_CASE("File system reading", "[file_system]") {
 		REQUIRE(content.data[4] == '2');
 		REQUIRE(content.data[5] == '3');
 	}
+	SECTION("roots added after a lookup") {
+		simple_fs::file_system fs;
+		add_root(fs, NATIVE_M(PROJECT_ROOT));
+
+		auto root_dir = get_root(fs);
+
+		REQUIRE(bool(peek_file(root_dir, NATIVE("test_main.cpp"))) == false);
+		REQUIRE(bool(peek_file(root_dir, NATIVE("tests" NATIVE_SEP "test_main.cpp"))) == true);
+
+		add_root(fs, NATIVE_M(PROJECT_ROOT) NATIVE_SEP NATIVE("tests"));
+
+		auto uo_file = peek_file(root_dir, NATIVE("test_main.cpp"));
+		REQUIRE(bool(uo_file) == true);
+		REQUIRE(get_full_name(*uo_file).find(NATIVE("tests")) != std::string::npos);
+
+		auto lists = open_file(root_dir, NATIVE("CMakeLists.txt"));
+		REQUIRE(bool(lists) == true);
+		REQUIRE(view_contents(*lists).data[0] == '#');
+	}
 }
 
 template<typename T>
@@ -146,4 +166,30 @@ TEST_CASE("writing special files", "[file_system]") {
 	REQUIRE(content.data[2] == ' ');
 	REQUIRE(content.data[3] == 'n');
 	REQUIRE(content.data[4] == 'o');
-}
\ No newline at end of file
+}
+TEST_CASE("scenario manifest directory listings", "[file_system]") {
+	auto base = std::filesystem::temp_directory_path() / "alice_manifest_test";
+	std::filesystem::remove_all(base);
+	std::filesystem::create_directories(base / "history" / "provinces" / "europe");
+
+	simple_fs::file_system fs;
+	add_root(fs, base.native());
+
+	simple_fs::start_recording_accesses(fs);
+	auto provinces_dir = open_directory(open_directory(get_root(fs), NATIVE("history")), NATIVE("provinces"));
+	auto regions = list_subdirectories(provinces_dir);
+	REQUIRE(regions.size() == size_t(1));
+	auto accesses = simple_fs::stop_recording_accesses(fs);
+	REQUIRE(std::any_of(accesses.begin(), accesses.end(), [](simple_fs::recorded_access const& a) { return a.type == simple_fs::access_type::subdirectory_listing; }));
+
+	auto manifest = sys::make_scenario_manifest(fs, std::move(accesses));
+	REQUIRE(sys::scenario_manifest_is_current(fs, manifest) == true);
+
+	// a new region directory is picked up by a fresh file system, as it would be on the next start
+	std::filesystem::create_directories(base / "history" / "provinces" / "asia");
+	simple_fs::file_system changed_fs;
+	add_root(changed_fs, base.native());
+	REQUIRE(sys::scenario_manifest_is_current(changed_fs, manifest) == false);
+
+	std::filesystem::remove_all(base);
+}
@@ -35,6 +35,25 @@ TEST_CASE("string pool tests", "[misc_tests]") {
 	REQUIRE(state->to_string_view(lb) == "latex");
 }
 
+TEST_CASE("string arena", "[misc_tests]") {
+	parsers::string_arena arena;
+
+	std::string source = "first";
+	auto a = arena.store(source);
+	source = "overwritten";
+	auto b = arena.store(std::string_view("second"));
+	auto c = arena.store(std::string_view());
+	auto big = arena.store(std::string(100000, 'x'));
+	auto d = arena.store(std::string_view("after"));
+
+	REQUIRE(a == "first");
+	REQUIRE(b == "second");
+	REQUIRE(c.length() == size_t(0));
+	REQUIRE(big.length() == size_t(100000));
+	REQUIRE(d == "after");
+	REQUIRE(d.data() == b.data() + b.length() + c.length()); // a large string does not use up the current block
+}
+
 TEST_CASE("date tests", "[misc_tests]") {
 	sys::absolute_time_point base_time{ sys::year_month_day{ 2020, 1, 2 } };
 	sys::date first{ 0 };
@@ -58,3 +77,460 @@ TEST_CASE("date tests", "[misc_tests]") {
 	REQUIRE(ymdc.month == 8);
 	REQUIRE(ymdc.day == 16);
 }
+
+TEST_CASE("pop demographics quantization", "[misc_tests]") {
+	REQUIRE(pop_demographics::pack_share(0.0f) == uint16_t(0));
+	REQUIRE(pop_demographics::pack_share(1.0f) == uint16_t(65535));
+	REQUIRE(pop_demographics::pack_share(-0.5f) == uint16_t(0));
+	REQUIRE(pop_demographics::pack_share(2.0f) == uint16_t(65535));
+
+	for(float share : { 0.001f, 0.25f, 0.333f, 0.5f, 0.9999f }) {
+		auto round_trip = pop_demographics::unpack_share(pop_demographics::pack_share(share));
+		REQUIRE(std::abs(round_trip - share) <= 0.5f / pop_demographics::quantization_max);
+	}
+}
+
+TEST_CASE("province paths", "[misc_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+
+	// four land provinces in a row, with a sea lane of two provinces running alongside
+	state->world.province_resize(6);
+	state->province_definitions.first_sea_province = dcon::province_id(4);
+	state->map_display.size_x = 0;
+	glm::vec2 positions[] = { glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(2, 0), glm::vec2(3, 0), glm::vec2(0, 1), glm::vec2(3, 1) };
+	for(uint32_t i = 0; i < 6; ++i)
+		state->world.province_set_mid_point(dcon::province_id(dcon::province_id::value_base_t(i)), positions[i]);
+
+	auto p = [](int32_t i) { return dcon::province_id(dcon::province_id::value_base_t(i)); };
+	state->world.force_create_province_adjacency(p(0), p(1));
+	auto middle = state->world.force_create_province_adjacency(p(1), p(2));
+	state->world.force_create_province_adjacency(p(2), p(3));
+	auto shortcut = state->world.force_create_province_adjacency(p(0), p(3));
+	state->world.province_adjacency_set_type(shortcut, province::border::impassible_bit);
+	auto coast_a = state->world.force_create_province_adjacency(p(0), p(4));
+	state->world.province_adjacency_set_type(coast_a, province::border::coastal_bit);
+	state->world.force_create_province_adjacency(p(4), p(5));
+	auto coast_b = state->world.force_create_province_adjacency(p(5), p(3));
+	state->world.province_adjacency_set_type(coast_b, province::border::coastal_bit);
+
+	auto land = province::make_path(*state, p(0), p(3), province::path_type::land);
+	REQUIRE(land == std::vector<dcon::province_id>{ p(1), p(2), p(3) });
+	REQUIRE(province::make_path(*state, p(0), p(4), province::path_type::land).empty());
+	REQUIRE(province::make_path(*state, p(4), p(3), province::path_type::sea) == std::vector<dcon::province_id>{ p(5), p(3) });
+
+	// repeated queries are answered from the cache until it is cleared
+	state->world.province_adjacency_set_type(middle, province::border::impassible_bit);
+	REQUIRE(province::make_path(*state, p(0), p(3), province::path_type::land) == land);
+	state->province_paths.clear();
+	REQUIRE(province::make_path(*state, p(0), p(3), province::path_type::land).empty());
+
+	std::vector<province::path_request> requests{
+		province::path_request{ p(4), p(3), province::path_type::sea },
+		province::path_request{ p(0), p(1), province::path_type::land } };
+	std::vector<std::vector<dcon::province_id>> results;
+	province::make_paths(*state, requests, results);
+	REQUIRE(results.size() == size_t(2));
+	REQUIRE(results[0] == std::vector<dcon::province_id>{ p(5), p(3) });
+	REQUIRE(results[1] == std::vector<dcon::province_id>{ p(1) });
+}
+
+namespace {
+float distance_to_polyline(glm::vec2 p, std::vector<glm::vec2> const& line) {
+	float best = glm::length(p - line.front());
+	for(size_t i = 1; i < line.size(); ++i) {
+		auto ab = line[i] - line[i - 1];
+		auto t = glm::dot(ab, ab) > 0.f ? std::clamp(glm::dot(p - line[i - 1], ab) / glm::dot(ab, ab), 0.f, 1.f) : 0.f;
+		best = std::min(best, glm::length(p - (line[i - 1] + t * ab)));
+	}
+	return best;
+}
+}
+
+TEST_CASE("border outline simplification", "[misc_tests]") {
+	// a staircase lies within 0.75 px of its diagonal, so only the ends are kept
+	std::vector<glm::vec2> stairs;
+	for(int32_t i = 0; i < 8; ++i) {
+		stairs.push_back(glm::vec2(float(i), float(i)));
+		stairs.push_back(glm::vec2(float(i + 1), float(i)));
+	}
+	std::vector<glm::vec2> out;
+	map::simplify_polyline(stairs, out, 0.75f);
+	REQUIRE(out == std::vector<glm::vec2>{ stairs.front(), stairs.back() });
+
+	// a line with a bump keeps the bump, and every point dropped stays within the tolerance of what is kept
+	std::vector<glm::vec2> bumpy;
+	for(int32_t i = 0; i <= 20; ++i)
+		bumpy.push_back(glm::vec2(float(i), (i == 10 ? 3.0f : 0.0f) + ((i % 2) != 0 ? 0.5f : 0.0f)));
+	map::simplify_polyline(bumpy, out, 0.75f);
+	REQUIRE(out.front() == bumpy.front());
+	REQUIRE(out.back() == bumpy.back());
+	REQUIRE(std::find(out.begin(), out.end(), bumpy[10]) != out.end());
+	REQUIRE(out.size() < bumpy.size());
+	for(auto pt : bumpy)
+		REQUIRE(distance_to_polyline(pt, out) <= 0.75f);
+}
+
+TEST_CASE("border tracing", "[misc_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+
+	// a 2 by 2 province (map id 2) in the middle of a 6 by 6 map that otherwise belongs to map id 1
+	state->world.province_resize(2);
+	state->province_definitions.first_sea_province = dcon::province_id(2);
+	auto& map = state->map_display;
+	map.size_x = 6;
+	map.size_y = 6;
+	map.province_id_map.assign(36, uint16_t(1));
+	for(uint32_t y = 2; y < 4; ++y)
+		for(uint32_t x = 2; x < 4; ++x)
+			map.province_id_map[x + y * 6] = 2;
+
+	parsers::scenario_building_context context(*state);
+	map.create_border_data(context);
+
+	// the outline is one closed strip, a pair of vertices per point, running only along the edge of the inner province
+	REQUIRE(map.border_tiles.size() == size_t(1));
+	REQUIRE(map.border_tiles[0].first == 0);
+	REQUIRE(map.border_tiles[0].count == map.border_vertices.size());
+	REQUIRE(map.border_vertices.size() % 2 == 0);
+	std::vector<glm::vec2> outline;
+	for(size_t i = 0; i < map.border_vertices.size(); i += 2) {
+		auto const& v = map.border_vertices[i];
+		REQUIRE(v.position == map.border_vertices[i + 1].position);
+		REQUIRE(v.province_a == 1);
+		REQUIRE(v.province_b == 2);
+		REQUIRE(v.type == map::border_type::province);
+		outline.push_back(v.position * 6.0f);
+	}
+	REQUIRE(outline.size() >= size_t(5));
+	REQUIRE(outline.front() == outline.back());
+	for(auto pt : outline) {
+		bool on_edge = ((pt.x == 2.0f || pt.x == 4.0f) && pt.y >= 2.0f && pt.y <= 4.0f) || ((pt.y == 2.0f || pt.y == 4.0f) && pt.x >= 2.0f && pt.x <= 4.0f);
+		REQUIRE(on_edge);
+	}
+	// simplification merges each side into one segment but keeps every corner
+	REQUIRE(outline.size() <= size_t(6));
+	for(auto corner : { glm::vec2(2, 2), glm::vec2(4, 2), glm::vec2(4, 4), glm::vec2(2, 4) })
+		REQUIRE(std::find(outline.begin(), outline.end(), corner) != outline.end());
+
+	REQUIRE(bool(state->world.get_province_adjacency_by_province_pair(dcon::province_id(0), dcon::province_id(1))));
+}
+
+TEST_CASE("pop sorting by location", "[misc_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+
+	state->world.province_resize(3);
+	state->world.ideology_resize(2);
+	pop_demographics::resize_storage(*state);
+
+	auto p = [](int32_t i) { return dcon::province_id(dcon::province_id::value_base_t(i)); };
+	int32_t locations[] = { 2, 0, 1, 0, 2, 1 };
+	for(int32_t i = 0; i < 6; ++i) {
+		auto pop = state->world.create_pop();
+		// every column records the pop's original index so that it can be followed through the permutation
+		state->world.pop_set_size(pop, float(i + 1) * 100.0f);
+		state->world.pop_set_militancy(pop, float(i));
+		state->world.pop_set_poptype(pop, dcon::pop_type_id(dcon::pop_type_id::value_base_t(i)));
+		pop_demographics::set_demo(*state, pop, pop_demographics::to_key(*state, dcon::ideology_id(dcon::ideology_id::value_base_t(1))), float(i + 1) * 50.0f);
+		state->world.force_create_pop_location(pop, p(locations[i]));
+	}
+	auto regiment = state->world.create_regiment();
+	state->world.force_create_regiment_source(regiment, dcon::pop_id(dcon::pop_id::value_base_t(4)));
+
+	state->pop_ranges_out_of_date = true;
+	province::sort_pops_by_location(*state);
+	REQUIRE(state->pop_ranges_out_of_date == false);
+
+	// a stable counting sort by province: 1, 3 | 2, 5 | 0, 4
+	int32_t expected_source[] = { 1, 3, 2, 5, 0, 4 };
+	for(int32_t i = 0; i < 6; ++i) {
+		dcon::pop_id pop(dcon::pop_id::value_base_t(i));
+		auto source = expected_source[i];
+		REQUIRE(state->world.pop_get_size(pop) == float(source + 1) * 100.0f);
+		REQUIRE(state->world.pop_get_militancy(pop) == float(source));
+		REQUIRE(state->world.pop_get_poptype(pop) == dcon::pop_type_id(dcon::pop_type_id::value_base_t(source)));
+		REQUIRE(pop_demographics::get_demo(*state, pop, pop_demographics::to_key(*state, dcon::ideology_id(dcon::ideology_id::value_base_t(1)))) == Approx(float(source + 1) * 50.0f).epsilon(0.01));
+		REQUIRE(state->world.pop_get_province_from_pop_location(pop) == p(locations[source]));
+	}
+	REQUIRE(state->world.pop_get_size(state->world.regiment_get_pop_from_regiment_source(regiment)) == 500.0f);
+
+	uint32_t expected_begin[] = { 0, 2, 4 };
+	for(int32_t i = 0; i < 3; ++i) {
+		REQUIRE(state->world.province_get_pop_range_begin(p(i)) == expected_begin[i]);
+		REQUIRE(state->world.province_get_pop_range_end(p(i)) == expected_begin[i] + 2);
+		std::vector<dcon::pop_id> in_range;
+		province::for_each_pop_in_range(*state, p(i), [&](dcon::pop_id pop) { in_range.push_back(pop); });
+		std::vector<dcon::pop_id> in_list;
+		for(auto pl : state->world.province_get_pop_location(p(i)))
+			in_list.push_back(pl.get_pop());
+		REQUIRE(in_range == in_list);
+	}
+
+	// nothing moved, so a second sort leaves everything as it was
+	state->pop_ranges_out_of_date = true;
+	province::sort_pops_by_location(*state);
+	REQUIRE(state->world.pop_get_size(dcon::pop_id(dcon::pop_id::value_base_t(0))) == 200.0f);
+}
+
+TEST_CASE("pop demographics province totals", "[misc_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+
+	state->world.province_resize(3);
+	state->world.ideology_resize(2);
+	state->province_definitions.first_sea_province = dcon::province_id(2);
+	pop_demographics::resize_storage(*state);
+	state->world.province_resize_demographics(demographics::size(*state));
+	state->world.state_instance_resize_demographics(demographics::size(*state));
+	state->world.nation_resize_demographics(demographics::size(*state));
+
+	auto p = [](int32_t i) { return dcon::province_id(dcon::province_id::value_base_t(i)); };
+	auto n = state->world.create_nation();
+	auto si = state->world.create_state_instance();
+	state->world.force_create_state_ownership(si, n);
+	state->world.province_set_state_membership(p(0), si);
+	state->world.province_set_state_membership(p(1), si);
+
+	// enough pops in the first province for several whole vectors and a partial one, and a single pop in the second
+	auto pkey = pop_demographics::to_key(*state, dcon::ideology_id(dcon::ideology_id::value_base_t(1)));
+	auto key = demographics::to_key(*state, dcon::ideology_id(dcon::ideology_id::value_base_t(1)));
+	int32_t pop_count = int32_t(ve::vector_size) * 3 + 3;
+	float expected[2] = { 0.0f, 0.0f };
+	for(int32_t i = 0; i <= pop_count; ++i) {
+		auto pop = state->world.create_pop();
+		auto location = i < pop_count ? 0 : 1;
+		auto amount = float(i % 7 + 1) * 30.0f;
+		state->world.pop_set_size(pop, 1000.0f + float(i) * 10.0f);
+		pop_demographics::set_demo(*state, pop, pkey, amount);
+		state->world.force_create_pop_location(pop, p(location));
+		expected[location] += amount;
+	}
+	state->pop_ranges_out_of_date = true;
+	province::sort_pops_by_location(*state);
+
+	demographics::sum_over_pop_demographics(*state, key, pkey);
+	// each quantized share is off by at most half a step, i.e. by at most half a step of the pop's size
+	float tolerance = pop_demographics::quantized_storage ? float(pop_count + 1) * 0.5f * 2000.0f / pop_demographics::quantization_max : 0.01f;
+	REQUIRE(std::abs(state->world.province_get_demographics(p(0), key) - expected[0]) <= tolerance);
+	REQUIRE(std::abs(state->world.province_get_demographics(p(1), key) - expected[1]) <= tolerance);
+	REQUIRE(state->world.state_instance_get_demographics(si, key) == Approx(state->world.province_get_demographics(p(0), key) + state->world.province_get_demographics(p(1), key)));
+	REQUIRE(state->world.nation_get_demographics(n, key) == Approx(state->world.state_instance_get_demographics(si, key)));
+
+	// the vector kernel reads the same values as the scalar path used while the pop ranges are out of date
+	auto vectorized = state->world.province_get_demographics(p(0), key);
+	state->pop_ranges_out_of_date = true;
+	demographics::sum_over_pop_demographics(*state, key, pkey);
+	REQUIRE(state->world.province_get_demographics(p(0), key) == Approx(vectorized));
+}
+
+TEST_CASE("dominant and second culture", "[misc_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+
+	state->world.province_resize(4);
+	state->world.culture_resize(3);
+	state->world.pop_type_resize(1);
+	state->province_definitions.first_sea_province = dcon::province_id(3);
+	pop_demographics::resize_storage(*state);
+	state->world.province_resize_demographics(demographics::size(*state));
+	state->world.state_instance_resize_demographics(demographics::size(*state));
+	state->world.nation_resize_demographics(demographics::size(*state));
+
+	auto p = [](int32_t i) { return dcon::province_id(dcon::province_id::value_base_t(i)); };
+	auto c = [](int32_t i) { return dcon::culture_id(dcon::culture_id::value_base_t(i)); };
+	auto n = state->world.create_nation();
+	auto si = state->world.create_state_instance();
+	state->world.force_create_state_ownership(si, n);
+	for(int32_t i = 0; i < 3; ++i)
+		state->world.province_set_state_membership(p(i), si);
+
+	// three cultures in the first province, a tie in the second, and a single culture in the third
+	struct pop_def {
+		int32_t province;
+		int32_t culture;
+		float size;
+	};
+	pop_def pops[] = { { 0, 0, 300.0f }, { 0, 1, 500.0f }, { 0, 2, 200.0f }, { 1, 0, 400.0f }, { 1, 2, 400.0f }, { 2, 2, 100.0f } };
+	for(auto& def : pops) {
+		auto pop = state->world.create_pop();
+		state->world.pop_set_size(pop, def.size);
+		state->world.pop_set_culture(pop, c(def.culture));
+		state->world.pop_set_poptype(pop, dcon::pop_type_id(0));
+		state->world.force_create_pop_location(pop, p(def.province));
+	}
+	province::sort_pops_by_location(*state);
+
+	demographics::regenerate_from_pop_data(*state);
+
+	REQUIRE(state->world.province_get_dominant_culture(p(0)) == c(1));
+	REQUIRE(state->world.province_get_dominant_culture_share(p(0)) == Approx(0.5f));
+	REQUIRE(state->world.province_get_second_culture(p(0)) == c(0));
+	REQUIRE(state->world.province_get_second_culture_share(p(0)) == Approx(0.3f));
+
+	// a tie goes to the culture seen first, the other one is second with the same share
+	REQUIRE(state->world.province_get_dominant_culture(p(1)) == c(0));
+	REQUIRE(state->world.province_get_second_culture(p(1)) == c(2));
+	REQUIRE(state->world.province_get_dominant_culture_share(p(1)) == Approx(0.5f));
+	REQUIRE(state->world.province_get_second_culture_share(p(1)) == Approx(0.5f));
+
+	REQUIRE(state->world.province_get_dominant_culture(p(2)) == c(2));
+	REQUIRE(state->world.province_get_dominant_culture_share(p(2)) == Approx(1.0f));
+	REQUIRE(!state->world.province_get_second_culture(p(2)));
+	REQUIRE(state->world.province_get_second_culture_share(p(2)) == 0.0f);
+
+	// the state adds up to 700 / 500 / 700, which is a tie again
+	REQUIRE(state->world.state_instance_get_dominant_culture(si) == c(0));
+	REQUIRE(state->world.state_instance_get_second_culture(si) == c(2));
+	REQUIRE(state->world.state_instance_get_dominant_culture_share(si) == Approx(700.0f / 1900.0f));
+	REQUIRE(state->world.nation_get_dominant_culture(n) == c(0));
+	REQUIRE(state->world.nation_get_second_culture_share(n) == Approx(700.0f / 1900.0f));
+}
+
+TEST_CASE("political map recoloring", "[misc_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+
+	state->world.province_resize(3);
+	auto p = [](int32_t i) { return dcon::province_id(dcon::province_id::value_base_t(i)); };
+	auto a = state->world.create_nation();
+	auto b = state->world.create_nation();
+	state->world.nation_set_color(a, 0x0000FFu);
+	state->world.nation_set_color(b, 0x00FF00u);
+	state->map_display.reset_dirty_provinces(256);
+
+	province::set_province_owner(*state, p(0), a);
+	province::set_province_owner(*state, p(1), a);
+	std::vector<uint32_t> previous;
+	map_mode::political_colors(*state, nullptr, previous);
+	uint32_t texture_size = 256;
+	REQUIRE(previous.size() == texture_size * 2);
+	REQUIRE(previous[province::to_map_id(p(1))] == 0x0000FFu);
+	REQUIRE(previous[province::to_map_id(p(2))] == 0xFFFFFFu);
+
+	// the full pass consumed the marks, so without a change nothing is recolored
+	std::vector<uint32_t> unchanged;
+	map_mode::political_colors(*state, &previous, unchanged);
+	REQUIRE(unchanged.empty());
+
+	// a change of owner recolors that province, in both layers, and leaves the others as they were
+	province::set_province_owner(*state, p(1), b);
+	std::vector<uint32_t> recolored;
+	map_mode::political_colors(*state, &previous, recolored);
+	REQUIRE(recolored.size() == previous.size());
+	REQUIRE(recolored[province::to_map_id(p(1))] == 0x00FF00u);
+	REQUIRE(recolored[province::to_map_id(p(1)) + texture_size] == 0x00FF00u);
+	REQUIRE(recolored[province::to_map_id(p(0))] == 0x0000FFu);
+
+	// as does losing the owner
+	province::set_province_owner(*state, p(0), dcon::nation_id{});
+	REQUIRE(!state->world.province_get_nation_from_province_ownership(p(0)));
+	std::vector<uint32_t> released;
+	map_mode::political_colors(*state, &recolored, released);
+	REQUIRE(released[province::to_map_id(p(0))] == 0xFFFFFFu);
+	REQUIRE(released[province::to_map_id(p(1))] == 0x00FF00u);
+}
+
+TEST_CASE("rankings follow created and destroyed nations", "[misc_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+
+	state->world.province_resize(2);
+	auto p = [](int32_t i) { return dcon::province_id(dcon::province_id::value_base_t(i)); };
+	auto first = nations::create_nation_for_identity(*state, state->world.create_national_identity());
+	auto second_ident = state->world.create_national_identity();
+	auto second = nations::create_nation_for_identity(*state, second_ident);
+	REQUIRE(nations::create_nation_for_identity(*state, second_ident) == second);
+	province::set_province_owner(*state, p(0), first);
+	province::set_province_owner(*state, p(1), second);
+	state->world.nation_set_prestige(second, 10.0f);
+
+	nations::update_national_rankings(*state);
+	REQUIRE(state->national_rankings_out_of_date == false);
+	REQUIRE(state->nations_by_rank == std::vector<dcon::nation_id>{ second, first });
+
+	// a nation released after the last update has to be ranked as well
+	auto third = nations::create_nation_for_identity(*state, state->world.create_national_identity());
+	REQUIRE(state->national_rankings_out_of_date == true);
+	nations::update_national_rankings(*state);
+	REQUIRE(state->nations_by_rank.size() == 3);
+	REQUIRE(state->world.nation_get_rank(third) == 3);
+
+	// and an annexed one must not linger in the ranking
+	nations::destroy_nation(*state, second);
+	REQUIRE(!state->world.province_get_nation_from_province_ownership(p(1)));
+	nations::update_national_rankings(*state);
+	REQUIRE(state->nations_by_rank == std::vector<dcon::nation_id>{ first, third });
+}
+
+TEST_CASE("ui dirty tracking", "[misc_tests]") {
+	auto p = [](int32_t i) { return dcon::province_id(dcon::province_id::value_base_t(i)); };
+	auto n = [](int32_t i) { return dcon::nation_id(dcon::nation_id::value_base_t(i)); };
+
+	ui::element_base e;
+	ui::dirty_state dirty;
+	REQUIRE(e.depends_on(dirty) == false);
+
+	// until it says otherwise, an element is assumed to read everything
+	dirty.mark(ui::update_domain::date);
+	REQUIRE(e.depends_on(dirty) == true);
+	dirty.clear();
+
+	// an element that reads one province only hears about that province
+	e.set_update_domains(ui::update_domain::province);
+	e.set_update_target(p(3));
+	dirty.mark(p(2));
+	dirty.mark(n(3));
+	REQUIRE(dirty.domains() == (ui::update_domain::nation | ui::update_domain::province));
+	REQUIRE(e.depends_on(dirty) == false);
+	dirty.mark(p(3));
+	REQUIRE(e.depends_on(dirty) == true);
+
+	// changes made to every province reach it too, as do changes handed over from another dirty state
+	ui::dirty_state other;
+	dirty.clear();
+	REQUIRE(dirty.domains() == ui::update_domain::none);
+	other.mark(ui::update_domain::province);
+	dirty.merge(other);
+	REQUIRE(e.depends_on(dirty) == true);
+
+	// without a target, a change to any nation counts
+	ui::element_base any_nation;
+	any_nation.set_update_domains(ui::update_domain::nation);
+	dirty.clear();
+	REQUIRE(any_nation.depends_on(dirty) == false);
+	dirty.mark(n(7));
+	REQUIRE(any_nation.depends_on(dirty) == true);
+}
+
+namespace {
+class context_listener : public ui::element_base {
+public:
+	ui::context_ref<dcon::province_id> province{this};
+	int32_t changes = 0;
+	void on_context_change(sys::state& state) noexcept override {
+		++changes;
+	}
+};
+}
+
+TEST_CASE("context subscription on attach", "[misc_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+
+	ui::container_base window;
+	ui::context_slot<dcon::province_id> slot;
+	window.publish_context(slot);
+
+	// the listener is attached inside an intermediate container that is itself attached last, as make_child does
+	auto inner = std::make_unique<ui::container_base>();
+	auto listener = std::make_unique<context_listener>();
+	auto listener_ptr = listener.get();
+	inner->add_child_to_back(std::move(listener));
+	window.add_child_to_back(std::move(inner));
+
+	// the listener never read the slot, but hears about the change anyway
+	slot.set(*state, dcon::province_id(dcon::province_id::value_base_t(2)));
+	REQUIRE(listener_ptr->changes == 1);
+	REQUIRE(listener_ptr->province.get() == dcon::province_id(dcon::province_id::value_base_t(2)));
+	// and the province it now shows is the only one whose changes concern it
+	REQUIRE(listener_ptr->update_province == dcon::province_id(dcon::province_id::value_base_t(2)));
+
+	// reading the value does not reroute the updates
+	listener_ptr->set_update_target(dcon::province_id(dcon::province_id::value_base_t(5)));
+	REQUIRE(listener_ptr->province.get() == dcon::province_id(dcon::province_id::value_base_t(2)));
+	REQUIRE(listener_ptr->update_province == dcon::province_id(dcon::province_id::value_base_t(5)));
+}
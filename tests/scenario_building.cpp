@@ -5,6 +5,7 @@
 #include "container_types.hpp"
 #include "system_state.hpp"
 #include "serialization.hpp"
+#include <chrono>
 
 /*
 * parsers::scenario_building_context context(*this);
@@ -809,9 +810,9 @@ TEST_CASE("Scenario building", "[req-game-files]") {
 	{
 		auto poptypes = open_directory(root, NATIVE("poptypes"));
 		for(auto pr : context.map_of_poptypes) {
-			auto opened_file = open_file(poptypes, simple_fs::utf8_to_native(pr.first + ".txt"));
+			auto opened_file = open_file(poptypes, simple_fs::utf8_to_native(std::string(pr.first) + ".txt"));
 			if(opened_file) {
-				err.file_name = pr.first + ".txt";
+				err.file_name = std::string(pr.first) + ".txt";
 				auto content = view_contents(*opened_file);
 				parsers::poptype_context inner_context{ context, pr.second };
 				parsers::token_generator gen(content.data, content.data + content.file_size);
@@ -1287,7 +1288,7 @@ TEST_CASE("Scenario building", "[req-game-files]") {
 	}
 
 	state->world.nation_resize_variables(uint32_t(state->national_definitions.num_allocated_national_variables));
-	state->world.pop_resize_demographics(pop_demographics::size(*state));
+	pop_demographics::resize_storage(*state);
 
 	nations::generate_initial_state_instances(*state);
 	state->world.nation_resize_stockpiles(state->world.commodity_size());
@@ -1882,6 +1883,26 @@ TEST_CASE("Scenario building", "[req-game-files]") {
 		REQUIRE(nation.get_max_fort_level() == 1);
 	}
 
+	// the daily economy update should fit in a fixed slice of a game tick at full-map pop counts; the time depends on the
+	// machine running the tests, so it is only reported (see the "daily economy update" benchmark below for a measurement)
+	{
+		state->world.nation_resize_last_production(state->world.commodity_size());
+		state->world.state_instance_resize_last_production(state->world.commodity_size());
+		state->world.state_instance_resize_last_demand(state->world.commodity_size());
+		economy::initialize(*state);
+		demographics::regenerate_from_pop_data(*state);
+
+		constexpr int32_t days = 10;
+		constexpr auto budget_per_day = std::chrono::milliseconds(50);
+		auto start = std::chrono::steady_clock::now();
+		for(int32_t i = 0; i < days; ++i)
+			economy::daily_update(*state);
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		auto per_day = std::chrono::duration_cast<std::chrono::microseconds>(elapsed / days);
+		CHECK_NOFAIL(per_day < budget_per_day);
+		WARN("daily economy update: " << per_day.count() << " us per day (budget " << budget_per_day.count() << " ms)");
+	}
+
 	/*************************************************
 	// where some benchmarks live
 
@@ -1961,6 +1982,13 @@ TEST_CASE("Scenario building", "[req-game-files]") {
 			});
 		});
 	};
+
+	BENCHMARK_ADVANCED("daily economy update")(Catch::Benchmark::Chronometer meter) {
+		trash_cache();
+		meter.measure([&]() {
+			economy::daily_update(*state);
+		});
+	};
 	// ***************************/
 }
 #endif
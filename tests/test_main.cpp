@@ -25,6 +25,7 @@
 #include "scenario_building.cpp"
 #include "defines_tests.cpp"
 #include "triggers_tests.cpp"
+#include "effects_tests.cpp"
 
 TEST_CASE("Dummy test", "[dummy test instance]") {
     REQUIRE(1 + 1 == 2); 
@@ -661,3 +661,59 @@ TEST_CASE("complex full reduction", "[trigger_tests]") {
 	REQUIRE(tc.compiled_trigger[5] == uint16_t(trigger::association_lt | trigger::average_consciousness_province));
 }
 
+
+TEST_CASE("trigger memoization", "[trigger_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
+
+	auto always = state->commit_trigger_data(std::vector<uint16_t>{ uint16_t(trigger::no_payload | trigger::association_eq | trigger::always) });
+
+	std::vector<uint16_t> t;
+	t.push_back(uint16_t(trigger::generic_scope));
+	t.push_back(uint16_t(6));
+	t.push_back(uint16_t(trigger::association_ge | trigger::year));
+	t.push_back(uint16_t(1836));
+	t.push_back(uint16_t(trigger::association_gt | trigger::money));
+	t.push_back(uint16_t(0));
+	t.push_back(uint16_t(0));
+	auto with_money = state->commit_trigger_data(t);
+
+	REQUIRE(trigger::is_memoizable(*state, always));
+	REQUIRE(!trigger::is_memoizable(*state, with_money));
+
+	// outside of a tick nothing is remembered
+	for(int32_t i = 0; i < 2000; ++i) {
+		REQUIRE(trigger::evaluate_trigger_memoized(*state, always, 1, 2, 3));
+	}
+	REQUIRE(state->trigger_memo.misses.load() == 0);
+	REQUIRE(state->trigger_memo.hits.load() == 0);
+
+	state->trigger_memo.begin_tick();
+	for(int32_t i = 0; i < 5000; ++i) {
+		REQUIRE(trigger::evaluate_trigger_memoized(*state, always, 1, 2, 3));
+	}
+	// the counts are only added up at the end of the tick, and then they are exact
+	REQUIRE(state->trigger_memo.misses.load() == 0);
+	state->trigger_memo.end_tick();
+	REQUIRE(state->trigger_memo.misses.load() == 1);
+	REQUIRE(state->trigger_memo.hits.load() == 4999);
+
+	state->trigger_memo.begin_tick();
+	for(int32_t i = 0; i < 5000; ++i) {
+		REQUIRE(trigger::evaluate_trigger_memoized(*state, always, 1, 2, 3));
+	}
+	state->trigger_memo.end_tick();
+	REQUIRE(state->trigger_memo.misses.load() == 2);
+	REQUIRE(state->trigger_memo.hits.load() == 9998);
+
+	// lookups made from many threads are all counted
+	state->trigger_memo.hits.store(0);
+	state->trigger_memo.misses.store(0);
+	state->trigger_memo.begin_tick();
+	concurrency::parallel_for(0, 64, [&](int32_t index) {
+		for(int32_t i = 0; i < 1000; ++i)
+			trigger::evaluate_trigger_memoized(*state, always, index, 2, 3);
+	});
+	state->trigger_memo.end_tick();
+	REQUIRE(state->trigger_memo.hits.load() + state->trigger_memo.misses.load() == 64000);
+	REQUIRE(state->trigger_memo.misses.load() >= 64);
+}